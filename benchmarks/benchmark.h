@@ -0,0 +1,135 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      benchmark.h
+ * @brief     nano-geometry benchmark harness
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include "perf_counters.h"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nano::bench {
+
+/// Measurement of a single benchmark.
+struct result {
+  std::string name;
+  std::size_t items = 0;
+  std::size_t iterations = 0;
+  double seconds = 0;
+
+  /// Hardware counters summed over all iterations, 0 when unavailable.
+  counter_values counters = {};
+};
+
+/// Passed to every benchmark function, collects the measurements.
+class context {
+public:
+  context(double min_time, std::string temp_directory, bool use_counters = true, std::string workload_path = {})
+      : _min_time(min_time),
+        _temp_directory(std::move(temp_directory)),
+        _workload_path(std::move(workload_path)),
+        _use_counters(use_counters && _counters.any()) {}
+
+  /// Calls `fct` repeatedly for at least the minimum time and records the time per call.
+  /// `items` is the number of items processed by a single call. The hardware counters are
+  /// read around the timed calls, not the warm up.
+  template <typename Fct>
+  void measure(std::string name, std::size_t items, Fct&& fct) {
+    using clock = std::chrono::steady_clock;
+
+    // Warm up.
+    fct();
+
+    result res;
+    res.name = std::move(name);
+    res.items = items;
+
+    if (_use_counters) {
+      _counters.start();
+    }
+
+    const clock::time_point start = clock::now();
+    double elapsed = 0;
+
+    while (elapsed < _min_time) {
+      fct();
+      res.iterations++;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+
+    if (_use_counters) {
+      _counters.stop(res.counters);
+    }
+
+    res.seconds = elapsed;
+    _results.push_back(std::move(res));
+  }
+
+  /// Directory where benchmarks can write their files.
+  const std::string& temp_directory() const noexcept { return _temp_directory; }
+
+  /// Recorded workload trace to replay, empty to replay a synthetic one.
+  const std::string& workload_path() const noexcept { return _workload_path; }
+
+  const std::vector<result>& results() const noexcept { return _results; }
+
+  /// Returns true if `c` was recorded in the results.
+  bool has_counter(counter c) const noexcept { return _use_counters && _counters.available(c); }
+
+private:
+  double _min_time;
+  std::string _temp_directory;
+  std::string _workload_path;
+  perf_counters _counters;
+  bool _use_counters;
+  std::vector<result> _results;
+};
+
+using benchmark_function = void (*)(context&);
+
+inline std::vector<std::pair<const char*, benchmark_function>>& registry() {
+  static std::vector<std::pair<const char*, benchmark_function>> benchmarks;
+  return benchmarks;
+}
+
+struct registrar {
+  registrar(const char* name, benchmark_function fct) { registry().emplace_back(name, fct); }
+};
+
+/// Prevents the compiler from optimizing away a computed value.
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+} // namespace nano::bench.
+
+#define NANO_BENCHMARK(NAME)                                                                                           \
+  static void NAME(nano::bench::context&);                                                                             \
+  static const nano::bench::registrar NAME##_registrar(#NAME, &NAME);                                                  \
+  static void NAME(nano::bench::context& ctx)
@@ -0,0 +1,61 @@
+#include "benchmark.h"
+
+#include <nano/geometry/charconv.h>
+#include <nano/geometry/stream.h>
+
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+NANO_BENCHMARK(charconv) {
+  const std::size_t count = 200000;
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<float> pos(-2000.0f, 2000.0f);
+  std::uniform_real_distribution<float> len(0.0f, 500.0f);
+
+  std::vector<nano::rect<float>> rects(count);
+  for (nano::rect<float>& r : rects) {
+    r = { pos(gen), pos(gen), len(gen), len(gen) };
+  }
+
+  // Shortest round trip through the stream operators needs max_digits10.
+  ctx.measure("charconv/format/ostream", count, [&] {
+    std::ostringstream stream;
+    stream.precision(9);
+    for (const nano::rect<float>& r : rects) {
+      stream << r << '\n';
+    }
+    nano::bench::do_not_optimize(stream.str().size());
+  });
+
+  std::vector<char> buffer(count * 64);
+  nano::bulk_to_chars_result formatted = {};
+  ctx.measure("charconv/format/to_chars", count, [&] {
+    formatted = nano::to_chars(buffer.data(), buffer.data() + buffer.size(), rects.data(), rects.size());
+    nano::bench::do_not_optimize(formatted.ptr);
+  });
+
+  std::vector<nano::rect<float>> parsed(count);
+  // strtof on each component, skipping the brace or comma before it.
+  ctx.measure("charconv/parse/strtof", count, [&] {
+    const char* p = buffer.data();
+    for (nano::rect<float>& r : parsed) {
+      char* end = nullptr;
+      r.x = std::strtof(p + 1, &end);
+      r.y = std::strtof(end + 1, &end);
+      r.width = std::strtof(end + 1, &end);
+      r.height = std::strtof(end + 1, &end);
+      p = end + 2;
+    }
+    nano::bench::do_not_optimize(parsed.data());
+  });
+
+  ctx.measure("charconv/parse/from_chars", count, [&] {
+    const nano::bulk_from_chars_result res
+        = nano::from_chars(buffer.data(), formatted.ptr, parsed.data(), parsed.size());
+    nano::bench::do_not_optimize(res.count);
+  });
+}
+} // namespace.
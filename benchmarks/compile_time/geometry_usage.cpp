@@ -0,0 +1,44 @@
+// Translation unit of the compile time benchmark (nano-geometry-compile-time).
+//
+// It is compiled on its own for each configuration, not linked: header only, without the
+// stream operators and with the extern templates of nano-geometry-lib. It uses the types
+// the way application code usually does, for float, double and int.
+
+#include <nano/geometry.h>
+
+namespace {
+template <typename T>
+T use_geometry(const nano::rect<T>& a, const nano::rect<T>& b, const nano::point<T>& p) {
+  const nano::padding<T> pad(1, 2, 3, 4);
+  const nano::range<T> span = nano::range<T>::with_length(a.x, a.width);
+
+  nano::rect<T> r = a.get_union(b).intersection(pad.inside_rect(b));
+  r = r.with_middle(p).with_size(b.size * static_cast<T>(2)).reduced({ 1, 1 });
+  r += a.middle() - b.bottom_right();
+
+  T sum = r.area() + span.clipped_value(p.x) + r.top_right().y;
+  sum += static_cast<T>(r.contains(p) + r.intersects(a) + (r == b) + (span.length() > 0));
+
+  const nano::quad<T> q(r.top_left(), r.top_right(), r.bottom_right(), r.bottom_left());
+  const nano::quad<T> qa(a.top_left(), a.top_right(), a.bottom_right(), a.bottom_left());
+  sum += q.top_left.x + static_cast<T>(q != qa);
+  return sum;
+}
+
+template <typename T>
+T use_transform(const nano::rect<T>& a, const nano::point<T>& p) {
+  const nano::transform<T> rotation = nano::transform<T>::rotation(static_cast<T>(0.5), p);
+  const nano::transform<T> t = rotation * nano::transform<T>::scale({ 2, 2 }) + nano::point<T>{ 10, 20 };
+  const nano::quad<T> q = t.apply(a);
+  return t.apply(p).x + q.bottom_right.y;
+}
+} // namespace.
+
+double geometry_usage(double v) {
+  double sum = use_geometry<double>({ v, v, 10, 20 }, { 2, 3, 4, 5 }, { v, 1 });
+  sum += static_cast<double>(use_geometry<float>({ 1, 2, 30, 40 }, { 2, 3, 4, 5 }, { 7, 1 }));
+  sum += use_geometry<int>({ 1, 2, 30, 40 }, { 2, 3, 4, 5 }, { 7, 1 });
+  sum += use_transform<double>({ v, v, 10, 20 }, { v, 1 });
+  sum += static_cast<double>(use_transform<float>({ 1, 2, 30, 40 }, { 7, 1 }));
+  return sum;
+}
@@ -0,0 +1,43 @@
+# Compiler launcher of the compile time benchmark (nano-geometry-compile-time).
+#
+# Usage: cmake -DREPEAT=<n> -DLABEL=<name> -P time_compile.cmake -- <compiler command>
+#
+# Runs the compiler command REPEAT times and prints the mean time of a compilation.
+
+if (NOT DEFINED REPEAT)
+    set(REPEAT 5)
+endif()
+
+set(COMMAND_ARGS)
+set(FOUND_SEPARATOR OFF)
+math(EXPR LAST_ARG "${CMAKE_ARGC} - 1")
+
+foreach(I RANGE ${LAST_ARG})
+    if (FOUND_SEPARATOR)
+        list(APPEND COMMAND_ARGS "${CMAKE_ARGV${I}}")
+    elseif ("${CMAKE_ARGV${I}}" STREQUAL "--")
+        set(FOUND_SEPARATOR ON)
+    endif()
+endforeach()
+
+# Sub-second timestamps need CMake 3.23.
+if (CMAKE_VERSION VERSION_GREATER_EQUAL 3.23)
+    set(TIME_FORMAT "%s%f")
+    set(TIME_TO_MS "/ 1000")
+else()
+    set(TIME_FORMAT "%s")
+    set(TIME_TO_MS "* 1000")
+endif()
+
+string(TIMESTAMP START "${TIME_FORMAT}" UTC)
+
+foreach(I RANGE 1 ${REPEAT})
+    execute_process(COMMAND ${COMMAND_ARGS} RESULT_VARIABLE RESULT)
+    if (NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "compilation failed (${RESULT})")
+    endif()
+endforeach()
+
+string(TIMESTAMP END "${TIME_FORMAT}" UTC)
+math(EXPR MEAN_MS "(${END} - ${START}) ${TIME_TO_MS} / ${REPEAT}")
+message("${LABEL}: ${MEAN_MS} ms per compilation (${REPEAT} runs)")
@@ -0,0 +1,71 @@
+#include "benchmark.h"
+
+#include <nano/geometry/display_list.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+struct draw_op {
+  std::uint32_t kind;
+  std::uint32_t color;
+};
+
+NANO_BENCHMARK(display_list) {
+  const std::size_t count = 200000;
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<float> pos(0.0f, 20000.0f);
+  std::uniform_real_distribution<float> local(0.0f, 400.0f);
+  std::uniform_real_distribution<float> len(2.0f, 60.0f);
+
+  // A long scrolling canvas: groups of 50 ops under a translated transform.
+  std::vector<nano::transform<float>> transforms(count / 50);
+  for (nano::transform<float>& t : transforms) {
+    t = nano::transform<float>::translation({ pos(gen) * 0.1f, pos(gen) });
+  }
+
+  std::vector<nano::rect<float>> rects(count);
+  for (nano::rect<float>& r : rects) {
+    r = { local(gen), local(gen), len(gen), len(gen) };
+  }
+
+  nano::display_list<float, draw_op> list;
+  ctx.measure("display_list/record/200k", count, [&] {
+    list.clear();
+    for (std::size_t i = 0; i < count; i++) {
+      if (i % 50 == 0) {
+        list.set_transform(transforms[i / 50]);
+      }
+      list.record({ 1, static_cast<std::uint32_t>(i) }, rects[i]);
+    }
+    nano::bench::do_not_optimize(list.size());
+  });
+
+  ctx.measure("display_list/build_index/200k", count, [&] {
+    list.record({ 0, 0 }, { 0, 0, 1, 1 });
+    list.build_index();
+  });
+
+  std::vector<nano::rect<float>> viewports(64);
+  for (nano::rect<float>& v : viewports) {
+    v = { 0, pos(gen), 1920, 1080 };
+  }
+
+  // Both visit the ops with the same callback, which stands for the draw call.
+  ctx.measure("display_list/replay_all/64", viewports.size(), [&] {
+    std::size_t visited = 0;
+    for (std::size_t i = 0; i < viewports.size(); i++) {
+      list.replay([&](const draw_op& op, const auto&) { visited += op.color != 0; });
+    }
+    nano::bench::do_not_optimize(visited);
+  });
+
+  ctx.measure("display_list/replay_culled/64", viewports.size(), [&] {
+    std::size_t visited = 0;
+    for (const nano::rect<float>& v : viewports) {
+      list.replay(v, [&](const draw_op& op, const auto&) { visited += op.color != 0; });
+    }
+    nano::bench::do_not_optimize(visited);
+  });
+}
+} // namespace.
@@ -0,0 +1,54 @@
+#include "benchmark.h"
+
+#include <nano/geometry/histogram.h>
+
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+NANO_BENCHMARK(histogram) {
+  const std::size_t count = 1000000;
+  std::mt19937 gen(2);
+  std::normal_distribution<float> coord(512.0f, 200.0f);
+  std::vector<nano::point<float>> points(count);
+  std::vector<float> weights(count);
+  for (std::size_t i = 0; i < count; i++) {
+    points[i] = { coord(gen), coord(gen) };
+    weights[i] = static_cast<float>(i % 7);
+  }
+
+  const nano::rect<float> bounds = { 0, 0, 1024, 1024 };
+
+  nano::point_histogram<float> single(bounds, 256, 256);
+  ctx.measure("histogram/add/1M", count, [&] {
+    single.add(points.data(), count);
+    nano::bench::do_not_optimize(single.bins());
+  });
+
+  ctx.measure("histogram/add_weighted/1M", count, [&] {
+    single.add(points.data(), weights.data(), count);
+    nano::bench::do_not_optimize(single.bins());
+  });
+
+  nano::point_histogram<float> threaded(bounds, 256, 256, 0);
+  ctx.measure("histogram/add_threads/1M", count, [&] {
+    threaded.add(points.data(), count);
+    nano::bench::do_not_optimize(threaded.bins());
+  });
+
+  // Streaming in chunks, merged once.
+  ctx.measure("histogram/add_chunks/1M", count, [&] {
+    for (std::size_t first = 0; first < count; first += 4096) {
+      single.add(points.data() + first, std::min<std::size_t>(4096, count - first));
+    }
+
+    nano::bench::do_not_optimize(single.bins());
+  });
+
+  ctx.measure("histogram/splat/100k", count / 10, [&] {
+    threaded.splat(points.data(), nullptr, count / 10, 1.5f);
+    nano::bench::do_not_optimize(threaded.bins());
+  });
+}
+} // namespace.
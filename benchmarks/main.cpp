@@ -0,0 +1,97 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Usage: nano-geometry-benchmarks [--filter <name>] [--min-time <seconds>] [--temp <directory>]
+//                                  [--counters <on|off>] [--workload <trace>]
+//
+// `--workload` replays a trace recorded with nano::workload_recorder<float> instead of the
+// synthetic one in the workload_replay benchmark.
+//
+// Results are written to stdout as JSON. When the hardware counters are available, each result
+// also has the counters per item and the instructions per cycle, "counters" lists the ones that
+// were recorded (empty when perf events are not permitted or not supported).
+int main(int argc, char* argv[]) {
+  std::string filter;
+  double min_time = 0.25;
+  std::string temp_directory = ".";
+  bool use_counters = true;
+  std::string workload_path;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (std::strcmp(argv[i], "--filter") == 0) {
+      filter = argv[i + 1];
+    }
+    else if (std::strcmp(argv[i], "--min-time") == 0) {
+      min_time = std::atof(argv[i + 1]);
+    }
+    else if (std::strcmp(argv[i], "--temp") == 0) {
+      temp_directory = argv[i + 1];
+    }
+    else if (std::strcmp(argv[i], "--counters") == 0) {
+      use_counters = std::strcmp(argv[i + 1], "off") != 0;
+    }
+    else if (std::strcmp(argv[i], "--workload") == 0) {
+      workload_path = argv[i + 1];
+    }
+  }
+
+  nano::bench::context ctx(min_time, temp_directory, use_counters, workload_path);
+
+  for (const auto& benchmark : nano::bench::registry()) {
+    if (filter.empty() || std::strstr(benchmark.first, filter.c_str())) {
+      std::fprintf(stderr, "running %s\n", benchmark.first);
+      benchmark.second(ctx);
+    }
+  }
+
+  std::vector<nano::bench::counter> counters;
+  for (std::size_t i = 0; i < nano::bench::counter_count; i++) {
+    if (ctx.has_counter(static_cast<nano::bench::counter>(i))) {
+      counters.push_back(static_cast<nano::bench::counter>(i));
+    }
+  }
+
+  std::printf("{\n  \"counters\": [");
+  for (std::size_t i = 0; i < counters.size(); i++) {
+    std::printf("%s\"%s\"", i ? ", " : "", nano::bench::counter_name(counters[i]));
+  }
+
+  std::printf("],\n  \"benchmarks\": [");
+
+  const char* separator = "\n";
+  for (const nano::bench::result& res : ctx.results()) {
+    const double seconds_per_call = res.seconds / static_cast<double>(res.iterations);
+    const double items = static_cast<double>(res.items);
+
+    std::printf("%s    { \"name\": \"%s\", \"iterations\": %zu, \"items\": %zu, \"ns_per_call\": %.3f, "
+                "\"ns_per_item\": %.3f, \"items_per_second\": %.1f",
+        separator, res.name.c_str(), res.iterations, res.items, seconds_per_call * 1e9,
+        items > 0 ? seconds_per_call * 1e9 / items : 0.0, items > 0 ? items / seconds_per_call : 0.0);
+
+    // Per item, or per call for benchmarks without items.
+    const double count = static_cast<double>(res.iterations) * std::max(items, 1.0);
+    for (nano::bench::counter c : counters) {
+      std::printf(", \"%s_per_item\": %.4f", nano::bench::counter_name(c),
+          res.counters[static_cast<std::size_t>(c)] / count);
+    }
+
+    const double cycles = res.counters[static_cast<std::size_t>(nano::bench::counter::cycles)];
+    const double instructions = res.counters[static_cast<std::size_t>(nano::bench::counter::instructions)];
+    if (ctx.has_counter(nano::bench::counter::cycles) && ctx.has_counter(nano::bench::counter::instructions)
+        && cycles > 0) {
+      std::printf(", \"ipc\": %.3f", instructions / cycles);
+    }
+
+    std::printf(" }");
+    separator = ",\n";
+  }
+
+  std::printf("\n  ]\n}\n");
+  return 0;
+}
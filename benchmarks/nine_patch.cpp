@@ -0,0 +1,68 @@
+#include "benchmark.h"
+
+#include <nano/geometry/nine_patch.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+NANO_BENCHMARK(nine_patch) {
+  const std::size_t count = 100000;
+  std::mt19937 gen(9);
+  std::uniform_real_distribution<float> pos(0.0f, 1920.0f);
+  std::uniform_real_distribution<float> len(4.0f, 300.0f);
+  std::uniform_int_distribution<int> skin(0, 15);
+
+  std::vector<nano::nine_patch<float>> patches(count);
+  for (nano::nine_patch<float>& p : patches) {
+    const int s = skin(gen);
+    p.destination = { pos(gen), pos(gen), len(gen), len(gen) };
+    p.source = { static_cast<float>(s % 4) * 64.0f, static_cast<float>(s / 4) * 64.0f, 64, 64 };
+    p.insets = nano::padding<float>(8, 12, 8, 12);
+  }
+
+  const nano::size<float> atlas_size = { 256, 256 };
+  const nano::transform<float> t = nano::transform<float>::scale({ 1.5f, 1.5f }) + nano::point<float>{ 0, -400 };
+  nano::vertex_emit_options<float> opts;
+  opts.transform = &t;
+  std::vector<nano::textured_vertex<float>> vertices(count * nano::nine_patch_cells * nano::vertices_per_quad);
+
+  // The way skins were drawn: inside_rect for the centers, the other cells around them,
+  // one emit_vertices call per widget. Both paths apply the scroll and zoom transform.
+  ctx.measure("nine_patch/inside_rect/100k", count, [&] {
+    std::size_t n_quads = 0;
+    for (const nano::nine_patch<float>& p : patches) {
+      const nano::rect<float> dc = p.insets.inside_rect(p.destination);
+      const nano::rect<float> sc = p.insets.inside_rect(p.source);
+      const float dx[4] = { p.destination.x, dc.x, dc.x + dc.width, p.destination.x + p.destination.width };
+      const float dy[4] = { p.destination.y, dc.y, dc.y + dc.height, p.destination.y + p.destination.height };
+      const float sx[4] = { p.source.x, sc.x, sc.x + sc.width, p.source.x + p.source.width };
+      const float sy[4] = { p.source.y, sc.y, sc.y + sc.height, p.source.y + p.source.height };
+
+      nano::rect<float> cells[9];
+      nano::rect<float> uvs[9];
+      std::size_t n = 0;
+      for (std::size_t row = 0; row < 3; row++) {
+        for (std::size_t col = 0; col < 3; col++) {
+          cells[n] = { dx[col], dy[row], dx[col + 1] - dx[col], dy[row + 1] - dy[row] };
+          if (cells[n].width > 0 && cells[n].height > 0) {
+            const nano::rect<float> s = { sx[col], sy[row], sx[col + 1] - sx[col], sy[row + 1] - sy[row] };
+            uvs[n++] = nano::atlas_uv(s, atlas_size);
+          }
+        }
+      }
+
+      nano::vertex_emit_options<float> cell_opts = opts;
+      cell_opts.uvs = uvs;
+      nano::emit_vertices(cells, n, vertices.data() + n_quads * nano::vertices_per_quad, cell_opts);
+      n_quads += n;
+    }
+    nano::bench::do_not_optimize(n_quads);
+  });
+
+  ctx.measure("nine_patch/batch/100k", count, [&] {
+    nano::bench::do_not_optimize(
+        nano::emit_nine_patches(patches.data(), patches.size(), atlas_size, vertices.data(), opts));
+  });
+}
+} // namespace.
@@ -0,0 +1,102 @@
+#include "benchmark.h"
+
+#include <nano/geometry/paged_rect_index.h>
+#include <nano/geometry/rect_index.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<nano::rect<double>> make_features(std::size_t count) {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> lon(-180.0, 180.0);
+  std::uniform_real_distribution<double> lat(-85.0, 85.0);
+  std::exponential_distribution<double> len(20.0);
+
+  std::vector<nano::rect<double>> rects(count);
+  for (nano::rect<double>& r : rects) {
+    r = { lon(gen), lat(gen), len(gen), len(gen) };
+  }
+
+  return rects;
+}
+
+std::vector<nano::rect<double>> make_queries(std::size_t count, double size) {
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<double> lon(-180.0, 180.0 - size);
+  std::uniform_real_distribution<double> lat(-85.0, 85.0 - size);
+
+  std::vector<nano::rect<double>> queries(count);
+  for (nano::rect<double>& q : queries) {
+    q = { lon(gen), lat(gen), size, size };
+  }
+
+  return queries;
+}
+
+NANO_BENCHMARK(rect_index_query) {
+  const std::vector<nano::rect<double>> rects = make_features(1000000);
+  const std::vector<nano::rect<double>> queries = make_queries(1000, 1.0);
+  nano::rect_index<double> index(rects);
+
+  ctx.measure("rect_index/build/1M", rects.size(), [&] {
+    nano::rect_index<double> tmp(rects);
+    nano::bench::do_not_optimize(tmp);
+  });
+
+  ctx.measure("rect_index/query/1M", queries.size(), [&] {
+    std::size_t hits = 0;
+    for (const nano::rect<double>& q : queries) {
+      index.query(q, [&](std::uint32_t, const nano::rect<double>&) { hits++; });
+    }
+    nano::bench::do_not_optimize(hits);
+  });
+}
+
+#if NANO_GEOMETRY_HAS_PAGED_RECT_INDEX
+NANO_BENCHMARK(paged_rect_index_query) {
+  const std::string path = ctx.temp_directory() + "/nano-geometry-bench.idx";
+  const std::vector<nano::rect<double>> rects = make_features(4000000);
+
+  nano::paged_rect_index_builder::options build_options;
+  build_options.memory_budget = 32 * 1024 * 1024;
+
+  ctx.measure("paged_rect_index/build/4M", rects.size(), [&] {
+    nano::paged_rect_index_builder builder(path, build_options);
+    for (std::size_t i = 0; i < rects.size(); i++) {
+      builder.add(rects[i], i);
+    }
+    builder.finish();
+  });
+
+  for (double size : { 0.1, 1.0, 10.0 }) {
+    const std::vector<nano::rect<double>> queries = make_queries(1000, size);
+    const std::string suffix = "/4M/" + std::to_string(size).substr(0, 4);
+
+    nano::paged_rect_index::options options;
+    nano::paged_rect_index mapped;
+    mapped.open(path, options);
+
+    options.use_mmap = false;
+    options.cache_pages = 4096;
+    nano::paged_rect_index cached;
+    cached.open(path, options);
+
+    for (nano::paged_rect_index* index : { &mapped, &cached }) {
+      const std::string name = index == &mapped ? "paged_rect_index/query/mmap" : "paged_rect_index/query/lru";
+      ctx.measure(name + suffix, queries.size(), [&] {
+        std::size_t hits = 0;
+        for (const nano::rect<double>& q : queries) {
+          index->query(q, [&](std::uint64_t, const nano::rect<double>&) { hits++; });
+        }
+        nano::bench::do_not_optimize(hits);
+      });
+    }
+  }
+
+  std::remove(path.c_str());
+}
+#endif // NANO_GEOMETRY_HAS_PAGED_RECT_INDEX
+} // namespace.
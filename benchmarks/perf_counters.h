@@ -0,0 +1,182 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      perf_counters.h
+ * @brief     nano-geometry benchmark hardware counters
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+  #define NANO_BENCH_HAS_PERF_EVENTS 1
+#else
+  #define NANO_BENCH_HAS_PERF_EVENTS 0
+#endif
+
+#if NANO_BENCH_HAS_PERF_EVENTS
+  #include <cstring>
+
+  #include <linux/perf_event.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace nano::bench {
+
+/// Hardware counters read around each benchmark.
+enum class counter : std::size_t { cycles, instructions, l1d_misses, llc_misses, branch_misses };
+
+inline constexpr std::size_t counter_count = 5;
+
+using counter_values = std::array<double, counter_count>;
+
+/// Name of a counter in the JSON output.
+inline const char* counter_name(counter c) noexcept {
+  constexpr const char* names[counter_count]
+      = { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses" };
+  return names[static_cast<std::size_t>(c)];
+}
+
+/// User space counters of the calling thread and of the threads it starts, through
+/// perf_event_open on Linux.
+///
+/// Each counter is opened on its own so that a missing one (e.g. no LLC event in a virtual
+/// machine) does not disable the others. Nothing is available when perf events are
+/// restricted (perf_event_paranoid, containers) or on other platforms, in which case
+/// start() and stop() do nothing.
+class perf_counters {
+public:
+  inline perf_counters() noexcept;
+
+  perf_counters(const perf_counters&) = delete;
+  perf_counters& operator=(const perf_counters&) = delete;
+
+  inline ~perf_counters() noexcept;
+
+  bool available(counter c) const noexcept { return _fds[static_cast<std::size_t>(c)] >= 0; }
+
+  inline bool any() const noexcept;
+
+  /// Starts a measurement.
+  inline void start() noexcept;
+
+  /// Writes the counts since start() to `values`, scaled up when the kernel had to
+  /// multiplex the counters. Unavailable counters are 0.
+  inline void stop(counter_values& values) noexcept;
+
+private:
+  // The counters run from construction and measurements are differences of readings, a
+  // reset would not clear the counts already inherited from finished threads.
+  struct reading {
+    std::uint64_t value = 0;
+    std::uint64_t enabled = 0;
+    std::uint64_t running = 0;
+  };
+
+  std::array<int, counter_count> _fds;
+  std::array<reading, counter_count> _start;
+
+  inline void read(std::array<reading, counter_count>& readings) noexcept;
+};
+
+#if NANO_BENCH_HAS_PERF_EVENTS
+
+perf_counters::perf_counters() noexcept {
+  const std::uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+  const std::pair<std::uint32_t, std::uint64_t> events[counter_count] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, l1d_read_miss },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  };
+
+  for (std::size_t i = 0; i < counter_count; i++) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = events[i].first;
+    attr.config = events[i].second;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    _fds[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+}
+
+perf_counters::~perf_counters() noexcept {
+  for (int fd : _fds) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+void perf_counters::start() noexcept { read(_start); }
+
+void perf_counters::stop(counter_values& values) noexcept {
+  std::array<reading, counter_count> end;
+  read(end);
+
+  for (std::size_t i = 0; i < counter_count; i++) {
+    const double running = static_cast<double>(end[i].running - _start[i].running);
+    const double enabled = static_cast<double>(end[i].enabled - _start[i].enabled);
+    values[i] = running > 0 ? static_cast<double>(end[i].value - _start[i].value) * enabled / running : 0.0;
+  }
+}
+
+void perf_counters::read(std::array<reading, counter_count>& readings) noexcept {
+  for (std::size_t i = 0; i < counter_count; i++) {
+    if (_fds[i] < 0 || ::read(_fds[i], &readings[i], sizeof(reading)) != static_cast<ssize_t>(sizeof(reading))) {
+      readings[i] = reading();
+    }
+  }
+}
+
+#else
+
+perf_counters::perf_counters() noexcept { _fds.fill(-1); }
+
+perf_counters::~perf_counters() noexcept {}
+
+void perf_counters::start() noexcept {}
+
+void perf_counters::stop(counter_values& values) noexcept { values.fill(0); }
+
+void perf_counters::read(std::array<reading, counter_count>& readings) noexcept { readings.fill(reading()); }
+
+#endif // NANO_BENCH_HAS_PERF_EVENTS
+
+bool perf_counters::any() const noexcept {
+  for (int fd : _fds) {
+    if (fd >= 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+} // namespace nano::bench.
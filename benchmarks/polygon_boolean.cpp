@@ -0,0 +1,64 @@
+#include "benchmark.h"
+
+#include <nano/geometry/polygon_boolean.h>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// Closed curve with a random radius per vertex, every edge crosses a few edges of the other operand.
+nano::polygon_set<double> make_polygon(std::size_t count, nano::point<double> center, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> radius(0.8, 1.0);
+  std::vector<nano::point<double>> points(count);
+
+  for (std::size_t i = 0; i < count; i++) {
+    const double angle = 6.283185307179586 * static_cast<double>(i) / static_cast<double>(count);
+    const double r = 1000.0 * radius(gen);
+    points[i] = { center.x + r * std::cos(angle), center.y + r * std::sin(angle) };
+  }
+
+  nano::polygon_set<double> s;
+  s.begin_polygon();
+  s.add_ring(points.data(), points.size());
+  return s;
+}
+
+NANO_BENCHMARK(polygon_boolean) {
+  const std::size_t sizes[] = { 100, 1000, 10000 };
+  const char* names[] = { "intersection", "unite", "difference", "exclusive_or" };
+
+  for (std::size_t size : sizes) {
+    const nano::polygon_set<double> a = make_polygon(size, { 0, 0 }, 3);
+    const nano::polygon_set<double> b = make_polygon(size, { 300, 200 }, 4);
+    nano::polygon_clipper<double> clipper;
+    nano::polygon_set<double> result;
+
+    for (int op = 0; op < 4; op++) {
+      ctx.measure(std::string("polygon_boolean/") + names[op] + "/" + std::to_string(size), 2 * size, [&] {
+        clipper.compute(a, b, static_cast<nano::boolean_operation>(op), result);
+        nano::bench::do_not_optimize(result.points().data());
+      });
+    }
+  }
+
+  // Rects that only need the fast path.
+  std::mt19937 gen(9);
+  std::uniform_real_distribution<float> coord(0.0f, 1000.0f);
+  std::vector<nano::rect<float>> rects(1024);
+  for (nano::rect<float>& r : rects) {
+    r = { coord(gen), coord(gen), 10.0f + coord(gen) * 0.1f, 10.0f + coord(gen) * 0.1f };
+  }
+
+  nano::polygon_clipper<float> clipper;
+  nano::polygon_set<float> result;
+  ctx.measure("polygon_boolean/rect_intersection/1024", rects.size(), [&] {
+    for (std::size_t i = 0; i < rects.size(); i++) {
+      clipper.compute(rects[i], rects[(i + 1) & 1023], nano::boolean_operation::intersection, result);
+      nano::bench::do_not_optimize(result.points().data());
+    }
+  });
+}
+} // namespace.
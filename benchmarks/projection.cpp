@@ -0,0 +1,70 @@
+#include "benchmark.h"
+
+#include <nano/geometry/projection.h>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+template <typename T>
+void libm_web_mercator(const nano::point<T>* in, std::size_t count, nano::point<T>* out) {
+  constexpr T pi = static_cast<T>(3.14159265358979323846);
+  constexpr T radius = static_cast<T>(6378137.0);
+  for (std::size_t i = 0; i < count; i++) {
+    const T latitude = std::min(std::max(in[i].y, T(-85.0511287798066)), T(85.0511287798066)) * (pi / 180);
+    out[i] = { in[i].x * (radius * pi / 180), radius * std::log(std::tan(pi / 4 + latitude / 2)) };
+  }
+}
+
+template <typename T>
+void bench_projection(nano::bench::context& ctx, const char* type) {
+  const std::size_t count = 1000000;
+  std::mt19937 gen(4);
+  std::uniform_real_distribution<double> longitude(-180, 180);
+  std::uniform_real_distribution<double> latitude(-85, 85);
+  std::vector<nano::point<T>> points(count);
+  std::vector<nano::point<T>> out(count);
+  for (nano::point<T>& p : points) {
+    p = { static_cast<T>(longitude(gen)), static_cast<T>(latitude(gen)) };
+  }
+
+  const std::string prefix = std::string("projection/") + type;
+  ctx.measure(prefix + "/libm/1M", count, [&] {
+    libm_web_mercator(points.data(), count, out.data());
+    nano::bench::do_not_optimize(out.data());
+  });
+
+  ctx.measure(prefix + "/web_mercator/1M", count, [&] {
+    nano::project(nano::map_projection::web_mercator, points.data(), count, out.data());
+    nano::bench::do_not_optimize(out.data());
+  });
+
+  const nano::transform<T> t = { T(0.5), 0, 0, T(-0.5), 256, 256 };
+  ctx.measure(prefix + "/web_mercator_transform/1M", count, [&] {
+    nano::project(nano::map_projection::web_mercator, points.data(), count, t, out.data());
+    nano::bench::do_not_optimize(out.data());
+  });
+
+  ctx.measure(prefix + "/web_mercator_then_transform/1M", count, [&] {
+    nano::project(nano::map_projection::web_mercator, points.data(), count, out.data());
+    for (nano::point<T>& p : out) {
+      p = t.apply(p);
+    }
+
+    nano::bench::do_not_optimize(out.data());
+  });
+
+  nano::project(nano::map_projection::web_mercator, points.data(), count, out.data());
+  ctx.measure(prefix + "/unproject/1M", count, [&] {
+    nano::unproject(nano::map_projection::web_mercator, out.data(), count, points.data());
+    nano::bench::do_not_optimize(points.data());
+  });
+}
+
+NANO_BENCHMARK(projection) {
+  bench_projection<float>(ctx, "float");
+  bench_projection<double>(ctx, "double");
+}
+} // namespace.
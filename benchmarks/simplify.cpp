@@ -0,0 +1,69 @@
+#include "benchmark.h"
+
+#include <nano/geometry/simplify.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+NANO_BENCHMARK(simplify) {
+  const std::size_t polyline_count = 1000;
+  const std::size_t polyline_size = 2500;
+  std::mt19937 gen(5);
+  std::normal_distribution<double> step(0.0, 1.0);
+
+  std::vector<nano::point<double>> tracks(polyline_count * polyline_size);
+  std::vector<std::size_t> offsets(polyline_count + 1);
+  for (std::size_t i = 0; i < polyline_count; i++) {
+    offsets[i] = i * polyline_size;
+    nano::point<double> p = { 0, 0 };
+    for (std::size_t j = 0; j < polyline_size; j++) {
+      p = { p.x + 1.0 + step(gen), p.y + step(gen) };
+      tracks[offsets[i] + j] = p;
+    }
+  }
+
+  offsets[polyline_count] = tracks.size();
+
+  const std::size_t total = tracks.size();
+  std::vector<nano::point<double>> work(total);
+  std::vector<std::size_t> sizes(polyline_count);
+  nano::polyline_simplifier<double> simplifier;
+
+  ctx.measure("simplify/douglas_peucker/2.5M", total, [&] {
+    work = tracks;
+    for (std::size_t i = 0; i < polyline_count; i++) {
+      sizes[i] = simplifier.simplify(work.data() + offsets[i], polyline_size, 2.0);
+    }
+    nano::bench::do_not_optimize(sizes.data());
+  });
+
+  ctx.measure("simplify/visvalingam/2.5M", total, [&] {
+    work = tracks;
+    for (std::size_t i = 0; i < polyline_count; i++) {
+      sizes[i] = simplifier.simplify(work.data() + offsets[i], polyline_size, 4.0, nano::simplify_method::visvalingam);
+    }
+    nano::bench::do_not_optimize(sizes.data());
+  });
+
+  ctx.measure("simplify/batch_douglas_peucker/2.5M", total, [&] {
+    work = tracks;
+    nano::simplify_batch(work.data(), offsets.data(), polyline_count, 2.0, sizes.data());
+    nano::bench::do_not_optimize(sizes.data());
+  });
+
+  // Re-simplification from precomputed importance.
+  std::vector<double> importance(total);
+  for (std::size_t i = 0; i < polyline_count; i++) {
+    simplifier.compute_importance(tracks.data() + offsets[i], polyline_size, importance.data() + offsets[i]);
+  }
+
+  ctx.measure("simplify/by_importance/2.5M", total, [&] {
+    for (std::size_t i = 0; i < polyline_count; i++) {
+      sizes[i] = nano::simplify_by_importance(tracks.data() + offsets[i], importance.data() + offsets[i],
+          polyline_size, 2.0, work.data() + offsets[i]);
+    }
+    nano::bench::do_not_optimize(sizes.data());
+  });
+}
+} // namespace.
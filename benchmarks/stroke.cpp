@@ -0,0 +1,41 @@
+#include "benchmark.h"
+
+#include <nano/geometry/stroke.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+NANO_BENCHMARK(stroke) {
+  const std::size_t count = 100000;
+  std::vector<nano::point<float>> points(count);
+  for (std::size_t i = 0; i < count; i++) {
+    const float x = static_cast<float>(i) * 0.5f;
+    points[i] = { x, 40.0f * std::sin(x * 0.05f) };
+  }
+
+  const nano::transform<float> t = nano::transform<float>::scale({ 1.5f, 1.5f });
+  const nano::line_join joins[] = { nano::line_join::bevel, nano::line_join::miter, nano::line_join::round };
+  const char* names[] = { "bevel", "miter", "round" };
+
+  for (std::size_t j = 0; j < 3; j++) {
+    nano::stroke_style<float> style;
+    style.width = 4;
+    style.join = joins[j];
+    style.cap = nano::line_cap::round;
+    style.transform = &t;
+
+    std::vector<nano::point<float>> vertices(nano::stroke_vertex_count(points.data(), count, style));
+    nano::rect<float> bounds;
+
+    ctx.measure(std::string("stroke/count/") + names[j] + "/100k", count, [&] {
+      nano::bench::do_not_optimize(nano::stroke_vertex_count(points.data(), count, style, &bounds));
+    });
+
+    ctx.measure(std::string("stroke/emit/") + names[j] + "/100k", count, [&] {
+      nano::bench::do_not_optimize(nano::stroke(points.data(), count, style, vertices.data(), &bounds));
+    });
+  }
+}
+} // namespace.
@@ -0,0 +1,71 @@
+#include "benchmark.h"
+
+#include <nano/geometry/transform_cull.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+NANO_BENCHMARK(transform_cull) {
+  const std::size_t count = 1000000;
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+  std::uniform_real_distribution<float> len(1.0f, 20.0f);
+  std::uniform_real_distribution<float> offset(-2000.0f, 4000.0f);
+
+  std::vector<nano::rect<float>> local(count);
+  std::vector<nano::transform<float>> transforms(count);
+  for (std::size_t i = 0; i < count; i++) {
+    local[i] = { pos(gen), pos(gen), len(gen), len(gen) };
+    transforms[i] = nano::transform<float>::rotation(pos(gen)) + nano::point<float>{ offset(gen), offset(gen) };
+  }
+
+  const nano::rect<float> viewport = { 0, 0, 1920, 1080 };
+  std::vector<nano::rect<float>> world(count);
+  std::vector<std::uint32_t> visible(count);
+
+  // Separate passes: apply, reduce the quad to its bounds, intersect, append.
+  ctx.measure("transform_cull/separate/1M", count, [&] {
+    std::vector<nano::quad<float>> quads(count);
+    for (std::size_t i = 0; i < count; i++) {
+      quads[i] = transforms[i].apply(local[i]);
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+      const nano::quad<float>& q = quads[i];
+      const float l = std::min(std::min(q.top_left.x, q.top_right.x), std::min(q.bottom_right.x, q.bottom_left.x));
+      const float t = std::min(std::min(q.top_left.y, q.top_right.y), std::min(q.bottom_right.y, q.bottom_left.y));
+      const float r = std::max(std::max(q.top_left.x, q.top_right.x), std::max(q.bottom_right.x, q.bottom_left.x));
+      const float b = std::max(std::max(q.top_left.y, q.top_right.y), std::max(q.bottom_right.y, q.bottom_left.y));
+      world[i] = nano::rect<float>::create_from_point({ l, t }, { r, b });
+    }
+
+    std::vector<unsigned char> is_visible(count);
+    for (std::size_t i = 0; i < count; i++) {
+      is_visible[i] = world[i].intersects(viewport);
+    }
+
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < count; i++) {
+      if (is_visible[i]) {
+        visible[n++] = static_cast<std::uint32_t>(i);
+      }
+    }
+
+    nano::bench::do_not_optimize(n);
+  });
+
+  ctx.measure("transform_cull/fused/1M", count, [&] {
+    const std::size_t n
+        = nano::transform_cull(local.data(), transforms.data(), count, viewport, world.data(), visible.data());
+    nano::bench::do_not_optimize(n);
+  });
+
+  ctx.measure("transform_cull/fused_shared/1M", count, [&] {
+    const std::size_t n
+        = nano::transform_cull(local.data(), count, transforms[0], viewport, world.data(), visible.data());
+    nano::bench::do_not_optimize(n);
+  });
+}
+} // namespace.
@@ -0,0 +1,51 @@
+#include "benchmark.h"
+
+#include <nano/geometry/triangulate.h>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// Closed curve with a random radius per vertex, plenty of reflex vertices.
+std::vector<nano::point<float>> make_polygon(std::size_t count) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> radius(0.5f, 1.0f);
+  std::vector<nano::point<float>> points(count);
+
+  for (std::size_t i = 0; i < count; i++) {
+    const float angle = 6.2831853f * static_cast<float>(i) / static_cast<float>(count);
+    const float r = 1000.0f * radius(gen);
+    points[i] = { r * std::cos(angle), r * std::sin(angle) };
+  }
+
+  return points;
+}
+
+NANO_BENCHMARK(triangulate) {
+  const std::size_t sizes[] = { 100, 1000, 5000, 50000 };
+
+  for (std::size_t size : sizes) {
+    const std::vector<nano::point<float>> points = make_polygon(size);
+    const nano::polygon_view<float> poly(points);
+    nano::polygon_triangulator<float> triangulator;
+    std::vector<std::uint32_t> indices;
+    indices.reserve(3 * size);
+
+    const std::string suffix = "/" + std::to_string(size);
+
+    ctx.measure("triangulate/ear_clipping" + suffix, size, [&] {
+      indices.clear();
+      triangulator.triangulate(poly, indices, nano::triangulation_method::ear_clipping);
+      nano::bench::do_not_optimize(indices.data());
+    });
+
+    ctx.measure("triangulate/monotone" + suffix, size, [&] {
+      indices.clear();
+      triangulator.triangulate(poly, indices, nano::triangulation_method::monotone);
+      nano::bench::do_not_optimize(indices.data());
+    });
+  }
+}
+} // namespace.
@@ -0,0 +1,45 @@
+#include "benchmark.h"
+
+#include <nano/geometry/weld.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+NANO_BENCHMARK(weld) {
+  const std::size_t sizes[] = { 1000, 100000, 1000000 };
+
+  for (std::size_t size : sizes) {
+    // Mesh-like input: every vertex appears about four times with some noise.
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> coord(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> jitter(-1e-4f, 1e-4f);
+    std::vector<nano::point<float>> unique(size / 4);
+    for (nano::point<float>& p : unique) {
+      p = { coord(gen), coord(gen) };
+    }
+
+    std::uniform_int_distribution<std::size_t> pick(0, unique.size() - 1);
+    std::vector<nano::point<float>> points(size);
+    for (nano::point<float>& p : points) {
+      const nano::point<float>& u = unique[pick(gen)];
+      p = { u.x + jitter(gen), u.y + jitter(gen) };
+    }
+
+    std::vector<nano::point<float>> out(size);
+    std::vector<std::uint32_t> remap(size);
+    nano::point_welder<float> welder;
+    const std::string suffix = "/" + std::to_string(size);
+
+    ctx.measure("weld/tolerance" + suffix, size, [&] {
+      nano::bench::do_not_optimize(welder.weld(points.data(), size, 1e-3f, remap.data(), out.data()));
+    });
+
+    ctx.measure("weld/exact" + suffix, size, [&] {
+      nano::bench::do_not_optimize(welder.weld(points.data(), size, 0.0f, remap.data(), out.data()));
+    });
+  }
+}
+} // namespace.
@@ -0,0 +1,233 @@
+#include "benchmark.h"
+
+#include <nano/geometry/rect_index.h>
+#include <nano/geometry/transform_cull.h>
+#include <nano/geometry/workload_trace.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+using rect_type = nano::rect<float>;
+using transform_type = nano::transform<float>;
+
+// UI trees: windows holding panels holding clustered, overlapping controls.
+std::vector<rect_type> make_ui_tree(std::mt19937& gen) {
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  std::vector<rect_type> rects;
+
+  for (int w = 0; w < 48; w++) {
+    const rect_type window
+        = { unit(gen) * 6000.0f, unit(gen) * 4000.0f, 400 + unit(gen) * 1200, 300 + unit(gen) * 800 };
+    rects.push_back(window);
+
+    for (int p = 0; p < 12; p++) {
+      const rect_type panel = { window.x + unit(gen) * window.width * 0.5f, window.y + unit(gen) * window.height * 0.5f,
+        window.width * (0.2f + unit(gen) * 0.3f), window.height * (0.2f + unit(gen) * 0.3f) };
+      rects.push_back(panel);
+
+      for (int c = 0; c < 48; c++) {
+        const float cw = 8 + unit(gen) * 120;
+        const float ch = 8 + unit(gen) * 32;
+        rects.push_back({ panel.x + unit(gen) * panel.width, panel.y + unit(gen) * panel.height, cw, ch });
+      }
+    }
+  }
+
+  return rects;
+}
+
+// Map features: long thin roads and rivers crossing each other, plus small buildings along them.
+std::vector<rect_type> make_map_features(std::mt19937& gen) {
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  std::vector<rect_type> rects;
+
+  for (int i = 0; i < 8000; i++) {
+    const float length = 200 + unit(gen) * 4000;
+    const float thickness = 1 + unit(gen) * 4;
+    const float x = unit(gen) * 8000.0f;
+    const float y = unit(gen) * 8000.0f;
+    rects.push_back(i % 2 ? rect_type{ x, y, length, thickness } : rect_type{ x, y, thickness, length });
+
+    for (int b = 0; b < 3; b++) {
+      rects.push_back({ x + unit(gen) * 40, y + unit(gen) * 40, 4 + unit(gen) * 16, 4 + unit(gen) * 16 });
+    }
+  }
+
+  return rects;
+}
+
+// Scrolls and zooms over both sets with a cull per frame and hit tests around the pointer.
+bool record_synthetic_workload(const std::string& path) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  const rect_type viewport = { 0, 0, 1920, 1080 };
+
+  nano::workload_recorder<float> recorder;
+  if (!recorder.open(path)) {
+    return false;
+  }
+
+  for (const std::vector<rect_type>& rects : { make_ui_tree(gen), make_map_features(gen) }) {
+    recorder.record_rects(rects.data(), rects.size());
+
+    float scale = 1;
+    nano::point<float> scroll = { 0, 0 };
+
+    for (int frame = 0; frame < 120; frame++) {
+      scale = std::clamp(scale * (0.9f + unit(gen) * 0.2f), 0.25f, 4.0f);
+      scroll += nano::point<float>{ unit(gen) * 200 - 100, unit(gen) * 200 - 100 };
+      recorder.record_transform(transform_type::scale({ scale, scale }) + scroll);
+      recorder.record_cull(viewport);
+
+      for (int q = 0; q < 16; q++) {
+        const rect_type& target = rects[static_cast<std::size_t>(unit(gen) * static_cast<float>(rects.size() - 1))];
+        const float extent = 1 + unit(gen) * 40;
+        recorder.record_query({ target.middle().x, target.middle().y, extent, extent });
+      }
+    }
+  }
+
+  return recorder.close();
+}
+
+rect_type quad_bounds(const nano::quad<float>& q) {
+  const float l = std::min(std::min(q.top_left.x, q.top_right.x), std::min(q.bottom_right.x, q.bottom_left.x));
+  const float t = std::min(std::min(q.top_left.y, q.top_right.y), std::min(q.bottom_right.y, q.bottom_left.y));
+  const float r = std::max(std::max(q.top_left.x, q.top_right.x), std::max(q.bottom_right.x, q.bottom_left.x));
+  const float b = std::max(std::max(q.top_left.y, q.top_right.y), std::max(q.bottom_right.y, q.bottom_left.y));
+  return rect_type::create_from_point({ l, t }, { r, b });
+}
+
+transform_type inverse(const transform_type& t) {
+  const float det = t.a * t.d - t.b * t.c;
+  const float a = t.d / det;
+  const float b = -t.b / det;
+  const float c = -t.c / det;
+  const float d = t.a / det;
+  return { a, b, c, d, -(a * t.tx + c * t.ty), -(b * t.tx + d * t.ty) };
+}
+
+// Runs the operations of `w`, `query` and `cull` get the current set, transform and region.
+template <typename Query, typename Cull>
+void replay(const nano::workload<float>& w, Query&& query, Cull&& cull) {
+  std::size_t set = 0;
+  transform_type t = transform_type::identity();
+
+  for (const nano::workload<float>::operation& op : w.operations) {
+    switch (op.op) {
+    case nano::workload_op::rects:
+      set = op.index;
+      break;
+
+    case nano::workload_op::transform:
+      t = w.transforms[op.index];
+      break;
+
+    case nano::workload_op::query:
+      query(set, w.regions[op.index]);
+      break;
+
+    case nano::workload_op::cull:
+      cull(set, t, w.regions[op.index]);
+      break;
+    }
+  }
+}
+
+NANO_BENCHMARK(workload_replay) {
+  std::string path = ctx.workload_path();
+  const bool synthetic = path.empty();
+
+  if (synthetic) {
+    path = ctx.temp_directory() + "/nano-geometry-bench.ngwt";
+    if (!record_synthetic_workload(path)) {
+      return;
+    }
+  }
+
+  nano::workload<float> w;
+  const bool loaded = nano::read_workload(path, w);
+
+  if (synthetic) {
+    std::remove(path.c_str());
+  }
+
+  if (!loaded || w.rect_sets.empty()) {
+    return;
+  }
+
+  const std::size_t operations = w.operations.size();
+  std::size_t max_set_size = 0;
+  std::size_t total_rects = 0;
+  for (const std::vector<rect_type>& rects : w.rect_sets) {
+    max_set_size = std::max(max_set_size, rects.size());
+    total_rects += rects.size();
+  }
+
+  std::vector<std::uint32_t> visible(max_set_size);
+
+  // One rect at a time, the way a widget tree or a layer list is usually walked.
+  ctx.measure("workload_replay/scalar", operations, [&] {
+    std::size_t n = 0;
+    replay(
+        w,
+        [&](std::size_t set, const rect_type& region) {
+          for (const rect_type& r : w.rect_sets[set]) {
+            n += r.intersects(region);
+          }
+        },
+        [&](std::size_t set, const transform_type& t, const rect_type& viewport) {
+          for (const rect_type& r : w.rect_sets[set]) {
+            n += quad_bounds(t.apply(r)).intersects(viewport);
+          }
+        });
+    nano::bench::do_not_optimize(n);
+  });
+
+  ctx.measure("workload_replay/batch", operations, [&] {
+    const transform_type identity = transform_type::identity();
+    std::size_t n = 0;
+    replay(
+        w,
+        [&](std::size_t set, const rect_type& region) {
+          const std::vector<rect_type>& rects = w.rect_sets[set];
+          n += nano::transform_cull<float>(rects.data(), rects.size(), identity, region, nullptr, visible.data());
+        },
+        [&](std::size_t set, const transform_type& t, const rect_type& viewport) {
+          const std::vector<rect_type>& rects = w.rect_sets[set];
+          n += nano::transform_cull<float>(rects.data(), rects.size(), t, viewport, nullptr, visible.data());
+        });
+    nano::bench::do_not_optimize(n);
+  });
+
+  std::vector<nano::rect_index<float>> indices(w.rect_sets.size());
+
+  ctx.measure("workload_replay/index_build", total_rects, [&] {
+    for (std::size_t i = 0; i < indices.size(); i++) {
+      indices[i].build(w.rect_sets[i].data(), w.rect_sets[i].size());
+    }
+  });
+
+  // Culls query the bounds of the viewport in local space, then test the candidates in world
+  // space. Exact for the scale and translation transforms of scrolling and zooming.
+  ctx.measure("workload_replay/index", operations, [&] {
+    std::size_t n = 0;
+    replay(
+        w,
+        [&](std::size_t set, const rect_type& region) {
+          indices[set].query(region, [&](std::size_t, const rect_type&) { n++; });
+        },
+        [&](std::size_t set, const transform_type& t, const rect_type& viewport) {
+          const rect_type local = quad_bounds(inverse(t).apply(viewport));
+          indices[set].query(local, [&](std::size_t, const rect_type& r) {
+            n += quad_bounds(t.apply(r)).intersects(viewport);
+          });
+        });
+    nano::bench::do_not_optimize(n);
+  });
+}
+} // namespace.
@@ -23,6 +23,17 @@
 
 #include <nano/common.h>
 
+// Stream operators (nano/geometry/stream.h), 0 to leave <ostream> out of this header.
+#ifndef NANO_GEOMETRY_STREAM_OPERATORS
+  #define NANO_GEOMETRY_STREAM_OPERATORS 1
+#endif
+
+// Set by the nano-geometry-lib target (see src/geometry.cpp), the float, double and int
+// instantiations are then compiled once in the library instead of in every translation unit.
+#ifndef NANO_GEOMETRY_EXTERN_TEMPLATES
+  #define NANO_GEOMETRY_EXTERN_TEMPLATES 0
+#endif
+
 NANO_CLANG_DIAGNOSTIC_PUSH()
 NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
 NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
@@ -502,9 +513,6 @@ struct point {
   /// Conversion operator to PointType with member X and Y.
   template <typename PointType, detail::enable_if_point_XY<PointType> = nullptr>
   NANO_NODC_INLINE explicit operator PointType() const;
-
-  template <typename U>
-  NANO_INLINE friend std::ostream& operator<<(std::ostream& s, const nano::point<U>& point);
 };
 
 static_assert(std::is_trivial<point<int>>::value, "nano::point must remain a trivial type");
@@ -606,9 +614,6 @@ struct size {
 
   template <typename SizeType, detail::enable_if_size_WH<SizeType> = nullptr>
   NANO_NODC_INLINE explicit operator SizeType() const;
-
-  template <typename U>
-  NANO_INLINE friend std::ostream& operator<<(std::ostream& s, const nano::size<U>& size);
 };
 
 static_assert(std::is_trivial<size<int>>::value, "nano::size must remain a trivial type");
@@ -828,9 +833,6 @@ struct rect {
 
   template <typename RectType, detail::enable_if_rect_ltrb<RectType> = nullptr>
   NANO_NODC_INLINE explicit operator RectType() const;
-
-  template <typename U>
-  NANO_INLINE friend std::ostream& operator<<(std::ostream& s, const nano::rect<U>& rect);
 };
 
 static_assert(std::is_trivial<rect<int>>::value, "nano::rect must remain a trivial type");
@@ -887,12 +889,6 @@ public:
   NANO_NODC_INLINE_CXPR bool operator==(const quad& q) const NANO_NOEXCEPT;
 
   NANO_NODC_INLINE_CXPR bool operator!=(const quad& q) const NANO_NOEXCEPT;
-
-  friend std::ostream& operator<<(std::ostream& stream, const quad& p) {
-    stream << "[{" << p.top_left << "}, {" << p.top_right << "}, {" << p.bottom_right << "}, {" << p.bottom_left
-           << "}]";
-    return stream;
-  }
 };
 
 ///
@@ -1202,11 +1198,6 @@ NANO_INLINE PointType point<T>::convert() const {
   return PointType{ static_cast<Type>(x), static_cast<Type>(y) };
 }
 
-template <typename T>
-NANO_INLINE std::ostream& operator<<(std::ostream& s, const nano::point<T>& point) {
-  return s << '{' << point.x << ',' << point.y << '}';
-}
-
 //
 // MARK: - size -
 //
@@ -1412,11 +1403,6 @@ NANO_INLINE SizeType size<T>::convert() const {
   return SizeType{ static_cast<Type>(width), static_cast<Type>(height) };
 }
 
-template <typename T>
-NANO_INLINE std::ostream& operator<<(std::ostream& s, const nano::size<T>& size) {
-  return s << '{' << size.width << ',' << size.height << '}';
-}
-
 //
 // MARK: - rect -
 //
@@ -1567,7 +1553,7 @@ NANO_INLINE_CXPR rect<T> rect<T>::with_middle(const point_type& point) const NAN
 
 template <typename T>
 NANO_INLINE_CXPR rect<T> rect<T>::with_middle_left(const point_type& point) const NANO_NOEXCEPT {
-  return { point.x, point.y - height * 0.5, width, height };
+  return { point.x, static_cast<value_type>(point.y - height * 0.5), width, height };
 }
 
 template <typename T>
@@ -2010,11 +1996,6 @@ NANO_INLINE RectType rect<T>::convert() const {
     static_cast<Type>(y + height) };
 }
 
-template <typename T>
-NANO_INLINE std::ostream& operator<<(std::ostream& s, const nano::rect<T>& rect) {
-  return s << '{' << rect.x << ',' << rect.y << ',' << rect.width << ',' << rect.height << '}';
-}
-
 //
 // MARK: - range -
 //
@@ -2245,11 +2226,6 @@ NANO_CXPR bool range<T>::operator>=(const range<T>& r) const NANO_NOEXCEPT {
   }
 }
 
-template <class T>
-NANO_INLINE std::ostream& operator<<(std::ostream& s, const range<T>& r) {
-  return s << '{' << r.start << ',' << r.end << '}';
-}
-
 //
 // MARK: - padding -
 //
@@ -2307,11 +2283,6 @@ NANO_CXPR bool padding<T>::operator!=(const padding& p) const NANO_NOEXCEPT {
   return !operator==(p);
 }
 
-template <typename T>
-std::ostream& operator<<(std::ostream& s, const padding<T>& p) {
-  return s << '{' << p.top << ',' << p.left << ',' << p.bottom << ',' << p.right << '}';
-}
-
 template <typename T>
 NANO_INLINE_CXPR quad<T>::quad(const point_type& tl, const point_type& tr, const point_type& br,
     const point_type& bl) NANO_NOEXCEPT : top_left(tl),
@@ -2543,4 +2514,44 @@ NANO_NODC_INLINE_CXPR nano::quad<T> operator*(const nano::quad<T>& q, const tran
 }
 } // namespace nano.
 
+//
+// MARK: - extern templates -
+//
+
+#if NANO_GEOMETRY_EXTERN_TEMPLATES
+namespace nano {
+extern template struct range<int>;
+extern template struct range<float>;
+extern template struct range<double>;
+
+extern template struct padding<int>;
+extern template struct padding<float>;
+extern template struct padding<double>;
+
+extern template struct point<int>;
+extern template struct point<float>;
+extern template struct point<double>;
+
+extern template struct size<int>;
+extern template struct size<float>;
+extern template struct size<double>;
+
+extern template struct rect<int>;
+extern template struct rect<float>;
+extern template struct rect<double>;
+
+extern template class quad<int>;
+extern template class quad<float>;
+extern template class quad<double>;
+
+// nano::transform only exists for floating points.
+extern template class transform<float>;
+extern template class transform<double>;
+} // namespace nano.
+#endif // NANO_GEOMETRY_EXTERN_TEMPLATES
+
 NANO_CLANG_DIAGNOSTIC_POP()
+
+#if NANO_GEOMETRY_STREAM_OPERATORS
+  #include <nano/geometry/stream.h>
+#endif
@@ -0,0 +1,316 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/arrow.h
+ * @brief     nano Arrow C data interface export and import
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// Arrow C data interface ABI (https://arrow.apache.org/docs/format/CDataInterface.html).
+// The guard is the one of the specification, so that this header and arrow/c/abi.h can
+// be included together.
+#ifndef ARROW_C_DATA_INTERFACE
+  #define ARROW_C_DATA_INTERFACE
+
+  #define ARROW_FLAG_DICTIONARY_ORDERED 1
+  #define ARROW_FLAG_NULLABLE 2
+  #define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  std::int64_t flags;
+  std::int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray {
+  std::int64_t length;
+  std::int64_t null_count;
+  std::int64_t offset;
+  std::int64_t n_buffers;
+  std::int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+} // extern "C".
+#endif // ARROW_C_DATA_INTERFACE
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Rects stored as one column per component.
+///
+/// Only a view, the columns are owned elsewhere (e.g. vectors or an imported ArrowArray).
+template <typename T>
+struct rect_columns {
+  using value_type = T;
+
+  const T* x = nullptr;
+  const T* y = nullptr;
+  const T* width = nullptr;
+  const T* height = nullptr;
+  std::size_t size = 0;
+
+  NANO_NODC_INLINE_CXPR nano::rect<T> operator[](std::size_t index) const NANO_NOEXCEPT;
+};
+
+/// Points stored as one column per component.
+template <typename T>
+struct point_columns {
+  using value_type = T;
+
+  const T* x = nullptr;
+  const T* y = nullptr;
+  std::size_t size = 0;
+
+  NANO_NODC_INLINE_CXPR nano::point<T> operator[](std::size_t index) const NANO_NOEXCEPT;
+};
+
+/// Exports the columns as an Arrow struct array of non-nullable float ("f") or double ("g")
+/// children named "x", "y", "width" and "height", without copying them.
+///
+/// `array` and `schema` are filled following the C data interface and belong to the
+/// consumer, who calls their release callbacks when done (children can be moved out and
+/// released on their own). `owner` keeps the columns alive until the array and all its
+/// moved children are released, it can be null when the columns outlive the consumer.
+template <typename T>
+inline void export_arrow(const rect_columns<T>& columns, std::shared_ptr<const void> owner, ArrowArray* array,
+    ArrowSchema* schema);
+
+/// Same as above with children named "x" and "y".
+template <typename T>
+inline void export_arrow(const point_columns<T>& columns, std::shared_ptr<const void> owner, ArrowArray* array,
+    ArrowSchema* schema);
+
+/// Points `columns` to the buffers of an Arrow struct array, without copying them.
+///
+/// The children are looked up by name, a child which is not found by name is taken at
+/// its position (e.g. for unnamed children). Returns false, leaving `columns` unchanged,
+/// if the schema is not a struct of the expected children of format "f" (float) or "g"
+/// (double) matching T, or if any value is null. The array keeps ownership, it must not
+/// be released while `columns` is used.
+template <typename T>
+inline bool import_arrow(const ArrowArray* array, const ArrowSchema* schema, rect_columns<T>& columns) NANO_NOEXCEPT;
+
+/// Same as above with children "x" and "y".
+template <typename T>
+inline bool import_arrow(const ArrowArray* array, const ArrowSchema* schema, point_columns<T>& columns) NANO_NOEXCEPT;
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+namespace detail {
+  template <typename T>
+  NANO_INLINE_CXPR const char* arrow_format() NANO_NOEXCEPT {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "nano arrow columns must be float or double");
+    return std::is_same_v<T, float> ? "f" : "g";
+  }
+
+  /// Memory shared by an exported struct array and its children.
+  ///
+  /// Every exported struct (array, schema and their children) holds a reference in its
+  /// private_data, the block and the owner of the columns go away with the last release.
+  template <std::size_t N>
+  struct arrow_export {
+    std::shared_ptr<const void> owner;
+
+    ArrowArray child_arrays[N];
+    ArrowArray* child_array_pointers[N];
+    const void* child_buffers[N][2];
+    const void* buffers[1];
+
+    ArrowSchema child_schemas[N];
+    ArrowSchema* child_schema_pointers[N];
+  };
+
+  using arrow_export_reference = std::shared_ptr<const void>;
+
+  /// Release callback of the arrays and schemas exported by nano, releases the children
+  /// which were not moved out then drops the reference to the export block.
+  template <typename S>
+  inline void arrow_release(S* s) {
+    for (std::int64_t i = 0; i < s->n_children; i++) {
+      S* child = s->children[i];
+      if (child->release) {
+        child->release(child);
+      }
+    }
+
+    delete static_cast<arrow_export_reference*>(s->private_data);
+    s->release = nullptr;
+  }
+
+  template <typename T, std::size_t N>
+  inline void export_arrow(const T* const (&data)[N], const char* const (&names)[N], std::size_t size,
+      std::shared_ptr<const void> owner, ArrowArray* array, ArrowSchema* schema) {
+    auto block = std::make_shared<arrow_export<N>>();
+    block->owner = std::move(owner);
+    block->buffers[0] = nullptr;
+
+    const std::int64_t length = static_cast<std::int64_t>(size);
+    const std::int64_t n_children = static_cast<std::int64_t>(N);
+
+    for (std::size_t i = 0; i < N; i++) {
+      block->child_buffers[i][0] = nullptr;
+      block->child_buffers[i][1] = data[i];
+      block->child_arrays[i] = { length, 0, 0, 2, 0, block->child_buffers[i], nullptr, nullptr,
+        &arrow_release<ArrowArray>, new arrow_export_reference(block) };
+      block->child_array_pointers[i] = &block->child_arrays[i];
+
+      block->child_schemas[i] = { arrow_format<T>(), names[i], nullptr, 0, 0, nullptr, nullptr,
+        &arrow_release<ArrowSchema>, new arrow_export_reference(block) };
+      block->child_schema_pointers[i] = &block->child_schemas[i];
+    }
+
+    *array = { length, 0, 0, 1, n_children, block->buffers, block->child_array_pointers, nullptr,
+      &arrow_release<ArrowArray>, new arrow_export_reference(block) };
+
+    *schema = { "+s", "", nullptr, 0, n_children, block->child_schema_pointers, nullptr, &arrow_release<ArrowSchema>,
+      new arrow_export_reference(block) };
+  }
+
+  template <typename T, std::size_t N>
+  inline bool import_arrow(const ArrowArray* array, const ArrowSchema* schema, const char* const (&names)[N],
+      const T* (&data)[N]) NANO_NOEXCEPT {
+    if (!array || !schema || !array->release || !schema->release || !schema->format
+        || std::strcmp(schema->format, "+s") != 0 || schema->n_children != static_cast<std::int64_t>(N)
+        || array->n_children != schema->n_children || array->length < 0 || array->offset < 0
+        || array->null_count > 0 || (array->null_count != 0 && array->n_buffers > 0 && array->buffers[0])) {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < N; i++) {
+      std::int64_t index = static_cast<std::int64_t>(i);
+
+      for (std::int64_t c = 0; c < schema->n_children; c++) {
+        const char* name = schema->children[c]->name;
+        if (name && std::strcmp(name, names[i]) == 0) {
+          index = c;
+          break;
+        }
+      }
+
+      const ArrowSchema* child_schema = schema->children[index];
+      const ArrowArray* child = array->children[index];
+      if (!child_schema->format || std::strcmp(child_schema->format, arrow_format<T>()) != 0 || child->n_buffers != 2
+          || child->offset < 0 || child->length < array->offset + array->length || child->null_count > 0
+          || (child->null_count != 0 && child->buffers[0])) {
+        return false;
+      }
+
+      data[i] = static_cast<const T*>(child->buffers[1]) + child->offset + array->offset;
+    }
+
+    return true;
+  }
+} // namespace detail.
+
+//
+// MARK: - rect_columns -
+//
+
+template <typename T>
+NANO_INLINE_CXPR nano::rect<T> rect_columns<T>::operator[](std::size_t index) const NANO_NOEXCEPT {
+  return { x[index], y[index], width[index], height[index] };
+}
+
+template <typename T>
+NANO_INLINE_CXPR nano::point<T> point_columns<T>::operator[](std::size_t index) const NANO_NOEXCEPT {
+  return { x[index], y[index] };
+}
+
+//
+// MARK: - export -
+//
+
+template <typename T>
+void export_arrow(const rect_columns<T>& columns, std::shared_ptr<const void> owner, ArrowArray* array,
+    ArrowSchema* schema) {
+  const T* const data[4] = { columns.x, columns.y, columns.width, columns.height };
+  const char* const names[4] = { "x", "y", "width", "height" };
+  detail::export_arrow(data, names, columns.size, std::move(owner), array, schema);
+}
+
+template <typename T>
+void export_arrow(const point_columns<T>& columns, std::shared_ptr<const void> owner, ArrowArray* array,
+    ArrowSchema* schema) {
+  const T* const data[2] = { columns.x, columns.y };
+  const char* const names[2] = { "x", "y" };
+  detail::export_arrow(data, names, columns.size, std::move(owner), array, schema);
+}
+
+//
+// MARK: - import -
+//
+
+template <typename T>
+bool import_arrow(const ArrowArray* array, const ArrowSchema* schema, rect_columns<T>& columns) NANO_NOEXCEPT {
+  const char* const names[4] = { "x", "y", "width", "height" };
+  const T* data[4];
+  if (!detail::import_arrow(array, schema, names, data)) {
+    return false;
+  }
+
+  columns = { data[0], data[1], data[2], data[3], static_cast<std::size_t>(array->length) };
+  return true;
+}
+
+template <typename T>
+bool import_arrow(const ArrowArray* array, const ArrowSchema* schema, point_columns<T>& columns) NANO_NOEXCEPT {
+  const char* const names[2] = { "x", "y" };
+  const T* data[2];
+  if (!detail::import_arrow(array, schema, names, data)) {
+    return false;
+  }
+
+  columns = { data[0], data[1], static_cast<std::size_t>(array->length) };
+  return true;
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
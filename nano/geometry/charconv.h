@@ -0,0 +1,521 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/charconv.h
+ * @brief     nano geometry text formatting and parsing
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+// Floating point std::to_chars and std::from_chars (shortest round trip, no locale). Without
+// them the scalars go through snprintf and strtod, which use the C locale of the program.
+#ifndef NANO_GEOMETRY_HAS_FLOAT_CHARCONV
+  #if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    #define NANO_GEOMETRY_HAS_FLOAT_CHARCONV 1
+  #else
+    #define NANO_GEOMETRY_HAS_FLOAT_CHARCONV 0
+  #endif
+#endif
+
+#if !NANO_GEOMETRY_HAS_FLOAT_CHARCONV
+  #include <cerrno>
+  #include <cmath>
+  #include <cstdio>
+  #include <cstdlib>
+  #include <cstring>
+#endif
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Text conversion of the nano types, in the spirit of std::to_chars and std::from_chars:
+/// no allocation, no locale, no exception and no null terminator.
+///
+/// Values are written with the layout of the stream operators, without spaces:
+/// - range: {start,end}
+/// - padding: {top,left,bottom,right}
+/// - point: {x,y}
+/// - size: {width,height}
+/// - rect: {x,y,width,height}
+/// - quad: {{x,y},{x,y},{x,y},{x,y}} (top_left, top_right, bottom_right, bottom_left)
+/// - transform: {a,b,c,d,tx,ty}
+///
+/// Floating points use the shortest representation that parses back to the same value.
+/// Parsing accepts spaces, tabs and new lines around the braces and the commas.
+///
+/// When the output does not fit, to_chars returns {last, std::errc::value_too_large} and
+/// the content of [first, last) is unspecified. from_chars returns
+/// std::errc::invalid_argument on malformed input and std::errc::result_out_of_range when a
+/// component does not fit in T, leaving the value unchanged in both cases.
+
+template <typename T>
+inline std::to_chars_result to_chars(char* first, char* last, const range<T>& r) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::to_chars_result to_chars(char* first, char* last, const padding<T>& p) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::to_chars_result to_chars(char* first, char* last, const point<T>& p) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::to_chars_result to_chars(char* first, char* last, const size<T>& s) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::to_chars_result to_chars(char* first, char* last, const rect<T>& r) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::to_chars_result to_chars(char* first, char* last, const quad<T>& q) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::to_chars_result to_chars(char* first, char* last, const transform<T>& t) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::from_chars_result from_chars(const char* first, const char* last, range<T>& r) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::from_chars_result from_chars(const char* first, const char* last, padding<T>& p) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::from_chars_result from_chars(const char* first, const char* last, point<T>& p) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::from_chars_result from_chars(const char* first, const char* last, size<T>& s) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::from_chars_result from_chars(const char* first, const char* last, rect<T>& r) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::from_chars_result from_chars(const char* first, const char* last, quad<T>& q) NANO_NOEXCEPT;
+
+template <typename T>
+inline std::from_chars_result from_chars(const char* first, const char* last, transform<T>& t) NANO_NOEXCEPT;
+
+/// Result of the bulk conversions, `count` is the number of values converted.
+struct bulk_to_chars_result {
+  char* ptr;
+  std::errc ec;
+  std::size_t count;
+};
+
+struct bulk_from_chars_result {
+  const char* ptr;
+  std::errc ec;
+  std::size_t count;
+};
+
+/// Writes `count` values, each one followed by `separator`, in a single pass.
+///
+/// On std::errc::value_too_large, `ptr` is the end of the last value that fit with its
+/// separator and `count` the number of those values.
+template <typename V>
+inline bulk_to_chars_result to_chars(
+    char* first, char* last, const V* values, std::size_t count, char separator = '\n') NANO_NOEXCEPT;
+
+/// Parses up to `capacity` values separated by white spaces or commas, in a single pass.
+///
+/// Stops at `last`, at the first error (`ptr` is then the start of the value that could
+/// not be parsed) or when `capacity` values were parsed and more input remains, which
+/// gives std::errc::value_too_large.
+template <typename V>
+inline bulk_from_chars_result from_chars(
+    const char* first, const char* last, V* values, std::size_t capacity) NANO_NOEXCEPT;
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+namespace detail {
+  NANO_NODC_INLINE_CXPR bool is_text_space(char c) NANO_NOEXCEPT {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  NANO_NODC_INLINE const char* skip_text_spaces(const char* first, const char* last) NANO_NOEXCEPT {
+    while (first != last && is_text_space(*first)) {
+      first++;
+    }
+
+    return first;
+  }
+
+  /// Shortest round trip through snprintf, trying the precisions up to max_digits10.
+  template <typename T>
+  inline std::to_chars_result scalar_to_chars(char* first, char* last, T v) NANO_NOEXCEPT {
+#if NANO_GEOMETRY_HAS_FLOAT_CHARCONV
+    return std::to_chars(first, last, v);
+#else
+    if constexpr (std::is_integral_v<T>) {
+      return std::to_chars(first, last, v);
+    }
+    else {
+      char buffer[64];
+      int n = 0;
+
+      for (int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10;
+           precision++) {
+        n = std::snprintf(buffer, sizeof(buffer), "%.*g", precision, static_cast<double>(v));
+        if (static_cast<T>(std::strtod(buffer, nullptr)) == v) {
+          break;
+        }
+      }
+
+      if (n < 0 || static_cast<std::size_t>(n) > static_cast<std::size_t>(last - first)) {
+        return { last, std::errc::value_too_large };
+      }
+
+      std::memcpy(first, buffer, static_cast<std::size_t>(n));
+      return { first + n, std::errc() };
+    }
+#endif
+  }
+
+  template <typename T>
+  inline std::from_chars_result scalar_from_chars(const char* first, const char* last, T& v) NANO_NOEXCEPT {
+#if NANO_GEOMETRY_HAS_FLOAT_CHARCONV
+    return std::from_chars(first, last, v);
+#else
+    if constexpr (std::is_integral_v<T>) {
+      return std::from_chars(first, last, v);
+    }
+    else {
+      // strtod needs a null terminated copy, and must not accept the leading spaces, '+' and
+      // hexadecimal floats that std::from_chars rejects.
+      char buffer[64];
+      std::size_t n = 0;
+      while (first + n != last && n + 1 < sizeof(buffer) && !is_text_space(first[n]) && first[n] != ','
+             && first[n] != '}') {
+        buffer[n] = first[n];
+        n++;
+      }
+
+      buffer[n] = 0;
+      if (n == 0 || buffer[0] == '+' || std::strpbrk(buffer, "xX") || is_text_space(buffer[0])) {
+        return { first, std::errc::invalid_argument };
+      }
+
+      char* end = nullptr;
+      errno = 0;
+      const T value = std::is_same_v<T, float> ? static_cast<T>(std::strtof(buffer, &end))
+                                               : static_cast<T>(std::strtod(buffer, &end));
+
+      if (end == buffer) {
+        return { first, std::errc::invalid_argument };
+      }
+
+      // Subnormal results also set ERANGE, only overflows and underflows to zero are out of range.
+      if (errno == ERANGE && (value == 0 || std::isinf(value))) {
+        return { first + (end - buffer), std::errc::result_out_of_range };
+      }
+
+      v = value;
+      return { first + (end - buffer), std::errc() };
+    }
+#endif
+  }
+
+  /// Writes {v0,v1,...}.
+  template <typename T, std::size_t N>
+  inline std::to_chars_result tuple_to_chars(char* first, char* last, const T (&values)[N]) NANO_NOEXCEPT {
+    for (std::size_t i = 0; i < N; i++) {
+      if (first == last) {
+        return { last, std::errc::value_too_large };
+      }
+
+      *first++ = i == 0 ? '{' : ',';
+
+      const std::to_chars_result res = scalar_to_chars(first, last, values[i]);
+      if (res.ec != std::errc()) {
+        return res;
+      }
+
+      first = res.ptr;
+    }
+
+    if (first == last) {
+      return { last, std::errc::value_too_large };
+    }
+
+    *first++ = '}';
+    return { first, std::errc() };
+  }
+
+  /// Reads {v0,v1,...}, `values` is only modified on success.
+  template <typename T, std::size_t N>
+  inline std::from_chars_result tuple_from_chars(const char* first, const char* last, T (&values)[N]) NANO_NOEXCEPT {
+    T parsed[N];
+    const char* p = skip_text_spaces(first, last);
+
+    for (std::size_t i = 0; i < N; i++) {
+      if (p == last || *p != (i == 0 ? '{' : ',')) {
+        return { p, std::errc::invalid_argument };
+      }
+
+      p = skip_text_spaces(p + 1, last);
+
+      const std::from_chars_result res = scalar_from_chars(p, last, parsed[i]);
+      if (res.ec != std::errc()) {
+        return res;
+      }
+
+      p = skip_text_spaces(res.ptr, last);
+    }
+
+    if (p == last || *p != '}') {
+      return { p, std::errc::invalid_argument };
+    }
+
+    for (std::size_t i = 0; i < N; i++) {
+      values[i] = parsed[i];
+    }
+
+    return { p + 1, std::errc() };
+  }
+} // namespace detail.
+
+//
+// MARK: - to_chars -
+//
+
+template <typename T>
+std::to_chars_result to_chars(char* first, char* last, const range<T>& r) NANO_NOEXCEPT {
+  const T values[2] = { r.start, r.end };
+  return detail::tuple_to_chars(first, last, values);
+}
+
+template <typename T>
+std::to_chars_result to_chars(char* first, char* last, const padding<T>& p) NANO_NOEXCEPT {
+  const T values[4] = { p.top, p.left, p.bottom, p.right };
+  return detail::tuple_to_chars(first, last, values);
+}
+
+template <typename T>
+std::to_chars_result to_chars(char* first, char* last, const point<T>& p) NANO_NOEXCEPT {
+  const T values[2] = { p.x, p.y };
+  return detail::tuple_to_chars(first, last, values);
+}
+
+template <typename T>
+std::to_chars_result to_chars(char* first, char* last, const size<T>& s) NANO_NOEXCEPT {
+  const T values[2] = { s.width, s.height };
+  return detail::tuple_to_chars(first, last, values);
+}
+
+template <typename T>
+std::to_chars_result to_chars(char* first, char* last, const rect<T>& r) NANO_NOEXCEPT {
+  const T values[4] = { r.x, r.y, r.width, r.height };
+  return detail::tuple_to_chars(first, last, values);
+}
+
+template <typename T>
+std::to_chars_result to_chars(char* first, char* last, const quad<T>& q) NANO_NOEXCEPT {
+  const point<T> corners[4] = { q.top_left, q.top_right, q.bottom_right, q.bottom_left };
+
+  for (std::size_t i = 0; i < 4; i++) {
+    if (first == last) {
+      return { last, std::errc::value_too_large };
+    }
+
+    *first++ = i == 0 ? '{' : ',';
+
+    const std::to_chars_result res = to_chars(first, last, corners[i]);
+    if (res.ec != std::errc()) {
+      return res;
+    }
+
+    first = res.ptr;
+  }
+
+  if (first == last) {
+    return { last, std::errc::value_too_large };
+  }
+
+  *first++ = '}';
+  return { first, std::errc() };
+}
+
+template <typename T>
+std::to_chars_result to_chars(char* first, char* last, const transform<T>& t) NANO_NOEXCEPT {
+  const T values[6] = { t.a, t.b, t.c, t.d, t.tx, t.ty };
+  return detail::tuple_to_chars(first, last, values);
+}
+
+//
+// MARK: - from_chars -
+//
+
+template <typename T>
+std::from_chars_result from_chars(const char* first, const char* last, range<T>& r) NANO_NOEXCEPT {
+  T values[2];
+  const std::from_chars_result res = detail::tuple_from_chars(first, last, values);
+  if (res.ec == std::errc()) {
+    r = { values[0], values[1] };
+  }
+
+  return res;
+}
+
+template <typename T>
+std::from_chars_result from_chars(const char* first, const char* last, padding<T>& p) NANO_NOEXCEPT {
+  T values[4];
+  const std::from_chars_result res = detail::tuple_from_chars(first, last, values);
+  if (res.ec == std::errc()) {
+    p = { values[0], values[1], values[2], values[3] };
+  }
+
+  return res;
+}
+
+template <typename T>
+std::from_chars_result from_chars(const char* first, const char* last, point<T>& p) NANO_NOEXCEPT {
+  T values[2];
+  const std::from_chars_result res = detail::tuple_from_chars(first, last, values);
+  if (res.ec == std::errc()) {
+    p = { values[0], values[1] };
+  }
+
+  return res;
+}
+
+template <typename T>
+std::from_chars_result from_chars(const char* first, const char* last, size<T>& s) NANO_NOEXCEPT {
+  T values[2];
+  const std::from_chars_result res = detail::tuple_from_chars(first, last, values);
+  if (res.ec == std::errc()) {
+    s = { values[0], values[1] };
+  }
+
+  return res;
+}
+
+template <typename T>
+std::from_chars_result from_chars(const char* first, const char* last, rect<T>& r) NANO_NOEXCEPT {
+  T values[4];
+  const std::from_chars_result res = detail::tuple_from_chars(first, last, values);
+  if (res.ec == std::errc()) {
+    r = { values[0], values[1], values[2], values[3] };
+  }
+
+  return res;
+}
+
+template <typename T>
+std::from_chars_result from_chars(const char* first, const char* last, quad<T>& q) NANO_NOEXCEPT {
+  point<T> corners[4];
+  const char* p = detail::skip_text_spaces(first, last);
+
+  for (std::size_t i = 0; i < 4; i++) {
+    if (p == last || *p != (i == 0 ? '{' : ',')) {
+      return { p, std::errc::invalid_argument };
+    }
+
+    const std::from_chars_result res = from_chars(p + 1, last, corners[i]);
+    if (res.ec != std::errc()) {
+      return res;
+    }
+
+    p = detail::skip_text_spaces(res.ptr, last);
+  }
+
+  if (p == last || *p != '}') {
+    return { p, std::errc::invalid_argument };
+  }
+
+  q = { corners[0], corners[1], corners[2], corners[3] };
+  return { p + 1, std::errc() };
+}
+
+template <typename T>
+std::from_chars_result from_chars(const char* first, const char* last, transform<T>& t) NANO_NOEXCEPT {
+  T values[6];
+  const std::from_chars_result res = detail::tuple_from_chars(first, last, values);
+  if (res.ec == std::errc()) {
+    t = { values[0], values[1], values[2], values[3], values[4], values[5] };
+  }
+
+  return res;
+}
+
+//
+// MARK: - bulk -
+//
+
+template <typename V>
+bulk_to_chars_result to_chars(
+    char* first, char* last, const V* values, std::size_t count, char separator) NANO_NOEXCEPT {
+  for (std::size_t i = 0; i < count; i++) {
+    const std::to_chars_result res = to_chars(first, last, values[i]);
+    if (res.ec != std::errc() || res.ptr == last) {
+      return { first, std::errc::value_too_large, i };
+    }
+
+    *res.ptr = separator;
+    first = res.ptr + 1;
+  }
+
+  return { first, std::errc(), count };
+}
+
+template <typename V>
+bulk_from_chars_result from_chars(
+    const char* first, const char* last, V* values, std::size_t capacity) NANO_NOEXCEPT {
+  std::size_t count = 0;
+
+  for (;;) {
+    while (first != last && (detail::is_text_space(*first) || *first == ',')) {
+      first++;
+    }
+
+    if (first == last) {
+      return { first, std::errc(), count };
+    }
+
+    if (count == capacity) {
+      return { first, std::errc::value_too_large, count };
+    }
+
+    const std::from_chars_result res = from_chars(first, last, values[count]);
+    if (res.ec != std::errc()) {
+      return { first, res.ec, count };
+    }
+
+    first = res.ptr;
+    count++;
+  }
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,364 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/display_list.h
+ * @brief     nano display list with per-op bounds and culled replay
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/rect_index.h>
+#include <nano/geometry/trace.h>
+#include <nano/geometry/transform_cull.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Recorded sequence of draw ops of type `Op`, each one with the transform and clip it
+/// was recorded with and its device-space bounds.
+///
+/// The bounds of an op are the bounding rect of its local bounds through the current
+/// transform, intersected with the current clip. They are computed once when the op is
+/// recorded, so replaying a region only tests rects. The ops, their bounds and their
+/// state ids are stored in separate contiguous arrays, the (transform, clip) states are
+/// stored once for all the ops recorded between two state changes.
+///
+/// A rect_index over the bounds is built on the first culled replay after a change.
+/// Building the index is not thread safe, call build_index() before sharing a display
+/// list between threads that only replay or query it. Replays can be nested in `fct`.
+template <typename T, typename Op>
+class display_list {
+public:
+  using value_type = T;
+  using op_type = Op;
+  using rect_type = nano::rect<value_type>;
+  using transform_type = nano::transform<value_type>;
+  using index_type = nano::rect_index<value_type>;
+  using id_type = std::uint32_t;
+
+  /// Transform and clip in effect when an op was recorded.
+  struct state {
+    transform_type transform;
+
+    /// Device-space clip, only meaningful when `clipped` is true.
+    rect_type clip;
+    bool clipped;
+  };
+
+  inline display_list() NANO_NOEXCEPT;
+
+  /// Removes all ops and resets the state to the identity transform without clip.
+  inline void clear() NANO_NOEXCEPT;
+
+  /// Pushes the current transform and clip.
+  inline void save();
+
+  /// Pops the transform and clip pushed by the last save(), does nothing without save().
+  inline void restore() NANO_NOEXCEPT;
+
+  /// Replaces the current transform.
+  inline void set_transform(const transform_type& t) NANO_NOEXCEPT;
+
+  /// Intersects the current clip with the bounds of `r` through the current transform.
+  inline void clip(const rect_type& r) NANO_NOEXCEPT;
+
+  /// Records `op` whose bounds before transform are `local_bounds` and returns its id.
+  /// Ids are consecutive from zero in recording order.
+  inline id_type record(const Op& op, const rect_type& local_bounds);
+
+  NANO_NODC_INLINE const state& current_state() const NANO_NOEXCEPT;
+
+  /// Returns the number of recorded ops.
+  NANO_NODC_INLINE std::size_t size() const NANO_NOEXCEPT;
+
+  /// Returns true if no op was recorded.
+  NANO_NODC_INLINE bool empty() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE const Op& op(id_type id) const NANO_NOEXCEPT;
+
+  /// Returns the device-space bounds of an op, an empty rect when it is entirely clipped.
+  NANO_NODC_INLINE const rect_type& op_bounds(id_type id) const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE const state& op_state(id_type id) const NANO_NOEXCEPT;
+
+  /// Returns the union of the bounds of the ops that are not entirely clipped.
+  NANO_NODC_INLINE rect_type bounds() const NANO_NOEXCEPT;
+
+  /// Calls `fct(op, state)` for every op that is not entirely clipped, in recording order.
+  template <typename Fct>
+  inline void replay(Fct&& fct) const;
+
+  /// Calls `fct(op, state)` in recording order for every op whose bounds intersect
+  /// `region` (rect::intersects), using the index.
+  template <typename Fct>
+  inline void replay(const rect_type& region, Fct&& fct) const;
+
+  /// Appends the ids of the ops whose bounds intersect `region` to `ids`, in recording order.
+  inline void query(const rect_type& region, std::vector<id_type>& ids) const;
+
+  /// Builds the index if ops were recorded since the last build.
+  inline void build_index() const;
+
+private:
+  std::vector<Op> _ops;
+  std::vector<rect_type> _bounds;
+  std::vector<id_type> _op_states;
+  std::vector<state> _states;
+  std::vector<state> _stack;
+  state _current;
+  rect_type _union;
+  bool _has_union;
+
+  /// True when `_current` was changed since it was last appended to `_states`.
+  bool _state_changed;
+
+  // Index over the ops with non empty bounds, `_index_ids` maps its ids to op ids.
+  mutable index_type _index;
+  mutable std::vector<id_type> _index_ids;
+  mutable bool _index_valid;
+};
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+template <typename T, typename Op>
+display_list<T, Op>::display_list() NANO_NOEXCEPT
+    : _current{ transform_type::identity(), { 0, 0, 0, 0 }, false }
+    , _union{ 0, 0, 0, 0 }
+    , _has_union(false)
+    , _state_changed(true)
+    , _index_valid(false) {}
+
+template <typename T, typename Op>
+void display_list<T, Op>::clear() NANO_NOEXCEPT {
+  _ops.clear();
+  _bounds.clear();
+  _op_states.clear();
+  _states.clear();
+  _stack.clear();
+  _current = { transform_type::identity(), { 0, 0, 0, 0 }, false };
+  _union = { 0, 0, 0, 0 };
+  _has_union = false;
+  _state_changed = true;
+  _index.clear();
+  _index_ids.clear();
+  _index_valid = false;
+}
+
+template <typename T, typename Op>
+void display_list<T, Op>::save() {
+  _stack.push_back(_current);
+}
+
+template <typename T, typename Op>
+void display_list<T, Op>::restore() NANO_NOEXCEPT {
+  if (_stack.empty()) {
+    return;
+  }
+
+  _current = _stack.back();
+  _stack.pop_back();
+  _state_changed = true;
+}
+
+template <typename T, typename Op>
+void display_list<T, Op>::set_transform(const transform_type& t) NANO_NOEXCEPT {
+  _current.transform = t;
+  _state_changed = true;
+}
+
+template <typename T, typename Op>
+void display_list<T, Op>::clip(const rect_type& r) NANO_NOEXCEPT {
+  const rect_type device = detail::transformed_bounds(_current.transform, r);
+  _current.clip = _current.clipped ? _current.clip.intersection(device) : device;
+  _current.clipped = true;
+  _state_changed = true;
+}
+
+template <typename T, typename Op>
+typename display_list<T, Op>::id_type display_list<T, Op>::record(const Op& op, const rect_type& local_bounds) {
+  if (_state_changed) {
+    _states.push_back(_current);
+    _state_changed = false;
+  }
+
+  rect_type b = detail::transformed_bounds(_current.transform, local_bounds);
+  if (_current.clipped) {
+    b = b.intersection(_current.clip);
+  }
+
+  if (b.size.width > 0 && b.size.height > 0) {
+    _union = _has_union ? _union.merged(b) : b;
+    _has_union = true;
+  }
+  else {
+    b = { 0, 0, 0, 0 };
+  }
+
+  const id_type id = static_cast<id_type>(_ops.size());
+  _ops.push_back(op);
+  _bounds.push_back(b);
+  _op_states.push_back(static_cast<id_type>(_states.size() - 1));
+  _index_valid = false;
+  return id;
+}
+
+template <typename T, typename Op>
+const typename display_list<T, Op>::state& display_list<T, Op>::current_state() const NANO_NOEXCEPT {
+  return _current;
+}
+
+template <typename T, typename Op>
+std::size_t display_list<T, Op>::size() const NANO_NOEXCEPT {
+  return _ops.size();
+}
+
+template <typename T, typename Op>
+bool display_list<T, Op>::empty() const NANO_NOEXCEPT {
+  return _ops.empty();
+}
+
+template <typename T, typename Op>
+const Op& display_list<T, Op>::op(id_type id) const NANO_NOEXCEPT {
+  return _ops[id];
+}
+
+template <typename T, typename Op>
+const typename display_list<T, Op>::rect_type& display_list<T, Op>::op_bounds(id_type id) const NANO_NOEXCEPT {
+  return _bounds[id];
+}
+
+template <typename T, typename Op>
+const typename display_list<T, Op>::state& display_list<T, Op>::op_state(id_type id) const NANO_NOEXCEPT {
+  return _states[_op_states[id]];
+}
+
+template <typename T, typename Op>
+typename display_list<T, Op>::rect_type display_list<T, Op>::bounds() const NANO_NOEXCEPT {
+  return _union;
+}
+
+template <typename T, typename Op>
+template <typename Fct>
+void display_list<T, Op>::replay(Fct&& fct) const {
+  for (std::size_t i = 0; i < _ops.size(); i++) {
+    if (_bounds[i].size.width > 0 && _bounds[i].size.height > 0) {
+      fct(_ops[i], _states[_op_states[i]]);
+    }
+  }
+}
+
+template <typename T, typename Op>
+template <typename Fct>
+void display_list<T, Op>::replay(const rect_type& region, Fct&& fct) const {
+  std::vector<id_type> visible;
+  query(region, visible);
+
+  for (id_type id : visible) {
+    fct(_ops[id], _states[_op_states[id]]);
+  }
+}
+
+template <typename T, typename Op>
+void display_list<T, Op>::query(const rect_type& region, std::vector<id_type>& ids) const {
+  // A linear scan is cheaper than building an index over a single leaf.
+  if (_ops.size() <= index_type::node_size) {
+    for (std::size_t i = 0; i < _ops.size(); i++) {
+      if (_bounds[i].intersects(region)) {
+        ids.push_back(static_cast<id_type>(i));
+      }
+    }
+
+    return;
+  }
+
+  build_index();
+
+  const std::size_t first = ids.size();
+  _index.query(region, [&](id_type id, const rect_type&) { ids.push_back(_index_ids[id]); });
+
+  // The index returns the ops in Hilbert order. Large results are put back in recording
+  // order through a local bitmap of the ops, which is cheaper than sorting them.
+  const std::size_t hits = ids.size() - first;
+  const std::size_t words = (_ops.size() + 63) / 64;
+  if (hits < 64 || hits * 16 < words) {
+    std::sort(ids.begin() + static_cast<std::ptrdiff_t>(first), ids.end());
+    return;
+  }
+
+  std::vector<std::uint64_t> marks(words, 0);
+  for (std::size_t i = first; i < ids.size(); i++) {
+    marks[ids[i] / 64] |= std::uint64_t(1) << (ids[i] % 64);
+  }
+
+  ids.resize(first);
+
+  for (std::size_t w = 0; w < words; w++) {
+    for (std::uint64_t bits = marks[w], b = 0; bits; b++, bits >>= 1) {
+      if (bits & 1) {
+        ids.push_back(static_cast<id_type>(w * 64 + b));
+      }
+    }
+  }
+}
+
+template <typename T, typename Op>
+void display_list<T, Op>::build_index() const {
+  if (_index_valid) {
+    return;
+  }
+
+  NANO_GEOMETRY_TRACE_SCOPE("display_list_index", _ops.size(), _ops.size() * sizeof(rect_type));
+
+  std::vector<rect_type> rects;
+  rects.reserve(_bounds.size());
+  _index_ids.clear();
+
+  for (std::size_t i = 0; i < _bounds.size(); i++) {
+    if (_bounds[i].size.width > 0 && _bounds[i].size.height > 0) {
+      rects.push_back(_bounds[i]);
+      _index_ids.push_back(static_cast<id_type>(i));
+    }
+  }
+
+  _index.build(rects.data(), rects.size());
+  _index_valid = true;
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
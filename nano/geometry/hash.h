@@ -0,0 +1,97 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/hash.h
+ * @brief     nano std::hash for point, size and rect
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <cstddef>
+#include <functional>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Equality on the exact coordinates of points, sizes and rects (+0 and -0 are equal), to
+/// use with the std::hash specializations of this file in unordered containers:
+///
+///   std::unordered_set<nano::point<float>, std::hash<nano::point<float>>, nano::exact_equal>
+///
+/// The operator== of floating point points, sizes and rects compares within the tolerance
+/// of nano::fcompare, values it finds equal can hash differently.
+struct exact_equal {
+  template <typename T>
+  NANO_NODC_INLINE_CXPR bool operator()(const nano::point<T>& a, const nano::point<T>& b) const NANO_NOEXCEPT {
+    return a.x == b.x && a.y == b.y;
+  }
+
+  template <typename T>
+  NANO_NODC_INLINE_CXPR bool operator()(const nano::size<T>& a, const nano::size<T>& b) const NANO_NOEXCEPT {
+    return a.width == b.width && a.height == b.height;
+  }
+
+  template <typename T>
+  NANO_NODC_INLINE_CXPR bool operator()(const nano::rect<T>& a, const nano::rect<T>& b) const NANO_NOEXCEPT {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+  }
+};
+
+namespace detail {
+  /// Hash of a coordinate, with -0 and +0 hashing the same.
+  template <typename T>
+  NANO_NODC_INLINE std::size_t hash_value(T v) NANO_NOEXCEPT {
+    return std::hash<T>{}(v == T(0) ? T(0) : v);
+  }
+
+  NANO_NODC_INLINE std::size_t hash_combine(std::size_t seed, std::size_t h) NANO_NOEXCEPT {
+    return seed ^ (h + static_cast<std::size_t>(0x9e3779b97f4a7c15ULL) + (seed << 6) + (seed >> 2));
+  }
+} // namespace detail.
+} // namespace nano.
+
+namespace std {
+/// The hashes use the exact coordinates, pair them with nano::exact_equal.
+template <typename T>
+struct hash<::nano::point<T>> {
+  NANO_NODC_INLINE std::size_t operator()(const ::nano::point<T>& p) const NANO_NOEXCEPT {
+    return ::nano::detail::hash_combine(::nano::detail::hash_value(p.x), ::nano::detail::hash_value(p.y));
+  }
+};
+
+template <typename T>
+struct hash<::nano::size<T>> {
+  NANO_NODC_INLINE std::size_t operator()(const ::nano::size<T>& s) const NANO_NOEXCEPT {
+    return ::nano::detail::hash_combine(::nano::detail::hash_value(s.width), ::nano::detail::hash_value(s.height));
+  }
+};
+
+template <typename T>
+struct hash<::nano::rect<T>> {
+  NANO_NODC_INLINE std::size_t operator()(const ::nano::rect<T>& r) const NANO_NOEXCEPT {
+    std::size_t h = ::nano::detail::hash_combine(::nano::detail::hash_value(r.x), ::nano::detail::hash_value(r.y));
+    h = ::nano::detail::hash_combine(h, ::nano::detail::hash_value(r.width));
+    return ::nano::detail::hash_combine(h, ::nano::detail::hash_value(r.height));
+  }
+};
+} // namespace std.
+
+NANO_CLANG_DIAGNOSTIC_POP()
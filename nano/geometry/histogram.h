@@ -0,0 +1,363 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/histogram.h
+ * @brief     nano 2d histogram
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/trace.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Density binning of point streams into a grid of `columns` x `rows` bins covering a rect.
+///
+/// Bins are half-open: a point on the right or bottom edge of the bounds is outside. Points
+/// can be added over several calls (e.g. one per chunk of a stream), bins() returns the
+/// accumulated result.
+///
+/// Each thread accumulates into a private copy of the grid, without atomics, and the
+/// copies are merged when bins() is called. The memory is thus `thread_count` grids.
+/// The bin indices of a chunk of points are computed by a branch-free loop before being
+/// scattered, points outside the bounds go to a spare bin that is never read. The indices
+/// are 32 bits: a grid of more than `max_bins` bins is empty, like one without columns or
+/// rows.
+template <typename T, typename Weight = float>
+class point_histogram {
+public:
+  static_assert(std::is_floating_point_v<T>, "nano::point_histogram requires a floating point type");
+
+  using value_type = T;
+  using weight_type = Weight;
+  using point_type = nano::point<value_type>;
+  using rect_type = nano::rect<value_type>;
+
+  /// Minimum number of points given to a thread, smaller inputs use fewer threads.
+  static constexpr std::size_t thread_grain = 16384;
+
+  /// Maximum number of bins, the spare bin takes the last 32 bits index.
+  static constexpr std::size_t max_bins = 0xFFFFFFFF;
+
+  /// `thread_count` 0 uses one thread per hardware thread.
+  inline point_histogram(const rect_type& bounds, std::size_t columns, std::size_t rows, std::size_t thread_count = 1);
+
+  NANO_NODC_INLINE const rect_type& bounds() const NANO_NOEXCEPT;
+
+  /// Number of columns and rows, zero for an empty grid.
+  NANO_NODC_INLINE std::size_t columns() const NANO_NOEXCEPT;
+  NANO_NODC_INLINE std::size_t rows() const NANO_NOEXCEPT;
+
+  /// Adds one to the bin of every point.
+  inline void add(const point_type* points, std::size_t count);
+
+  /// Adds `weights[i]` to the bin of `points[i]`.
+  inline void add(const point_type* points, const weight_type* weights, std::size_t count);
+
+  /// Spreads the weight of every point over the nearby bins with a gaussian of standard
+  /// deviation `sigma`, in bins. The kernel is cut at three sigmas and normalized so that
+  /// a point far from the edges adds exactly its weight. Points just outside the bounds
+  /// still contribute to the edge bins. `weights` can be null for a weight of one.
+  inline void splat(const point_type* points, const weight_type* weights, std::size_t count, value_type sigma);
+
+  /// Merges the thread grids and returns the `rows` x `columns` bins, row-major.
+  NANO_NODC_INLINE const weight_type* bins();
+
+  /// Sets all the bins to zero.
+  inline void clear();
+
+private:
+  rect_type _bounds;
+  std::size_t _columns;
+  std::size_t _rows;
+  std::size_t _stride;
+  std::size_t _thread_count;
+  value_type _scale_x;
+  value_type _scale_y;
+  bool _pending = false;
+
+  // `_thread_count` grids of `_stride` bins, the last bin of each is the spare bin of the
+  // points outside the bounds. The first grid holds the merged result.
+  std::vector<weight_type> _grids;
+
+  template <typename Fct>
+  inline void run(std::size_t count, Fct&& fct);
+
+  inline void bin(const point_type* points, const weight_type* weights, std::size_t count, weight_type* grid) const
+      NANO_NOEXCEPT;
+  inline void splat(const point_type* points, const weight_type* weights, std::size_t count, value_type sigma,
+      weight_type* grid, std::vector<weight_type>& kernel) const;
+};
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+  /// Number of points whose bins are computed before being scattered.
+  inline constexpr std::size_t histogram_chunk_size = 256;
+} // namespace detail.
+
+template <typename T, typename Weight>
+point_histogram<T, Weight>::point_histogram(
+    const rect_type& bounds, std::size_t columns, std::size_t rows, std::size_t thread_count)
+    : _bounds(bounds)
+    , _columns(columns)
+    , _rows(rows)
+    , _stride(1)
+    , _thread_count(thread_count ? thread_count : std::max(std::thread::hardware_concurrency(), 1u)) {
+  // Divided rather than multiplied, columns * rows can overflow.
+  const bool valid
+      = bounds.size.width > 0 && bounds.size.height > 0 && columns && rows && columns <= max_bins / rows;
+  _scale_x = valid ? static_cast<value_type>(columns) / bounds.size.width : value_type(0);
+  _scale_y = valid ? static_cast<value_type>(rows) / bounds.size.height : value_type(0);
+
+  // An empty grid only has its spare bin, every point ends there.
+  if (valid) {
+    _stride = columns * rows + 1;
+  }
+  else {
+    _columns = 0;
+    _rows = 0;
+  }
+
+  _grids.assign(_thread_count * _stride, weight_type(0));
+}
+
+template <typename T, typename Weight>
+const typename point_histogram<T, Weight>::rect_type& point_histogram<T, Weight>::bounds() const NANO_NOEXCEPT {
+  return _bounds;
+}
+
+template <typename T, typename Weight>
+std::size_t point_histogram<T, Weight>::columns() const NANO_NOEXCEPT {
+  return _columns;
+}
+
+template <typename T, typename Weight>
+std::size_t point_histogram<T, Weight>::rows() const NANO_NOEXCEPT {
+  return _rows;
+}
+
+template <typename T, typename Weight>
+template <typename Fct>
+void point_histogram<T, Weight>::run(std::size_t count, Fct&& fct) {
+  const std::size_t thread_count = std::max<std::size_t>(std::min(_thread_count, count / thread_grain), 1);
+  const std::size_t per_thread = (count + thread_count - 1) / thread_count;
+  _pending = _pending || thread_count > 1;
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < thread_count; i++) {
+    const std::size_t first = i * per_thread;
+    threads.emplace_back(fct, first, std::min(first + per_thread, count) - first, _grids.data() + i * _stride);
+  }
+
+  fct(std::size_t(0), std::min(per_thread, count), _grids.data());
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+template <typename T, typename Weight>
+void point_histogram<T, Weight>::bin(
+    const point_type* points, const weight_type* weights, std::size_t count, weight_type* grid) const NANO_NOEXCEPT {
+  const value_type left = _bounds.origin.x;
+  const value_type top = _bounds.origin.y;
+  const value_type columns = static_cast<value_type>(_columns);
+  const value_type rows = static_cast<value_type>(_rows);
+  const std::uint32_t spare = static_cast<std::uint32_t>(_stride - 1);
+
+  std::uint32_t indices[detail::histogram_chunk_size];
+
+  for (std::size_t first = 0; first < count; first += detail::histogram_chunk_size) {
+    const std::size_t n = std::min(detail::histogram_chunk_size, count - first);
+    const point_type* p = points + first;
+
+    // Branch-free: NaN and out of range coordinates fail the comparisons and the clamped
+    // values keep the conversions defined.
+    for (std::size_t i = 0; i < n; i++) {
+      const value_type x = (p[i].x - left) * _scale_x;
+      const value_type y = (p[i].y - top) * _scale_y;
+      const bool inside = (x >= 0) & (x < columns) & (y >= 0) & (y < rows);
+      const std::uint32_t ix = static_cast<std::uint32_t>(std::min(std::max(value_type(0), x), columns));
+      const std::uint32_t iy = static_cast<std::uint32_t>(std::min(std::max(value_type(0), y), rows));
+      indices[i] = inside ? iy * static_cast<std::uint32_t>(_columns) + ix : spare;
+    }
+
+    if (weights) {
+      const weight_type* w = weights + first;
+      for (std::size_t i = 0; i < n; i++) {
+        grid[indices[i]] += w[i];
+      }
+    }
+    else {
+      for (std::size_t i = 0; i < n; i++) {
+        grid[indices[i]] += weight_type(1);
+      }
+    }
+  }
+}
+
+template <typename T, typename Weight>
+void point_histogram<T, Weight>::splat(const point_type* points, const weight_type* weights, std::size_t count,
+    value_type sigma, weight_type* grid, std::vector<weight_type>& kernel) const {
+  const std::ptrdiff_t radius = static_cast<std::ptrdiff_t>(std::ceil(3 * sigma));
+  const std::size_t size = static_cast<std::size_t>(2 * radius + 1);
+  const std::ptrdiff_t columns = static_cast<std::ptrdiff_t>(_columns);
+  const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(_rows);
+  const double inv_two_sigma2 = 1.0 / (2.0 * static_cast<double>(sigma) * static_cast<double>(sigma));
+
+  // Separable kernel: the horizontal weights followed by the vertical ones.
+  kernel.resize(2 * size);
+  weight_type* kx = kernel.data();
+  weight_type* ky = kernel.data() + size;
+
+  // The samples are one bin apart, consecutive ones differ by a ratio that itself changes
+  // by a constant factor: two exponentials per axis instead of one per bin.
+  const double step = std::exp(-2.0 * inv_two_sigma2);
+
+  const auto fill = [&](weight_type* k, double center, std::ptrdiff_t first) {
+    const double d = static_cast<double>(first) + 0.5 - center;
+    double w = std::exp(-d * d * inv_two_sigma2);
+    double ratio = std::exp(-(2.0 * d + 1.0) * inv_two_sigma2);
+    double sum = 0;
+
+    for (std::size_t i = 0; i < size; i++) {
+      k[i] = static_cast<weight_type>(w);
+      sum += w;
+      w *= ratio;
+      ratio *= step;
+    }
+
+    const double norm = sum > 0 ? 1.0 / sum : 0.0;
+    for (std::size_t i = 0; i < size; i++) {
+      k[i] = static_cast<weight_type>(static_cast<double>(k[i]) * norm);
+    }
+  };
+
+  for (std::size_t i = 0; i < count; i++) {
+    const double x = static_cast<double>((points[i].x - _bounds.origin.x) * _scale_x);
+    const double y = static_cast<double>((points[i].y - _bounds.origin.y) * _scale_y);
+
+    // Also rejects NaN.
+    if (!(x > static_cast<double>(-radius - 1) && x < static_cast<double>(columns + radius + 1)
+            && y > static_cast<double>(-radius - 1) && y < static_cast<double>(rows + radius + 1))) {
+      continue;
+    }
+
+    const std::ptrdiff_t cx = static_cast<std::ptrdiff_t>(std::floor(x)) - radius;
+    const std::ptrdiff_t cy = static_cast<std::ptrdiff_t>(std::floor(y)) - radius;
+    fill(kx, x, cx);
+    fill(ky, y, cy);
+
+    const weight_type weight = weights ? weights[i] : weight_type(1);
+    const std::ptrdiff_t x0 = std::max<std::ptrdiff_t>(cx, 0);
+    const std::ptrdiff_t x1 = std::min<std::ptrdiff_t>(cx + static_cast<std::ptrdiff_t>(size), columns);
+    const std::ptrdiff_t y0 = std::max<std::ptrdiff_t>(cy, 0);
+    const std::ptrdiff_t y1 = std::min<std::ptrdiff_t>(cy + static_cast<std::ptrdiff_t>(size), rows);
+
+    for (std::ptrdiff_t row = y0; row < y1; row++) {
+      const weight_type wy = weight * ky[row - cy];
+      weight_type* line = grid + row * columns;
+
+      for (std::ptrdiff_t column = x0; column < x1; column++) {
+        line[column] += wy * kx[column - cx];
+      }
+    }
+  }
+}
+
+template <typename T, typename Weight>
+void point_histogram<T, Weight>::add(const point_type* points, std::size_t count) {
+  add(points, nullptr, count);
+}
+
+template <typename T, typename Weight>
+void point_histogram<T, Weight>::add(const point_type* points, const weight_type* weights, std::size_t count) {
+  NANO_GEOMETRY_TRACE_SCOPE("point_histogram::add", count, count * sizeof(point_type));
+  run(count, [&](std::size_t first, std::size_t n, weight_type* grid) {
+    bin(points + first, weights ? weights + first : nullptr, n, grid);
+  });
+}
+
+template <typename T, typename Weight>
+void point_histogram<T, Weight>::splat(
+    const point_type* points, const weight_type* weights, std::size_t count, value_type sigma) {
+  NANO_GEOMETRY_TRACE_SCOPE("point_histogram::splat", count, count * sizeof(point_type));
+  if (!(sigma > 0) || _stride == 1) {
+    add(points, weights, count);
+    return;
+  }
+
+  run(count, [&](std::size_t first, std::size_t n, weight_type* grid) {
+    std::vector<weight_type> kernel;
+    splat(points + first, weights ? weights + first : nullptr, n, sigma, grid, kernel);
+  });
+}
+
+template <typename T, typename Weight>
+const typename point_histogram<T, Weight>::weight_type* point_histogram<T, Weight>::bins() {
+  if (_pending) {
+    weight_type* result = _grids.data();
+
+    for (std::size_t t = 1; t < _thread_count; t++) {
+      weight_type* grid = _grids.data() + t * _stride;
+
+      for (std::size_t i = 0; i < _stride; i++) {
+        result[i] += grid[i];
+        grid[i] = weight_type(0);
+      }
+    }
+
+    _pending = false;
+  }
+
+  return _grids.data();
+}
+
+template <typename T, typename Weight>
+void point_histogram<T, Weight>::clear() {
+  std::fill(_grids.begin(), _grids.end(), weight_type(0));
+  _pending = false;
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,210 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/nine_patch.h
+ * @brief     nano nine-patch slicing and vertex emission
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/trace.h>
+#include <nano/geometry/vertex_emitter.h>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// An image stretched into `destination`: the corners keep their size, the edges stretch
+/// along one axis and the center along both.
+///
+/// `insets` are the border widths of the image, they are used for both `source` and
+/// `destination`. When the borders are larger than a rect, they are scaled down
+/// proportionally and the center collapses to nothing on that axis.
+template <typename T>
+struct nine_patch {
+  static_assert(std::is_floating_point<T>::value, "nano::nine_patch value_type must be floating point");
+
+  nano::rect<T> destination;
+  nano::rect<T> source;
+  nano::padding<T> insets;
+};
+
+/// Number of cells of a nine-patch, in row-major order from the top-left corner.
+inline constexpr std::size_t nine_patch_cells = 9;
+
+/// Writes the 9 destination and source rects of each patch, `nine_patch_cells` per patch.
+/// Cells of a collapsed center or of a zero inset are empty but still written.
+template <typename T>
+inline void slice_nine_patches(const nine_patch<T>* patches, std::size_t count, nano::rect<T>* destinations,
+    nano::rect<T>* sources) NANO_NOEXCEPT;
+
+/// Writes 4 interleaved vertices, in the order of emit_vertices(), for every cell with a non empty
+/// destination, with the texture coordinates of its source rect in an atlas of
+/// `atlas_size` pixels.
+///
+/// `opts.uvs` is ignored. `vertices` must hold `count * nine_patch_cells * vertices_per_quad`
+/// vertices. Returns the number of quads written, see emit_quad_indices().
+template <typename T>
+inline std::size_t emit_nine_patches(const nine_patch<T>* patches, std::size_t count, const nano::size<T>& atlas_size,
+    textured_vertex<T>* vertices, const vertex_emit_options<T>& opts = {}) NANO_NOEXCEPT;
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+namespace detail {
+  /// The 4 lines that cut [origin, origin + length] in 3, with the borders scaled down when
+  /// they do not fit. The max keeps the collapsed center from going negative by rounding.
+  template <typename T>
+  NANO_INLINE void nine_patch_edges(T origin, T length, T first, T second, T (&edges)[4]) NANO_NOEXCEPT {
+    const T border = first + second;
+    const T k = border > length ? length / border : T(1);
+    edges[0] = origin;
+    edges[1] = origin + first * k;
+    edges[2] = std::max(edges[1], origin + length - second * k);
+    edges[3] = origin + length;
+  }
+
+  template <typename T>
+  struct nine_patch_lines {
+    T x[4];
+    T y[4];
+
+    NANO_INLINE nine_patch_lines(const nano::rect<T>& r, const nano::padding<T>& p) NANO_NOEXCEPT {
+      nine_patch_edges(r.origin.x, r.size.width, p.left, p.right, x);
+      nine_patch_edges(r.origin.y, r.size.height, p.top, p.bottom, y);
+    }
+
+    NANO_NODC_INLINE nano::rect<T> cell(std::size_t row, std::size_t col) const NANO_NOEXCEPT {
+      return nano::rect<T>(x[col], y[row], x[col + 1] - x[col], y[row + 1] - y[row]);
+    }
+
+    NANO_INLINE void scale(T sx, T sy) NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < 4; i++) {
+        x[i] *= sx;
+        y[i] *= sy;
+      }
+    }
+  };
+
+  /// Writes the vertices straight from the 4 x 4 grid of lines: each grid point is
+  /// transformed once and shared by up to 4 cells.
+  template <bool Streaming, bool Transformed, typename T>
+  inline std::size_t emit_nine_patches(const nine_patch<T>* patches, std::size_t count,
+      const nano::size<T>& atlas_size, textured_vertex<T>* vertices, const vertex_emit_options<T>& opts) {
+    const nano::transform<T> t = Transformed ? *opts.transform : nano::transform<T>::identity();
+    const T sx = T(1) / atlas_size.width;
+    const T sy = T(1) / atlas_size.height;
+
+    std::size_t n_quads = 0;
+    for (std::size_t i = 0; i < count; i++) {
+      const nine_patch_lines<T> dst(patches[i].destination, patches[i].insets);
+      nine_patch_lines<T> src(patches[i].source, patches[i].insets);
+      src.scale(sx, sy);
+
+      nano::point<T> grid[4][4];
+      for (std::size_t row = 0; row < 4; row++) {
+        for (std::size_t col = 0; col < 4; col++) {
+          grid[row][col] = { dst.x[col], dst.y[row] };
+          if constexpr (Transformed) {
+            grid[row][col] = t.apply(grid[row][col]);
+          }
+        }
+      }
+
+      for (std::size_t row = 0; row < 3; row++) {
+        for (std::size_t col = 0; col < 3; col++) {
+          if (!(dst.x[col + 1] > dst.x[col] && dst.y[row + 1] > dst.y[row])) {
+            continue;
+          }
+
+          const std::size_t rows[4] = { row, row, row + 1, row + 1 };
+          const std::size_t cols[4] = { col, col + 1, col + 1, col };
+          textured_vertex<T>* v = vertices + n_quads * vertices_per_quad;
+
+          for (std::size_t k = 0; k < vertices_per_quad; k++) {
+            emit_store<Streaming>(&v[k].x, grid[rows[k]][cols[k]].x);
+            emit_store<Streaming>(&v[k].y, grid[rows[k]][cols[k]].y);
+            emit_store<Streaming>(&v[k].u, src.x[cols[k]]);
+            emit_store<Streaming>(&v[k].v, src.y[rows[k]]);
+          }
+
+          n_quads++;
+        }
+      }
+    }
+
+    return n_quads;
+  }
+
+  template <bool Streaming, typename T>
+  inline std::size_t emit_nine_patches(const nine_patch<T>* patches, std::size_t count,
+      const nano::size<T>& atlas_size, textured_vertex<T>* vertices, const vertex_emit_options<T>& opts) {
+    return opts.transform ? emit_nine_patches<Streaming, true>(patches, count, atlas_size, vertices, opts)
+                          : emit_nine_patches<Streaming, false>(patches, count, atlas_size, vertices, opts);
+  }
+} // namespace detail.
+
+template <typename T>
+void slice_nine_patches(const nine_patch<T>* patches, std::size_t count, nano::rect<T>* destinations,
+    nano::rect<T>* sources) NANO_NOEXCEPT {
+  for (std::size_t i = 0; i < count; i++) {
+    const detail::nine_patch_lines<T> dst(patches[i].destination, patches[i].insets);
+    const detail::nine_patch_lines<T> src(patches[i].source, patches[i].insets);
+
+    for (std::size_t row = 0; row < 3; row++) {
+      for (std::size_t col = 0; col < 3; col++) {
+        const std::size_t k = i * nine_patch_cells + row * 3 + col;
+        destinations[k] = dst.cell(row, col);
+        sources[k] = src.cell(row, col);
+      }
+    }
+  }
+}
+
+template <typename T>
+std::size_t emit_nine_patches(const nine_patch<T>* patches, std::size_t count, const nano::size<T>& atlas_size,
+    textured_vertex<T>* vertices, const vertex_emit_options<T>& opts) NANO_NOEXCEPT {
+  NANO_GEOMETRY_TRACE_SCOPE("emit_nine_patches", count, count * sizeof(nine_patch<T>));
+  if (opts.streaming) {
+    const std::size_t n_quads = detail::emit_nine_patches<true>(patches, count, atlas_size, vertices, opts);
+    detail::emit_fence();
+    return n_quads;
+  }
+
+  return detail::emit_nine_patches<false>(patches, count, atlas_size, vertices, opts);
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
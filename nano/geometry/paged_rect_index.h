@@ -0,0 +1,786 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/paged_rect_index.h
+ * @brief     nano disk-backed packed R-tree
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/rect_index.h>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+  #define NANO_GEOMETRY_HAS_PAGED_RECT_INDEX 1
+#else
+  #define NANO_GEOMETRY_HAS_PAGED_RECT_INDEX 0
+#endif
+
+#if NANO_GEOMETRY_HAS_PAGED_RECT_INDEX
+
+  #include <algorithm>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstdio>
+  #include <cstring>
+  #include <iterator>
+  #include <list>
+  #include <queue>
+  #include <string>
+  #include <unordered_map>
+  #include <vector>
+
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// File layout of a paged_rect_index.
+///
+/// The file is a sequence of fixed-size pages. Page 0 holds the header, the
+/// following pages are either leaf pages (rects and record ids sorted along a
+/// Hilbert curve) or node pages (child bounding boxes and page numbers). Every
+/// page starts with its entry count followed by entries of `entry_size` bytes.
+/// All values are stored in native byte order.
+namespace paged_format {
+  inline constexpr char magic[8] = { 'N', 'G', 'P', 'R', 'T', 'R', 'E', 'E' };
+  inline constexpr std::uint32_t version = 1;
+  inline constexpr std::size_t page_header_size = 8;
+  inline constexpr std::size_t entry_size = 40;
+  inline constexpr std::size_t min_page_size = page_header_size + 2 * entry_size;
+
+  struct header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t page_size;
+    std::uint64_t count;
+    std::uint64_t page_count;
+    std::uint64_t root_page;
+    std::uint32_t height;
+    std::uint32_t reserved;
+    double bounds[4];
+  };
+
+  /// Leaf entry.
+  struct record {
+    double x, y, width, height;
+    std::uint64_t id;
+  };
+
+  /// Node entry, the box is stored as left, top, right, bottom.
+  struct node {
+    double left, top, right, bottom;
+    std::uint64_t page;
+  };
+
+  static_assert(sizeof(record) == entry_size, "nano::paged_format::record must be entry_size bytes");
+  static_assert(sizeof(node) == entry_size, "nano::paged_format::node must be entry_size bytes");
+} // namespace paged_format.
+
+/// Builds a paged_rect_index file from a stream of rects that does not need to fit in memory.
+///
+/// Records are appended to a spill file as they are added. finish() then performs an
+/// external merge sort on their Hilbert value: runs of at most `memory_budget` bytes are
+/// sorted in memory and written to temporary files, which are merged into the leaf pages
+/// of the output. Upper levels are packed while the leaves are written, keeping a single
+/// page per level in memory.
+class paged_rect_index_builder {
+public:
+  struct options {
+    /// Size of a page in bytes.
+    std::size_t page_size = 4096;
+
+    /// Maximum amount of memory used to sort a run.
+    std::size_t memory_budget = 256 * 1024 * 1024;
+
+    /// Directory of the temporary files, defaults to the directory of the output file.
+    std::string temp_directory;
+  };
+
+  inline explicit paged_rect_index_builder(std::string path);
+  inline paged_rect_index_builder(std::string path, const options& opts);
+
+  paged_rect_index_builder(const paged_rect_index_builder&) = delete;
+  paged_rect_index_builder& operator=(const paged_rect_index_builder&) = delete;
+
+  inline ~paged_rect_index_builder();
+
+  /// Appends a record, returns false if the spill file could not be written or if
+  /// finish() was already called.
+  inline bool add(const nano::rect<double>& r, std::uint64_t id);
+
+  /// Sorts the records and writes the index file, returns false on I/O error. The
+  /// builder is done afterwards, add() and finish() then return false.
+  inline bool finish();
+
+  NANO_NODC_INLINE std::uint64_t size() const NANO_NOEXCEPT;
+
+private:
+  struct sort_record {
+    std::uint32_t key;
+    std::uint32_t run;
+    paged_format::record rec;
+  };
+
+  struct level_writer {
+    std::vector<unsigned char> page;
+    std::uint32_t count = 0;
+    detail::index_box<double> box = {};
+  };
+
+  std::string _path;
+  options _options;
+  std::FILE* _spill = nullptr;
+  std::uint64_t _count = 0;
+  detail::index_box<double> _bounds = {};
+  bool _failed = false;
+
+  // Output state.
+  std::FILE* _out = nullptr;
+  std::uint64_t _next_page = 1;
+  std::vector<level_writer> _levels;
+
+  NANO_NODC_INLINE std::size_t entries_per_page() const NANO_NOEXCEPT;
+  NANO_NODC_INLINE std::string temp_path(const char* name, std::size_t index) const;
+
+  inline bool write_page(const std::vector<unsigned char>& page, std::uint32_t count, std::uint64_t& page_no);
+  inline bool push_entry(std::size_t level, const void* entry, const detail::index_box<double>& box);
+  inline bool flush_level(std::size_t level);
+  inline bool write_sorted(std::vector<std::string>& runs);
+};
+
+/// Read-only packed R-tree stored in a file built by paged_rect_index_builder.
+///
+/// Pages are accessed through a read-only memory mapping by default. Without the
+/// mapping, pages are read with pread() into an LRU cache of `cache_pages` pages.
+/// When prefetching is enabled, the children of every visited node that intersect
+/// the query are announced to the kernel (madvise / posix_fadvise) before being
+/// visited.
+///
+/// Only the header is checked by open(). Page numbers and entry counts read from the
+/// pages are checked before use: invalid child pages and pages with too many entries
+/// are skipped by queries, so a corrupt file gives incomplete results but is never read
+/// out of bounds.
+///
+/// Queries are const but update the page cache and the traversal stack, a reader is
+/// therefore not meant to be shared between threads.
+class paged_rect_index {
+public:
+  using id_type = std::uint64_t;
+  using rect_type = nano::rect<double>;
+
+  struct options {
+    /// Maps the file in memory instead of reading pages through the cache.
+    bool use_mmap = true;
+
+    /// Number of pages kept in memory without mmap (at least one).
+    std::size_t cache_pages = 1024;
+
+    /// Announces the pages about to be visited to the kernel.
+    bool prefetch = true;
+  };
+
+  paged_rect_index() = default;
+
+  paged_rect_index(const paged_rect_index&) = delete;
+  paged_rect_index& operator=(const paged_rect_index&) = delete;
+
+  inline ~paged_rect_index();
+
+  /// Opens an index file, returns false if it can't be read or is not a valid index.
+  inline bool open(const std::string& path);
+  inline bool open(const std::string& path, const options& opts);
+
+  inline void close() NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE bool is_open() const NANO_NOEXCEPT;
+
+  /// Calls `fct(id, rect)` for every record intersecting `r` (see rect::intersects).
+  template <typename Fct>
+  inline void query(const rect_type& r, Fct&& fct) const;
+
+  /// Appends the id of every record intersecting `r` to `ids`.
+  inline void query(const rect_type& r, std::vector<id_type>& ids) const;
+
+  NANO_NODC_INLINE std::uint64_t size() const NANO_NOEXCEPT;
+  NANO_NODC_INLINE rect_type bounds() const NANO_NOEXCEPT;
+  NANO_NODC_INLINE std::size_t page_size() const NANO_NOEXCEPT;
+  NANO_NODC_INLINE std::uint64_t page_count() const NANO_NOEXCEPT;
+
+  /// Number of pages read from the file since it was opened (without mmap).
+  NANO_NODC_INLINE std::uint64_t page_reads() const NANO_NOEXCEPT;
+
+private:
+  using page_list = std::list<std::pair<std::uint64_t, std::vector<unsigned char>>>;
+
+  int _fd = -1;
+  const unsigned char* _map = nullptr;
+  std::size_t _map_size = 0;
+  paged_format::header _header = {};
+  options _options;
+
+  mutable page_list _lru;
+  mutable std::unordered_map<std::uint64_t, page_list::iterator> _cache;
+  mutable std::uint64_t _page_reads = 0;
+
+  struct pending_page {
+    std::uint64_t page;
+    std::uint32_t level;
+  };
+
+  /// Pages left to visit, shared by nested queries which only use the entries they push.
+  mutable std::vector<pending_page> _stack;
+
+  /// Matching records of the leaf being visited, shared the same way as `_stack`.
+  mutable std::vector<paged_format::record> _hits;
+
+  /// Returns null if `page_no` is not a page after the header.
+  inline const unsigned char* page(std::uint64_t page_no) const;
+  inline void prefetch(std::uint64_t first_page, std::uint64_t last_page) const NANO_NOEXCEPT;
+  NANO_NODC_INLINE std::uint32_t max_page_entries() const NANO_NOEXCEPT;
+};
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+//
+// MARK: - paged_rect_index_builder -
+//
+
+paged_rect_index_builder::paged_rect_index_builder(std::string path)
+    : paged_rect_index_builder(std::move(path), options()) {}
+
+paged_rect_index_builder::paged_rect_index_builder(std::string path, const options& opts)
+    : _path(std::move(path)),
+      _options(opts) {
+  _options.page_size = std::max(_options.page_size, paged_format::min_page_size);
+  _options.memory_budget = std::max<std::size_t>(_options.memory_budget, sizeof(sort_record) * 2);
+
+  if (_options.temp_directory.empty()) {
+    const std::size_t slash = _path.find_last_of('/');
+    _options.temp_directory = slash == std::string::npos ? "." : _path.substr(0, slash);
+  }
+
+  _spill = std::fopen(temp_path("spill", 0).c_str(), "w+b");
+  _failed = _spill == nullptr;
+}
+
+paged_rect_index_builder::~paged_rect_index_builder() {
+  if (_spill) {
+    std::fclose(_spill);
+    std::remove(temp_path("spill", 0).c_str());
+  }
+
+  if (_out) {
+    std::fclose(_out);
+  }
+}
+
+bool paged_rect_index_builder::add(const nano::rect<double>& r, std::uint64_t id) {
+  // The spill file is closed by finish().
+  if (_failed || !_spill) {
+    return false;
+  }
+
+  const paged_format::record rec = { r.origin.x, r.origin.y, r.size.width, r.size.height, id };
+  const detail::index_box<double> box = detail::to_index_box(r);
+  _bounds = _count == 0 ? box : detail::merge_index_box(_bounds, box);
+  _count++;
+
+  _failed = std::fwrite(&rec, sizeof(rec), 1, _spill) != 1;
+  return !_failed;
+}
+
+std::uint64_t paged_rect_index_builder::size() const NANO_NOEXCEPT {
+  return _count;
+}
+
+std::size_t paged_rect_index_builder::entries_per_page() const NANO_NOEXCEPT {
+  return (_options.page_size - paged_format::page_header_size) / paged_format::entry_size;
+}
+
+std::string paged_rect_index_builder::temp_path(const char* name, std::size_t index) const {
+  const std::size_t slash = _path.find_last_of('/');
+  const std::string file = slash == std::string::npos ? _path : _path.substr(slash + 1);
+  return _options.temp_directory + "/" + file + "." + name + std::to_string(index);
+}
+
+bool paged_rect_index_builder::finish() {
+  if (_failed || !_spill || std::fflush(_spill) != 0 || std::fseek(_spill, 0, SEEK_SET) != 0) {
+    return false;
+  }
+
+  // Sort runs that fit in the memory budget.
+  const std::size_t run_capacity = _options.memory_budget / sizeof(sort_record);
+  std::vector<std::string> runs;
+  std::vector<sort_record> buffer;
+  std::uint64_t remaining = _count;
+
+  while (remaining > 0) {
+    const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, run_capacity));
+    buffer.resize(n);
+    remaining -= n;
+
+    for (std::size_t i = 0; i < n; i++) {
+      paged_format::record& rec = buffer[i].rec;
+      if (std::fread(&rec, sizeof(rec), 1, _spill) != 1) {
+        return false;
+      }
+
+      buffer[i].key = detail::hilbert_index(nano::rect<double>(rec.x, rec.y, rec.width, rec.height), _bounds);
+      buffer[i].run = static_cast<std::uint32_t>(runs.size());
+    }
+
+    std::stable_sort(
+        buffer.begin(), buffer.end(), [](const sort_record& a, const sort_record& b) { return a.key < b.key; });
+
+    runs.push_back(temp_path("run", runs.size()));
+    std::FILE* run = std::fopen(runs.back().c_str(), "wb");
+    const bool ok = run && std::fwrite(buffer.data(), sizeof(sort_record), n, run) == n;
+
+    if (run) {
+      std::fclose(run);
+    }
+
+    if (!ok) {
+      return false;
+    }
+  }
+
+  buffer = std::vector<sort_record>();
+  std::fclose(_spill);
+  std::remove(temp_path("spill", 0).c_str());
+  _spill = nullptr;
+
+  const bool ok = write_sorted(runs);
+
+  for (const std::string& run : runs) {
+    std::remove(run.c_str());
+  }
+
+  return ok;
+}
+
+bool paged_rect_index_builder::write_sorted(std::vector<std::string>& runs) {
+  _out = std::fopen(_path.c_str(), "wb");
+  if (!_out) {
+    return false;
+  }
+
+  std::vector<unsigned char> empty_page(_options.page_size, 0);
+  if (std::fwrite(empty_page.data(), 1, empty_page.size(), _out) != empty_page.size()) {
+    return false;
+  }
+
+  _next_page = 1;
+  _levels.assign(1, level_writer());
+
+  // K-way merge of the sorted runs, each one read through a small buffer.
+  constexpr std::size_t run_buffer_size = 1024;
+
+  struct run_reader {
+    std::FILE* file = nullptr;
+    std::vector<sort_record> buffer;
+    std::size_t pos = 0;
+  };
+
+  std::vector<run_reader> readers(runs.size());
+  auto refill = [&](run_reader& reader) {
+    reader.buffer.resize(run_buffer_size);
+    reader.buffer.resize(std::fread(reader.buffer.data(), sizeof(sort_record), run_buffer_size, reader.file));
+    reader.pos = 0;
+    return !reader.buffer.empty();
+  };
+
+  auto greater = [](const sort_record& a, const sort_record& b) {
+    return a.key != b.key ? a.key > b.key : a.run > b.run;
+  };
+
+  std::priority_queue<sort_record, std::vector<sort_record>, decltype(greater)> heap(greater);
+  bool ok = true;
+
+  for (std::size_t i = 0; i < runs.size() && ok; i++) {
+    readers[i].file = std::fopen(runs[i].c_str(), "rb");
+    ok = readers[i].file && refill(readers[i]);
+
+    if (ok) {
+      heap.push(readers[i].buffer[readers[i].pos++]);
+    }
+  }
+
+  while (ok && !heap.empty()) {
+    const sort_record top = heap.top();
+    heap.pop();
+
+    const paged_format::record& rec = top.rec;
+    ok = push_entry(0, &rec, detail::to_index_box(nano::rect<double>(rec.x, rec.y, rec.width, rec.height)));
+
+    run_reader& reader = readers[top.run];
+    if (reader.pos < reader.buffer.size() || refill(reader)) {
+      heap.push(reader.buffer[reader.pos++]);
+    }
+  }
+
+  for (run_reader& reader : readers) {
+    if (reader.file) {
+      std::fclose(reader.file);
+    }
+  }
+
+  // Flush the partial pages from the bottom up until a single root remains.
+  std::uint64_t root_page = 0;
+  std::uint32_t height = 0;
+
+  for (std::size_t level = 0; ok && level < _levels.size(); level++) {
+    const bool is_root = level + 1 == _levels.size() && _levels[level].count > 0;
+
+    if (is_root) {
+      ok = write_page(_levels[level].page, _levels[level].count, root_page);
+      height = static_cast<std::uint32_t>(level + 1);
+      break;
+    }
+
+    ok = flush_level(level);
+  }
+
+  paged_format::header header = {};
+  std::memcpy(header.magic, paged_format::magic, sizeof(header.magic));
+  header.version = paged_format::version;
+  header.page_size = static_cast<std::uint32_t>(_options.page_size);
+  header.count = _count;
+  header.page_count = _next_page;
+  header.root_page = root_page;
+  header.height = height;
+  header.bounds[0] = _bounds.left;
+  header.bounds[1] = _bounds.top;
+  header.bounds[2] = _bounds.right;
+  header.bounds[3] = _bounds.bottom;
+
+  ok = ok && std::fseek(_out, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, _out) == 1;
+  ok = std::fclose(_out) == 0 && ok;
+  _out = nullptr;
+  return ok;
+}
+
+bool paged_rect_index_builder::write_page(
+    const std::vector<unsigned char>& page, std::uint32_t count, std::uint64_t& page_no) {
+  std::vector<unsigned char> data(_options.page_size, 0);
+  std::memcpy(data.data(), &count, sizeof(count));
+  std::memcpy(data.data() + paged_format::page_header_size, page.data(),
+      std::min(page.size(), data.size() - paged_format::page_header_size));
+
+  page_no = _next_page++;
+  return ::fseeko(_out, static_cast<off_t>(page_no * _options.page_size), SEEK_SET) == 0
+      && std::fwrite(data.data(), 1, data.size(), _out) == data.size();
+}
+
+bool paged_rect_index_builder::push_entry(std::size_t level, const void* entry, const detail::index_box<double>& box) {
+  level_writer& writer = _levels[level];
+  writer.box = writer.count == 0 ? box : detail::merge_index_box(writer.box, box);
+  writer.page.insert(writer.page.end(), static_cast<const unsigned char*>(entry),
+      static_cast<const unsigned char*>(entry) + paged_format::entry_size);
+  writer.count++;
+
+  return writer.count < entries_per_page() || flush_level(level);
+}
+
+bool paged_rect_index_builder::flush_level(std::size_t level) {
+  if (_levels[level].count == 0) {
+    return true;
+  }
+
+  std::uint64_t page_no = 0;
+  if (!write_page(_levels[level].page, _levels[level].count, page_no)) {
+    return false;
+  }
+
+  const detail::index_box<double> box = _levels[level].box;
+  _levels[level].page.clear();
+  _levels[level].count = 0;
+
+  if (level + 1 == _levels.size()) {
+    _levels.emplace_back();
+  }
+
+  const paged_format::node entry = { box.left, box.top, box.right, box.bottom, page_no };
+  return push_entry(level + 1, &entry, box);
+}
+
+//
+// MARK: - paged_rect_index -
+//
+
+paged_rect_index::~paged_rect_index() {
+  close();
+}
+
+bool paged_rect_index::open(const std::string& path) {
+  return open(path, options());
+}
+
+bool paged_rect_index::open(const std::string& path, const options& opts) {
+  // Deeper than any tree of 2^64 records with 2 entries per page.
+  constexpr std::uint32_t max_height = 64;
+
+  close();
+  _options = opts;
+  _fd = ::open(path.c_str(), O_RDONLY);
+
+  if (_fd < 0) {
+    return false;
+  }
+
+  struct stat st = {};
+  const bool valid = ::fstat(_fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(_header))
+      && ::pread(_fd, &_header, sizeof(_header), 0) == static_cast<ssize_t>(sizeof(_header))
+      && std::memcmp(_header.magic, paged_format::magic, sizeof(_header.magic)) == 0
+      && _header.version == paged_format::version && _header.page_size >= paged_format::min_page_size
+      && _header.page_count <= static_cast<std::uint64_t>(st.st_size) / _header.page_size
+      && (_header.count == 0
+          || (_header.root_page > 0 && _header.root_page < _header.page_count && _header.height > 0
+              && _header.height <= max_height));
+
+  if (!valid) {
+    close();
+    return false;
+  }
+
+  if (_options.use_mmap) {
+    _map_size = static_cast<std::size_t>(st.st_size);
+    void* map = ::mmap(nullptr, _map_size, PROT_READ, MAP_SHARED, _fd, 0);
+
+    if (map == MAP_FAILED) {
+      close();
+      return false;
+    }
+
+    _map = static_cast<const unsigned char*>(map);
+    ::madvise(map, _map_size, MADV_RANDOM);
+  }
+
+  return true;
+}
+
+void paged_rect_index::close() NANO_NOEXCEPT {
+  if (_map) {
+    ::munmap(const_cast<unsigned char*>(_map), _map_size);
+    _map = nullptr;
+    _map_size = 0;
+  }
+
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+
+  _header = {};
+  _lru.clear();
+  _cache.clear();
+  _page_reads = 0;
+  _stack.clear();
+  _hits.clear();
+}
+
+bool paged_rect_index::is_open() const NANO_NOEXCEPT {
+  return _fd >= 0;
+}
+
+std::uint64_t paged_rect_index::size() const NANO_NOEXCEPT {
+  return _header.count;
+}
+
+paged_rect_index::rect_type paged_rect_index::bounds() const NANO_NOEXCEPT {
+  return rect_type::create_from_point(
+      { _header.bounds[0], _header.bounds[1] }, { _header.bounds[2], _header.bounds[3] });
+}
+
+std::size_t paged_rect_index::page_size() const NANO_NOEXCEPT {
+  return _header.page_size;
+}
+
+std::uint64_t paged_rect_index::page_count() const NANO_NOEXCEPT {
+  return _header.page_count;
+}
+
+std::uint64_t paged_rect_index::page_reads() const NANO_NOEXCEPT {
+  return _page_reads;
+}
+
+std::uint32_t paged_rect_index::max_page_entries() const NANO_NOEXCEPT {
+  return static_cast<std::uint32_t>((_header.page_size - paged_format::page_header_size) / paged_format::entry_size);
+}
+
+const unsigned char* paged_rect_index::page(std::uint64_t page_no) const {
+  if (page_no == 0 || page_no >= _header.page_count) {
+    return nullptr;
+  }
+
+  const std::size_t offset = static_cast<std::size_t>(page_no * _header.page_size);
+
+  if (_map) {
+    return _map + offset;
+  }
+
+  auto it = _cache.find(page_no);
+  if (it != _cache.end()) {
+    _lru.splice(_lru.begin(), _lru, it->second);
+    return it->second->second.data();
+  }
+
+  // Once the cache is full, the least recently used entry and its buffer are reused.
+  if (_cache.size() >= std::max<std::size_t>(_options.cache_pages, 1)) {
+    _cache.erase(_lru.back().first);
+    _lru.splice(_lru.begin(), _lru, std::prev(_lru.end()));
+    _lru.front().first = page_no;
+  }
+  else {
+    _lru.emplace_front(page_no, std::vector<unsigned char>(_header.page_size));
+  }
+
+  std::vector<unsigned char>& data = _lru.front().second;
+  _page_reads++;
+
+  if (::pread(_fd, data.data(), data.size(), static_cast<off_t>(offset)) != static_cast<ssize_t>(data.size())) {
+    std::fill(data.begin(), data.end(), static_cast<unsigned char>(0));
+  }
+
+  _cache[page_no] = _lru.begin();
+  return data.data();
+}
+
+void paged_rect_index::prefetch(std::uint64_t first_page, std::uint64_t last_page) const NANO_NOEXCEPT {
+  const std::size_t offset = static_cast<std::size_t>(first_page * _header.page_size);
+  const std::size_t length = static_cast<std::size_t>((last_page - first_page + 1) * _header.page_size);
+
+  if (_map) {
+    const std::size_t page_mask = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) - 1;
+    const std::size_t start = offset & ~page_mask;
+    ::madvise(const_cast<unsigned char*>(_map) + start, offset + length - start, MADV_WILLNEED);
+  }
+  else {
+  #if defined(POSIX_FADV_WILLNEED)
+    ::posix_fadvise(_fd, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+  #endif
+  }
+}
+
+template <typename Fct>
+void paged_rect_index::query(const rect_type& r, Fct&& fct) const {
+  if (!is_open() || _header.count == 0) {
+    return;
+  }
+
+  const detail::index_box<double> rbox = detail::to_index_box(r);
+  const std::uint32_t max_entries = max_page_entries();
+
+  // Depth first with an explicit stack. A nested query from `fct` pushes and pops above
+  // `base`. The children and the matching records are copied out of the page before
+  // descending or calling `fct`, since the page buffer may be recycled by the cache.
+  const std::size_t base = _stack.size();
+  _stack.push_back({ _header.root_page, _header.height - 1 });
+
+  while (_stack.size() > base) {
+    const pending_page current = _stack.back();
+    _stack.pop_back();
+
+    const unsigned char* data = page(current.page);
+    if (!data) {
+      continue;
+    }
+
+    std::uint32_t count = 0;
+    std::memcpy(&count, data, sizeof(count));
+    data += paged_format::page_header_size;
+
+    if (count > max_entries) {
+      continue;
+    }
+
+    if (current.level == 0) {
+      const std::size_t first_hit = _hits.size();
+      for (std::uint32_t i = 0; i < count; i++) {
+        paged_format::record rec;
+        std::memcpy(&rec, data + i * paged_format::entry_size, sizeof(rec));
+
+        if (detail::index_box_intersects(detail::to_index_box(rect_type(rec.x, rec.y, rec.width, rec.height)), rbox)) {
+          _hits.push_back(rec);
+        }
+      }
+
+      // Indexed and copied, a nested query can grow `_hits`.
+      for (std::size_t i = first_hit; i < _hits.size(); i++) {
+        const paged_format::record rec = _hits[i];
+        fct(rec.id, rect_type(rec.x, rec.y, rec.width, rec.height));
+      }
+
+      _hits.resize(first_hit);
+      continue;
+    }
+
+    const std::size_t first_child = _stack.size();
+    for (std::uint32_t i = 0; i < count; i++) {
+      paged_format::node entry;
+      std::memcpy(&entry, data + i * paged_format::entry_size, sizeof(entry));
+
+      if (detail::index_box_intersects({ entry.left, entry.top, entry.right, entry.bottom }, rbox)) {
+        _stack.push_back({ entry.page, current.level - 1 });
+      }
+    }
+
+    // Visit the children in page order.
+    std::reverse(_stack.begin() + static_cast<std::ptrdiff_t>(first_child), _stack.end());
+
+    // Children are mostly written contiguously, announce them with a single hint
+    // when they span a reasonable range of pages.
+    if (_options.prefetch && _stack.size() - first_child > 1) {
+      const auto [first, last] = std::minmax_element(_stack.begin() + static_cast<std::ptrdiff_t>(first_child),
+          _stack.end(), [](const pending_page& a, const pending_page& b) { return a.page < b.page; });
+
+      if (last->page - first->page < 2 * static_cast<std::uint64_t>(count) && last->page < _header.page_count) {
+        prefetch(first->page, last->page);
+      }
+    }
+  }
+}
+
+inline void paged_rect_index::query(const rect_type& r, std::vector<id_type>& ids) const {
+  query(r, [&](id_type id, const rect_type&) { ids.push_back(id); });
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
+
+#endif // NANO_GEOMETRY_HAS_PAGED_RECT_INDEX
@@ -0,0 +1,595 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/persistent_rect_tree.h
+ * @brief     nano persistent R-tree with structural sharing
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/rect_index.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Dynamic R-tree whose versions share their unchanged nodes.
+///
+/// Copying a tree is O(1): the copy shares the root of the original. Every edit
+/// copies the nodes along the path it modifies (when they are shared with another
+/// version) and leaves the rest of the tree untouched, so each insert, remove or
+/// update allocates O(log n) nodes. Nodes are reference counted and are given back
+/// to an arena shared by all the versions derived from the same tree as soon as no
+/// version refers to them anymore.
+///
+/// Reference counts are not atomic, all the versions of a tree must be used from
+/// the same thread.
+template <typename T>
+class persistent_rect_tree {
+public:
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using box_type = detail::index_box<value_type>;
+  using id_type = std::uint32_t;
+
+  /// Maximum number of entries per node.
+  static constexpr std::size_t max_entries = 8;
+
+  inline persistent_rect_tree();
+  inline persistent_rect_tree(const persistent_rect_tree& tree) NANO_NOEXCEPT;
+  inline persistent_rect_tree(persistent_rect_tree&& tree) NANO_NOEXCEPT;
+
+  inline ~persistent_rect_tree();
+
+  inline persistent_rect_tree& operator=(const persistent_rect_tree& tree) NANO_NOEXCEPT;
+  inline persistent_rect_tree& operator=(persistent_rect_tree&& tree) NANO_NOEXCEPT;
+
+  /// Returns a version sharing all the nodes of this one, same as copying the tree.
+  NANO_NODC_INLINE persistent_rect_tree snapshot() const NANO_NOEXCEPT;
+
+  /// Adds an item.
+  inline void insert(const rect_type& r, id_type id);
+
+  /// Removes the item `id` previously inserted with `r` and returns false if it was not found.
+  inline bool remove(const rect_type& r, id_type id);
+
+  /// Moves the item `id` from `old_rect` to `new_rect` and returns false if it was not found.
+  inline bool update(const rect_type& old_rect, const rect_type& new_rect, id_type id);
+
+  /// Removes all the items of this version.
+  inline void clear() NANO_NOEXCEPT;
+
+  /// Calls `fct(id, rect)` for every item intersecting `r` (see rect::intersects).
+  template <typename Fct>
+  inline void query(const rect_type& r, Fct&& fct) const;
+
+  /// Appends the id of every item intersecting `r` to `ids`.
+  inline void query(const rect_type& r, std::vector<id_type>& ids) const;
+
+  /// Returns the number of items in this version.
+  NANO_NODC_INLINE std::size_t size() const NANO_NOEXCEPT;
+
+  /// Returns true if this version contains no items.
+  NANO_NODC_INLINE bool empty() const NANO_NOEXCEPT;
+
+  /// Returns true if both versions share the same root.
+  NANO_NODC_INLINE bool shares_root(const persistent_rect_tree& tree) const NANO_NOEXCEPT;
+
+  /// Returns the number of nodes currently alive in the arena shared by all related versions.
+  NANO_NODC_INLINE std::size_t allocated_nodes() const NANO_NOEXCEPT;
+
+private:
+  struct node {
+    std::uint32_t refs;
+    std::uint32_t count;
+    bool leaf;
+
+    // One extra slot to hold an overflowing entry until the node is split.
+    std::array<box_type, max_entries + 1> boxes;
+    std::array<node*, max_entries + 1> children;
+    std::array<rect_type, max_entries + 1> rects;
+    std::array<id_type, max_entries + 1> ids;
+  };
+
+  /// Fixed-size node allocator, nodes are carved from blocks and recycled through a free list.
+  class node_pool {
+  public:
+    static constexpr std::size_t block_size = 256;
+
+    inline node* allocate(bool leaf);
+    inline void deallocate(node* n) NANO_NOEXCEPT;
+
+    NANO_NODC_INLINE std::size_t alive() const NANO_NOEXCEPT;
+
+  private:
+    std::vector<std::unique_ptr<node[]>> _blocks;
+    std::vector<node*> _free;
+    std::size_t _block_used = block_size;
+    std::size_t _alive = 0;
+  };
+
+  std::shared_ptr<node_pool> _pool;
+  node* _root = nullptr;
+  std::size_t _size = 0;
+
+  static inline box_type node_box(const node* n) NANO_NOEXCEPT;
+
+  static inline node* acquire(node* n) NANO_NOEXCEPT;
+  inline void release(node* n) NANO_NOEXCEPT;
+
+  /// Makes sure `slot` is not shared with another version, cloning it if needed.
+  inline node* own(node*& slot);
+
+  inline node* insert_entry(node* n, const box_type& box, const rect_type& r, id_type id);
+  inline node* split(node* n);
+
+  static inline bool find_path(
+      const node* n, const box_type& box, id_type id, std::vector<std::uint32_t>& path) NANO_NOEXCEPT;
+
+  static inline void erase_entry(node* n, std::size_t index) NANO_NOEXCEPT;
+
+  template <typename Fct>
+  static inline void query_node(const node* n, const box_type& rbox, Fct& fct);
+};
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+//
+// MARK: - node_pool -
+//
+
+template <typename T>
+typename persistent_rect_tree<T>::node* persistent_rect_tree<T>::node_pool::allocate(bool leaf) {
+  node* n = nullptr;
+
+  if (!_free.empty()) {
+    n = _free.back();
+    _free.pop_back();
+  }
+  else {
+    if (_block_used == block_size) {
+      _blocks.emplace_back(new node[block_size]);
+      _block_used = 0;
+    }
+
+    n = &_blocks.back()[_block_used++];
+  }
+
+  n->refs = 1;
+  n->count = 0;
+  n->leaf = leaf;
+  _alive++;
+  return n;
+}
+
+template <typename T>
+void persistent_rect_tree<T>::node_pool::deallocate(node* n) NANO_NOEXCEPT {
+  _free.push_back(n);
+  _alive--;
+}
+
+template <typename T>
+std::size_t persistent_rect_tree<T>::node_pool::alive() const NANO_NOEXCEPT {
+  return _alive;
+}
+
+//
+// MARK: - persistent_rect_tree -
+//
+
+template <typename T>
+persistent_rect_tree<T>::persistent_rect_tree()
+    : _pool(std::make_shared<node_pool>()) {}
+
+template <typename T>
+persistent_rect_tree<T>::persistent_rect_tree(const persistent_rect_tree& tree) NANO_NOEXCEPT
+    : _pool(tree._pool),
+      _root(tree._root ? acquire(tree._root) : nullptr),
+      _size(tree._size) {}
+
+template <typename T>
+persistent_rect_tree<T>::persistent_rect_tree(persistent_rect_tree&& tree) NANO_NOEXCEPT
+    : _pool(tree._pool),
+      _root(tree._root),
+      _size(tree._size) {
+  tree._root = nullptr;
+  tree._size = 0;
+}
+
+template <typename T>
+persistent_rect_tree<T>::~persistent_rect_tree() {
+  clear();
+}
+
+template <typename T>
+persistent_rect_tree<T>& persistent_rect_tree<T>::operator=(const persistent_rect_tree& tree) NANO_NOEXCEPT {
+  if (this != &tree) {
+    node* root = tree._root ? acquire(tree._root) : nullptr;
+    clear();
+    _pool = tree._pool;
+    _root = root;
+    _size = tree._size;
+  }
+
+  return *this;
+}
+
+template <typename T>
+persistent_rect_tree<T>& persistent_rect_tree<T>::operator=(persistent_rect_tree&& tree) NANO_NOEXCEPT {
+  if (this != &tree) {
+    clear();
+    _pool = tree._pool;
+    _root = tree._root;
+    _size = tree._size;
+    tree._root = nullptr;
+    tree._size = 0;
+  }
+
+  return *this;
+}
+
+template <typename T>
+persistent_rect_tree<T> persistent_rect_tree<T>::snapshot() const NANO_NOEXCEPT {
+  return *this;
+}
+
+template <typename T>
+void persistent_rect_tree<T>::insert(const rect_type& r, id_type id) {
+  if (!_root) {
+    _root = _pool->allocate(true);
+  }
+
+  const box_type box = detail::to_index_box(r);
+
+  if (node* sibling = insert_entry(own(_root), box, r, id)) {
+    node* root = _pool->allocate(false);
+    root->boxes[0] = node_box(_root);
+    root->children[0] = _root;
+    root->boxes[1] = node_box(sibling);
+    root->children[1] = sibling;
+    root->count = 2;
+    _root = root;
+  }
+
+  _size++;
+}
+
+template <typename T>
+bool persistent_rect_tree<T>::remove(const rect_type& r, id_type id) {
+  std::vector<std::uint32_t> path;
+
+  if (!_root || !find_path(_root, detail::to_index_box(r), id, path)) {
+    return false;
+  }
+
+  // Unshare the nodes along the path.
+  std::vector<node*> nodes(path.size());
+  nodes[0] = own(_root);
+  for (std::size_t i = 1; i < path.size(); i++) {
+    nodes[i] = own(nodes[i - 1]->children[path[i - 1]]);
+  }
+
+  erase_entry(nodes.back(), path.back());
+
+  // Refresh the boxes bottom-up, dropping the nodes left empty.
+  for (std::size_t i = path.size() - 1; i > 0; i--) {
+    node* parent = nodes[i - 1];
+    node* child = nodes[i];
+
+    if (child->count == 0) {
+      release(child);
+      erase_entry(parent, path[i - 1]);
+    }
+    else {
+      parent->boxes[path[i - 1]] = node_box(child);
+    }
+  }
+
+  if (_root->count == 0) {
+    release(_root);
+    _root = nullptr;
+  }
+  else if (!_root->leaf && _root->count == 1) {
+    node* root = acquire(_root->children[0]);
+    release(_root);
+    _root = root;
+  }
+
+  _size--;
+  return true;
+}
+
+template <typename T>
+bool persistent_rect_tree<T>::update(const rect_type& old_rect, const rect_type& new_rect, id_type id) {
+  if (!remove(old_rect, id)) {
+    return false;
+  }
+
+  insert(new_rect, id);
+  return true;
+}
+
+template <typename T>
+void persistent_rect_tree<T>::clear() NANO_NOEXCEPT {
+  if (_root) {
+    release(_root);
+    _root = nullptr;
+  }
+
+  _size = 0;
+}
+
+template <typename T>
+template <typename Fct>
+void persistent_rect_tree<T>::query(const rect_type& r, Fct&& fct) const {
+  if (_root) {
+    const box_type rbox = detail::to_index_box(r);
+    query_node(_root, rbox, fct);
+  }
+}
+
+template <typename T>
+void persistent_rect_tree<T>::query(const rect_type& r, std::vector<id_type>& ids) const {
+  query(r, [&](id_type id, const rect_type&) { ids.push_back(id); });
+}
+
+template <typename T>
+std::size_t persistent_rect_tree<T>::size() const NANO_NOEXCEPT {
+  return _size;
+}
+
+template <typename T>
+bool persistent_rect_tree<T>::empty() const NANO_NOEXCEPT {
+  return _size == 0;
+}
+
+template <typename T>
+bool persistent_rect_tree<T>::shares_root(const persistent_rect_tree& tree) const NANO_NOEXCEPT {
+  return _root == tree._root;
+}
+
+template <typename T>
+std::size_t persistent_rect_tree<T>::allocated_nodes() const NANO_NOEXCEPT {
+  return _pool ? _pool->alive() : 0;
+}
+
+template <typename T>
+typename persistent_rect_tree<T>::box_type persistent_rect_tree<T>::node_box(const node* n) NANO_NOEXCEPT {
+  box_type box = n->boxes[0];
+  for (std::size_t i = 1; i < n->count; i++) {
+    box = detail::merge_index_box(box, n->boxes[i]);
+  }
+
+  return box;
+}
+
+template <typename T>
+typename persistent_rect_tree<T>::node* persistent_rect_tree<T>::acquire(node* n) NANO_NOEXCEPT {
+  n->refs++;
+  return n;
+}
+
+template <typename T>
+void persistent_rect_tree<T>::release(node* n) NANO_NOEXCEPT {
+  if (--n->refs > 0) {
+    return;
+  }
+
+  if (!n->leaf) {
+    for (std::size_t i = 0; i < n->count; i++) {
+      release(n->children[i]);
+    }
+  }
+
+  _pool->deallocate(n);
+}
+
+template <typename T>
+typename persistent_rect_tree<T>::node* persistent_rect_tree<T>::own(node*& slot) {
+  if (slot->refs == 1) {
+    return slot;
+  }
+
+  node* n = _pool->allocate(slot->leaf);
+  n->count = slot->count;
+  n->boxes = slot->boxes;
+
+  if (n->leaf) {
+    n->rects = slot->rects;
+    n->ids = slot->ids;
+  }
+  else {
+    for (std::size_t i = 0; i < n->count; i++) {
+      n->children[i] = acquire(slot->children[i]);
+    }
+  }
+
+  // The previous node is still referenced by another version.
+  slot->refs--;
+  slot = n;
+  return n;
+}
+
+template <typename T>
+typename persistent_rect_tree<T>::node* persistent_rect_tree<T>::insert_entry(
+    node* n, const box_type& box, const rect_type& r, id_type id) {
+  if (n->leaf) {
+    n->boxes[n->count] = box;
+    n->rects[n->count] = r;
+    n->ids[n->count] = id;
+    n->count++;
+  }
+  else {
+    // Choose the child needing the least enlargement, then the smallest one.
+    std::size_t best = 0;
+    double best_growth = 0;
+    double best_area = 0;
+
+    for (std::size_t i = 0; i < n->count; i++) {
+      const box_type& b = n->boxes[i];
+      const box_type m = detail::merge_index_box(b, box);
+      const double area = static_cast<double>(b.right - b.left) * static_cast<double>(b.bottom - b.top);
+      const double growth = static_cast<double>(m.right - m.left) * static_cast<double>(m.bottom - m.top) - area;
+
+      if (i == 0 || growth < best_growth || (growth == best_growth && area < best_area)) {
+        best = i;
+        best_growth = growth;
+        best_area = area;
+      }
+    }
+
+    node* child = own(n->children[best]);
+    node* sibling = insert_entry(child, box, r, id);
+    n->boxes[best] = node_box(child);
+
+    if (sibling) {
+      n->boxes[n->count] = node_box(sibling);
+      n->children[n->count] = sibling;
+      n->count++;
+    }
+  }
+
+  return n->count > max_entries ? split(n) : nullptr;
+}
+
+template <typename T>
+typename persistent_rect_tree<T>::node* persistent_rect_tree<T>::split(node* n) {
+  // Sort the entries along the axis where their centers are the most spread out and cut in the middle.
+  const std::size_t count = n->count;
+  std::array<double, max_entries + 1> cx;
+  std::array<double, max_entries + 1> cy;
+
+  for (std::size_t i = 0; i < count; i++) {
+    cx[i] = static_cast<double>(n->boxes[i].left) + static_cast<double>(n->boxes[i].right);
+    cy[i] = static_cast<double>(n->boxes[i].top) + static_cast<double>(n->boxes[i].bottom);
+  }
+
+  const auto [min_x, max_x] = std::minmax_element(cx.begin(), cx.begin() + static_cast<std::ptrdiff_t>(count));
+  const auto [min_y, max_y] = std::minmax_element(cy.begin(), cy.begin() + static_cast<std::ptrdiff_t>(count));
+  const std::array<double, max_entries + 1>& centers = (*max_x - *min_x) >= (*max_y - *min_y) ? cx : cy;
+
+  std::array<std::size_t, max_entries + 1> order;
+  for (std::size_t i = 0; i < count; i++) {
+    order[i] = i;
+  }
+
+  std::sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(count),
+      [&](std::size_t a, std::size_t b) { return centers[a] < centers[b]; });
+
+  const node src = *n;
+  node* sibling = _pool->allocate(n->leaf);
+  const std::size_t half = count / 2;
+  n->count = 0;
+
+  for (std::size_t i = 0; i < count; i++) {
+    node* dst = i < half ? n : sibling;
+    const std::size_t k = order[i];
+    dst->boxes[dst->count] = src.boxes[k];
+
+    if (src.leaf) {
+      dst->rects[dst->count] = src.rects[k];
+      dst->ids[dst->count] = src.ids[k];
+    }
+    else {
+      dst->children[dst->count] = src.children[k];
+    }
+
+    dst->count++;
+  }
+
+  return sibling;
+}
+
+template <typename T>
+bool persistent_rect_tree<T>::find_path(
+    const node* n, const box_type& box, id_type id, std::vector<std::uint32_t>& path) NANO_NOEXCEPT {
+  for (std::uint32_t i = 0; i < n->count; i++) {
+    const box_type& b = n->boxes[i];
+
+    if (b.left > box.left || b.top > box.top || b.right < box.right || b.bottom < box.bottom) {
+      continue;
+    }
+
+    path.push_back(i);
+
+    if (n->leaf ? n->ids[i] == id : find_path(n->children[i], box, id, path)) {
+      return true;
+    }
+
+    path.pop_back();
+  }
+
+  return false;
+}
+
+template <typename T>
+void persistent_rect_tree<T>::erase_entry(node* n, std::size_t index) NANO_NOEXCEPT {
+  const std::size_t last = n->count - 1;
+  n->boxes[index] = n->boxes[last];
+
+  if (n->leaf) {
+    n->rects[index] = n->rects[last];
+    n->ids[index] = n->ids[last];
+  }
+  else {
+    n->children[index] = n->children[last];
+  }
+
+  n->count--;
+}
+
+template <typename T>
+template <typename Fct>
+void persistent_rect_tree<T>::query_node(const node* n, const box_type& rbox, Fct& fct) {
+  for (std::size_t i = 0; i < n->count; i++) {
+    if (!detail::index_box_intersects(n->boxes[i], rbox)) {
+      continue;
+    }
+
+    if (n->leaf) {
+      fct(n->ids[i], n->rects[i]);
+    }
+    else {
+      query_node(n->children[i], rbox, fct);
+    }
+  }
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,354 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/polygon.h
+ * @brief     nano polygon over a point buffer
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Non-owning polygon over a contiguous buffer of points.
+///
+/// The buffer holds one or more rings, the outer one first, followed by the holes.
+/// `hole_offsets[i]` is the position of the first point of hole `i` in the buffer,
+/// offsets are increasing. Rings are implicitly closed: the last point connects to the
+/// first one and must not repeat it. Orientation is free, the outer ring and the holes
+/// may have any winding.
+///
+/// The view keeps pointers to the points and offsets, which must outlive it.
+template <typename T>
+class polygon_view {
+public:
+  using value_type = T;
+  using point_type = nano::point<value_type>;
+  using rect_type = nano::rect<value_type>;
+
+  polygon_view() = default;
+
+  NANO_INLINE_CXPR polygon_view(const point_type* points, std::size_t size) NANO_NOEXCEPT;
+
+  NANO_INLINE_CXPR polygon_view(const point_type* points, std::size_t size, const std::size_t* hole_offsets,
+      std::size_t hole_count) NANO_NOEXCEPT;
+
+  NANO_INLINE polygon_view(const std::vector<point_type>& points) NANO_NOEXCEPT;
+
+  NANO_INLINE polygon_view(
+      const std::vector<point_type>& points, const std::vector<std::size_t>& hole_offsets) NANO_NOEXCEPT;
+
+  /// All the points of all the rings.
+  NANO_NODC_INLINE_CXPR const point_type* points() const NANO_NOEXCEPT;
+
+  /// Total number of points.
+  NANO_NODC_INLINE_CXPR std::size_t size() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE_CXPR bool empty() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE_CXPR std::size_t hole_count() const NANO_NOEXCEPT;
+
+  /// Number of rings, the outer one and the holes.
+  NANO_NODC_INLINE_CXPR std::size_t ring_count() const NANO_NOEXCEPT;
+
+  /// Position of the first point of ring `i` in points().
+  NANO_NODC_INLINE_CXPR std::size_t ring_begin(std::size_t i) const NANO_NOEXCEPT;
+
+  /// Position past the last point of ring `i` in points().
+  NANO_NODC_INLINE_CXPR std::size_t ring_end(std::size_t i) const NANO_NOEXCEPT;
+
+  /// Twice the signed area of ring `i`, positive when counter-clockwise in a y-up frame.
+  NANO_NODC_INLINE double ring_signed_area(std::size_t i) const NANO_NOEXCEPT;
+
+  /// Area of the outer ring minus the area of the holes.
+  NANO_NODC_INLINE double area() const NANO_NOEXCEPT;
+
+  /// Bounds of the outer ring, {0, 0, 0, 0} when empty.
+  NANO_NODC_INLINE rect_type bounds() const NANO_NOEXCEPT;
+
+private:
+  const point_type* _points = nullptr;
+  std::size_t _size = 0;
+  const std::size_t* _hole_offsets = nullptr;
+  std::size_t _hole_count = 0;
+};
+
+/// Owning list of polygons with holes, stored in shared buffers.
+///
+/// Every polygon is laid out as a polygon_view expects: its outer ring first, followed
+/// by its holes, with hole offsets relative to the first point of the polygon.
+template <typename T>
+class polygon_set {
+public:
+  using value_type = T;
+  using point_type = nano::point<value_type>;
+  using polygon_type = nano::polygon_view<value_type>;
+
+  /// Number of polygons.
+  NANO_NODC_INLINE std::size_t size() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE bool empty() const NANO_NOEXCEPT;
+
+  /// View of polygon `i`, valid until the set is modified.
+  NANO_NODC_INLINE polygon_type operator[](std::size_t i) const NANO_NOEXCEPT;
+
+  /// All the points of all the polygons.
+  NANO_NODC_INLINE const std::vector<point_type>& points() const NANO_NOEXCEPT;
+
+  /// Sum of the areas of the polygons.
+  NANO_NODC_INLINE double area() const NANO_NOEXCEPT;
+
+  /// Removes all the polygons and keeps the memory.
+  NANO_INLINE void clear() NANO_NOEXCEPT;
+
+  /// Appends a copy of `poly`.
+  NANO_INLINE void push_back(const polygon_type& poly);
+
+  /// Starts a new polygon, followed by calls to add_ring() with its outer ring first.
+  NANO_INLINE void begin_polygon();
+
+  /// Appends a ring to the last polygon.
+  NANO_INLINE void add_ring(const point_type* points, std::size_t count);
+
+  /// Appends a ring to the last polygon, converting the points with static_cast.
+  template <typename U>
+  NANO_INLINE void add_ring(const nano::point<U>* points, std::size_t count, bool reversed = false);
+
+private:
+  struct entry {
+    std::size_t first_point;
+    std::size_t point_count;
+    std::size_t first_hole;
+    std::size_t hole_count;
+  };
+
+  std::vector<point_type> _points;
+  std::vector<std::size_t> _hole_offsets;
+  std::vector<entry> _polygons;
+};
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+template <typename T>
+NANO_INLINE_CXPR polygon_view<T>::polygon_view(const point_type* points, std::size_t size) NANO_NOEXCEPT
+    : _points(points),
+      _size(size) {}
+
+template <typename T>
+NANO_INLINE_CXPR polygon_view<T>::polygon_view(const point_type* points, std::size_t size,
+    const std::size_t* hole_offsets, std::size_t hole_count) NANO_NOEXCEPT : _points(points),
+                                                                             _size(size),
+                                                                             _hole_offsets(hole_offsets),
+                                                                             _hole_count(hole_count) {}
+
+template <typename T>
+polygon_view<T>::polygon_view(const std::vector<point_type>& points) NANO_NOEXCEPT : _points(points.data()),
+                                                                                   _size(points.size()) {}
+
+template <typename T>
+polygon_view<T>::polygon_view(
+    const std::vector<point_type>& points, const std::vector<std::size_t>& hole_offsets) NANO_NOEXCEPT
+    : _points(points.data()),
+      _size(points.size()),
+      _hole_offsets(hole_offsets.data()),
+      _hole_count(hole_offsets.size()) {}
+
+template <typename T>
+NANO_INLINE_CXPR const typename polygon_view<T>::point_type* polygon_view<T>::points() const NANO_NOEXCEPT {
+  return _points;
+}
+
+template <typename T>
+NANO_INLINE_CXPR std::size_t polygon_view<T>::size() const NANO_NOEXCEPT {
+  return _size;
+}
+
+template <typename T>
+NANO_INLINE_CXPR bool polygon_view<T>::empty() const NANO_NOEXCEPT {
+  return _size == 0;
+}
+
+template <typename T>
+NANO_INLINE_CXPR std::size_t polygon_view<T>::hole_count() const NANO_NOEXCEPT {
+  return _hole_count;
+}
+
+template <typename T>
+NANO_INLINE_CXPR std::size_t polygon_view<T>::ring_count() const NANO_NOEXCEPT {
+  return _size == 0 ? 0 : _hole_count + 1;
+}
+
+template <typename T>
+NANO_INLINE_CXPR std::size_t polygon_view<T>::ring_begin(std::size_t i) const NANO_NOEXCEPT {
+  return i == 0 ? 0 : _hole_offsets[i - 1];
+}
+
+template <typename T>
+NANO_INLINE_CXPR std::size_t polygon_view<T>::ring_end(std::size_t i) const NANO_NOEXCEPT {
+  return i < _hole_count ? _hole_offsets[i] : _size;
+}
+
+template <typename T>
+double polygon_view<T>::ring_signed_area(std::size_t i) const NANO_NOEXCEPT {
+  const std::size_t first = ring_begin(i);
+  const std::size_t last = ring_end(i);
+  double sum = 0;
+
+  for (std::size_t k = first, j = last - 1; k < last; j = k++) {
+    sum += (static_cast<double>(_points[j].x) * static_cast<double>(_points[k].y))
+        - (static_cast<double>(_points[k].x) * static_cast<double>(_points[j].y));
+  }
+
+  return sum;
+}
+
+template <typename T>
+double polygon_view<T>::area() const NANO_NOEXCEPT {
+  if (empty()) {
+    return 0;
+  }
+
+  double total = std::abs(ring_signed_area(0));
+  for (std::size_t i = 1; i < ring_count(); i++) {
+    total -= std::abs(ring_signed_area(i));
+  }
+
+  return total * 0.5;
+}
+
+template <typename T>
+typename polygon_view<T>::rect_type polygon_view<T>::bounds() const NANO_NOEXCEPT {
+  if (empty()) {
+    return rect_type{ 0, 0, 0, 0 };
+  }
+
+  T l = _points[0].x;
+  T t = _points[0].y;
+  T r = _points[0].x;
+  T b = _points[0].y;
+
+  for (std::size_t i = 1; i < ring_end(0); i++) {
+    l = std::min(l, _points[i].x);
+    t = std::min(t, _points[i].y);
+    r = std::max(r, _points[i].x);
+    b = std::max(b, _points[i].y);
+  }
+
+  return rect_type::create_from_point({ l, t }, { r, b });
+}
+
+//
+// MARK: - polygon_set -
+//
+
+template <typename T>
+std::size_t polygon_set<T>::size() const NANO_NOEXCEPT {
+  return _polygons.size();
+}
+
+template <typename T>
+bool polygon_set<T>::empty() const NANO_NOEXCEPT {
+  return _polygons.empty();
+}
+
+template <typename T>
+typename polygon_set<T>::polygon_type polygon_set<T>::operator[](std::size_t i) const NANO_NOEXCEPT {
+  const entry& e = _polygons[i];
+  return polygon_type(_points.data() + e.first_point, e.point_count, _hole_offsets.data() + e.first_hole, e.hole_count);
+}
+
+template <typename T>
+const std::vector<typename polygon_set<T>::point_type>& polygon_set<T>::points() const NANO_NOEXCEPT {
+  return _points;
+}
+
+template <typename T>
+double polygon_set<T>::area() const NANO_NOEXCEPT {
+  double total = 0;
+  for (std::size_t i = 0; i < size(); i++) {
+    total += operator[](i).area();
+  }
+
+  return total;
+}
+
+template <typename T>
+void polygon_set<T>::clear() NANO_NOEXCEPT {
+  _points.clear();
+  _hole_offsets.clear();
+  _polygons.clear();
+}
+
+template <typename T>
+void polygon_set<T>::push_back(const polygon_type& poly) {
+  begin_polygon();
+  for (std::size_t i = 0; i < poly.ring_count(); i++) {
+    add_ring(poly.points() + poly.ring_begin(i), poly.ring_end(i) - poly.ring_begin(i));
+  }
+}
+
+template <typename T>
+void polygon_set<T>::begin_polygon() {
+  _polygons.push_back({ _points.size(), 0, _hole_offsets.size(), 0 });
+}
+
+template <typename T>
+void polygon_set<T>::add_ring(const point_type* points, std::size_t count) {
+  add_ring<T>(points, count, false);
+}
+
+template <typename T>
+template <typename U>
+void polygon_set<T>::add_ring(const nano::point<U>* points, std::size_t count, bool reversed) {
+  entry& e = _polygons.back();
+  if (e.point_count != 0) {
+    _hole_offsets.push_back(e.point_count);
+    e.hole_count++;
+  }
+
+  for (std::size_t i = 0; i < count; i++) {
+    const nano::point<U>& p = points[reversed ? count - 1 - i : i];
+    _points.push_back({ static_cast<value_type>(p.x), static_cast<value_type>(p.y) });
+  }
+
+  e.point_count += count;
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,1058 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/polygon_boolean.h
+ * @brief     nano polygon boolean operations
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+/*
+ * detail::polygon_sweep is derived from martinez (https://github.com/w8r/martinez),
+ * distributed under the following license:
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Alexander Milevski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/polygon.h>
+#include <nano/geometry/trace.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+enum class boolean_operation {
+  /// Area covered by both operands.
+  intersection,
+
+  /// Area covered by either operand.
+  unite,
+
+  /// Area covered by the first operand and not by the second one.
+  difference,
+
+  /// Area covered by exactly one operand.
+  exclusive_or
+};
+
+namespace detail {
+  struct clip_event;
+
+  struct clip_segment_less {
+    inline bool operator()(const clip_event* a, const clip_event* b) const NANO_NOEXCEPT;
+  };
+
+  using clip_status = std::set<clip_event*, clip_segment_less>;
+
+  enum class clip_edge_type : std::uint8_t { normal, non_contributing, same_transition, different_transition };
+
+  /// Endpoint of a segment in the sweep, the left one of each pair carries the state.
+  struct clip_event {
+    nano::point<double> p;
+    clip_event* other;
+    clip_event* prev_in_result;
+    clip_status::iterator position;
+    std::size_t contour_id;
+    std::size_t output_contour;
+    std::size_t result_position;
+    clip_edge_type type;
+    bool left;
+    bool subject;
+    bool in_out;
+    bool other_in_out;
+    bool in_result;
+    bool result_inside;
+    bool in_status;
+  };
+
+  /// Martinez-Rueda sweep computing boolean operations on sets of rings, derived from
+  /// martinez (see the license notice at the top of this file).
+  ///
+  /// The rings of each operand are combined with the even-odd rule. Events are allocated
+  /// in blocks that are kept between runs, the queue is a binary heap over a reused vector.
+  class polygon_sweep {
+  public:
+    struct contour {
+      std::size_t first;
+      std::size_t last;
+      std::size_t hole_of;
+      std::size_t depth;
+    };
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    inline void reset() NANO_NOEXCEPT;
+
+    template <typename T>
+    inline void add_ring(const nano::point<T>* points, std::size_t count, bool subject);
+
+    /// Runs the sweep, the contours and their points are then available.
+    inline void run(boolean_operation op);
+
+    const std::vector<contour>& contours() const NANO_NOEXCEPT { return _contours; }
+
+    const std::vector<nano::point<double>>& points() const NANO_NOEXCEPT { return _points; }
+
+  private:
+    static constexpr std::size_t block_size = 1024;
+
+    std::vector<std::unique_ptr<clip_event[]>> _blocks;
+    std::size_t _used = 0;
+    std::vector<clip_event*> _queue;
+    std::vector<clip_event*> _processed;
+    std::vector<clip_event*> _result;
+    std::vector<unsigned char> _visited;
+    std::vector<contour> _contours;
+    std::vector<nano::point<double>> _points;
+    double _right[2] = { 0, 0 };
+    bool _has_edges[2] = { false, false };
+    std::size_t _contour_count = 0;
+
+    inline clip_event* allocate(const nano::point<double>& p, bool left, clip_event* other, bool subject);
+    inline void push(clip_event* e);
+    inline clip_event* pop() NANO_NOEXCEPT;
+    inline void compute_fields(clip_event* e, clip_event* prev, boolean_operation op) const NANO_NOEXCEPT;
+    inline int possible_intersection(clip_event* a, clip_event* b);
+    inline void divide_segment(clip_event* e, const nano::point<double>& p);
+    inline void connect_edges(boolean_operation op);
+    inline std::size_t next_position(std::size_t pos) const NANO_NOEXCEPT;
+  };
+} // namespace detail.
+
+/// Boolean operations between polygons, with reusable working memory.
+///
+/// The operands are polygon_set (several polygons with holes) or rects. Each operand is
+/// interpreted with the even-odd rule, the orientation of its rings does not matter.
+/// The result polygons have counter-clockwise outer rings and clockwise holes
+/// (positive and negative polygon_view::ring_signed_area()).
+///
+/// Rect operands are handled without the sweep whenever the result is a rect, a rect
+/// with a rect hole or a copy of the operands, and so are polygons whose bounds do
+/// not overlap. The computation is done in double, integer results are truncated.
+template <typename T>
+class polygon_clipper {
+public:
+  using value_type = T;
+  using point_type = nano::point<value_type>;
+  using rect_type = nano::rect<value_type>;
+  using set_type = nano::polygon_set<value_type>;
+
+  /// Replaces the content of `result` with `a` `op` `b`.
+  inline void compute(const set_type& a, const set_type& b, boolean_operation op, set_type& result);
+
+  inline void compute(const rect_type& a, const rect_type& b, boolean_operation op, set_type& result);
+
+private:
+  detail::polygon_sweep _sweep;
+  std::vector<std::size_t> _holes;
+  std::vector<std::size_t> _hole_first;
+
+  inline bool trivial(const set_type& a, const set_type& b, boolean_operation op, set_type& result) const;
+  inline void run_sweep(const set_type& a, const set_type& b, boolean_operation op, set_type& result);
+
+  static inline rect_type bounds(const set_type& s) NANO_NOEXCEPT;
+  static inline void append(const set_type& s, set_type& result);
+  static inline void append_rect(const rect_type& r, set_type& result, const rect_type* hole = nullptr);
+};
+
+/// Computes `a` `op` `b` with a temporary polygon_clipper.
+template <typename T>
+inline void polygon_boolean(const nano::polygon_set<T>& a, const nano::polygon_set<T>& b, boolean_operation op,
+    nano::polygon_set<T>& result);
+
+/// Same as above with rect operands.
+template <typename T>
+inline void polygon_boolean(
+    const nano::rect<T>& a, const nano::rect<T>& b, boolean_operation op, nano::polygon_set<T>& result);
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+  NANO_INLINE double clip_signed_area(
+      const nano::point<double>& p0, const nano::point<double>& p1, const nano::point<double>& p2) NANO_NOEXCEPT {
+    return (p0.x - p2.x) * (p1.y - p2.y) - (p1.x - p2.x) * (p0.y - p2.y);
+  }
+
+  NANO_INLINE bool clip_is_below(const clip_event* e, const nano::point<double>& p) NANO_NOEXCEPT {
+    return e->left ? clip_signed_area(e->p, e->other->p, p) > 0 : clip_signed_area(e->other->p, e->p, p) > 0;
+  }
+
+  NANO_INLINE bool clip_is_vertical(const clip_event* e) NANO_NOEXCEPT { return e->p.x == e->other->p.x; }
+
+  /// Exact comparison, point::operator== is fuzzy and would disagree with the exact
+  /// ordering of the events and of the status line.
+  NANO_INLINE bool clip_same_point(const nano::point<double>& a, const nano::point<double>& b) NANO_NOEXCEPT {
+    return a.x == b.x && a.y == b.y;
+  }
+
+  /// True when `a` is processed after `b`: by x, then y, right endpoints first, then
+  /// the lower segment first.
+  NANO_INLINE bool clip_event_after(const clip_event* a, const clip_event* b) NANO_NOEXCEPT {
+    if (a->p.x != b->p.x) {
+      return a->p.x > b->p.x;
+    }
+
+    if (a->p.y != b->p.y) {
+      return a->p.y > b->p.y;
+    }
+
+    if (a->left != b->left) {
+      return a->left;
+    }
+
+    if (clip_signed_area(a->p, a->other->p, b->other->p) != 0) {
+      return !clip_is_below(a, b->other->p);
+    }
+
+    return !a->subject && b->subject;
+  }
+
+  // Order of the segments crossing the sweep line, from bottom to top.
+  bool clip_segment_less::operator()(const clip_event* a, const clip_event* b) const NANO_NOEXCEPT {
+    if (a == b) {
+      return false;
+    }
+
+    if (clip_signed_area(a->p, a->other->p, b->p) != 0 || clip_signed_area(a->p, a->other->p, b->other->p) != 0) {
+      // Not collinear.
+      if (clip_same_point(a->p, b->p)) {
+        return clip_is_below(a, b->other->p);
+      }
+
+      if (a->p.x == b->p.x) {
+        return a->p.y < b->p.y;
+      }
+
+      if (clip_event_after(a, b)) {
+        return clip_is_below(b, a->p) == false;
+      }
+
+      return clip_is_below(a, b->p);
+    }
+
+    if (a->subject == b->subject) {
+      if (clip_same_point(a->p, b->p)) {
+        if (clip_same_point(a->other->p, b->other->p)) {
+          return a < b;
+        }
+
+        return a->contour_id < b->contour_id;
+      }
+    }
+    else {
+      return a->subject;
+    }
+
+    return !clip_event_after(a, b);
+  }
+
+  NANO_INLINE bool clip_in_result(const clip_event* e, boolean_operation op) NANO_NOEXCEPT {
+    switch (e->type) {
+    case clip_edge_type::normal:
+      switch (op) {
+      case boolean_operation::intersection:
+        return !e->other_in_out;
+      case boolean_operation::unite:
+        return e->other_in_out;
+      case boolean_operation::difference:
+        return e->subject == e->other_in_out;
+      case boolean_operation::exclusive_or:
+        return true;
+      }
+      return false;
+
+    case clip_edge_type::same_transition:
+      return op == boolean_operation::intersection || op == boolean_operation::unite;
+
+    case clip_edge_type::different_transition:
+      return op == boolean_operation::difference;
+
+    case clip_edge_type::non_contributing:
+      return false;
+    }
+
+    return false;
+  }
+
+  // Whether the area right above the segment is in the result.
+  NANO_INLINE bool clip_result_inside(const clip_event* e, boolean_operation op) NANO_NOEXCEPT {
+    const bool this_in = !e->in_out;
+    const bool that_in = !e->other_in_out;
+
+    switch (op) {
+    case boolean_operation::intersection:
+      return this_in && that_in;
+    case boolean_operation::unite:
+      return this_in || that_in;
+    case boolean_operation::difference:
+      return e->subject ? this_in && !that_in : that_in && !this_in;
+    case boolean_operation::exclusive_or:
+      return this_in != that_in;
+    }
+
+    return false;
+  }
+
+  // Intersections of the segments [a1, a2] and [b1, b2], returns their count (0, 1 or 2
+  // for overlapping segments).
+  NANO_INLINE int clip_intersection(const nano::point<double>& a1, const nano::point<double>& a2,
+      const nano::point<double>& b1, const nano::point<double>& b2, nano::point<double>* out) NANO_NOEXCEPT {
+    const nano::point<double> va = a2 - a1;
+    const nano::point<double> vb = b2 - b1;
+    const nano::point<double> e = b1 - a1;
+    const auto cross = [](const nano::point<double>& u, const nano::point<double>& v) { return u.x * v.y - u.y * v.x; };
+    const auto at = [](const nano::point<double>& p, double s, const nano::point<double>& v) {
+      return nano::point<double>{ p.x + s * v.x, p.y + s * v.y };
+    };
+
+    const double kross = cross(va, vb);
+    if (kross != 0) {
+      const double s = cross(e, vb) / kross;
+      if (s < 0 || s > 1) {
+        return 0;
+      }
+
+      const double t = cross(e, va) / kross;
+      if (t < 0 || t > 1) {
+        return 0;
+      }
+
+      if (s == 0 || s == 1) {
+        out[0] = at(a1, s, va);
+        return 1;
+      }
+
+      out[0] = t == 0 || t == 1 ? at(b1, t, vb) : at(a1, s, va);
+      return 1;
+    }
+
+    // Parallel, overlapping when collinear.
+    if (cross(e, va) != 0) {
+      return 0;
+    }
+
+    const double length2 = va.x * va.x + va.y * va.y;
+    const double sa = (va.x * e.x + va.y * e.y) / length2;
+    const double sb = sa + (va.x * vb.x + va.y * vb.y) / length2;
+    const double smin = std::min(sa, sb);
+    const double smax = std::max(sa, sb);
+
+    if (smin > 1 || smax < 0) {
+      return 0;
+    }
+
+    if (smin == 1) {
+      out[0] = at(a1, 1, va);
+      return 1;
+    }
+
+    if (smax == 0) {
+      out[0] = a1;
+      return 1;
+    }
+
+    out[0] = at(a1, std::max(smin, 0.0), va);
+    out[1] = at(a1, std::min(smax, 1.0), va);
+    return 2;
+  }
+
+  //
+  // MARK: - polygon_sweep -
+  //
+
+  void polygon_sweep::reset() NANO_NOEXCEPT {
+    _used = 0;
+    _queue.clear();
+    _processed.clear();
+    _result.clear();
+    _contours.clear();
+    _points.clear();
+    _has_edges[0] = false;
+    _has_edges[1] = false;
+    _contour_count = 0;
+  }
+
+  clip_event* polygon_sweep::allocate(const nano::point<double>& p, bool left, clip_event* other, bool subject) {
+    if (_used == _blocks.size() * block_size) {
+      _blocks.push_back(std::make_unique<clip_event[]>(block_size));
+    }
+
+    clip_event* e = &_blocks[_used / block_size][_used % block_size];
+    _used++;
+
+    *e = clip_event{};
+    e->p = p;
+    e->other = other;
+    e->left = left;
+    e->subject = subject;
+    e->output_contour = npos;
+    return e;
+  }
+
+  void polygon_sweep::push(clip_event* e) {
+    _queue.push_back(e);
+    std::push_heap(_queue.begin(), _queue.end(), clip_event_after);
+  }
+
+  clip_event* polygon_sweep::pop() NANO_NOEXCEPT {
+    std::pop_heap(_queue.begin(), _queue.end(), clip_event_after);
+    clip_event* e = _queue.back();
+    _queue.pop_back();
+    return e;
+  }
+
+  template <typename T>
+  void polygon_sweep::add_ring(const nano::point<T>* points, std::size_t count, bool subject) {
+    const std::size_t contour_id = _contour_count++;
+
+    for (std::size_t i = 0; i < count; i++) {
+      const nano::point<double> p1 = { static_cast<double>(points[i].x), static_cast<double>(points[i].y) };
+      const nano::point<T>& q = points[i + 1 == count ? 0 : i + 1];
+      const nano::point<double> p2 = { static_cast<double>(q.x), static_cast<double>(q.y) };
+
+      if (clip_same_point(p1, p2)) {
+        continue;
+      }
+
+      clip_event* e1 = allocate(p1, false, nullptr, subject);
+      clip_event* e2 = allocate(p2, false, e1, subject);
+      e1->other = e2;
+      e1->contour_id = contour_id;
+      e2->contour_id = contour_id;
+
+      if (clip_event_after(e1, e2)) {
+        e2->left = true;
+      }
+      else {
+        e1->left = true;
+      }
+
+      // Kept as a max rather than a rect so that the limit compares exactly with the event points.
+      double& right = _right[subject ? 0 : 1];
+      right = _has_edges[subject ? 0 : 1] ? std::max(right, std::max(p1.x, p2.x)) : std::max(p1.x, p2.x);
+      _has_edges[subject ? 0 : 1] = true;
+
+      push(e1);
+      push(e2);
+    }
+  }
+
+  void polygon_sweep::compute_fields(clip_event* e, clip_event* prev, boolean_operation op) const NANO_NOEXCEPT {
+    if (!prev) {
+      e->in_out = false;
+      e->other_in_out = true;
+      e->prev_in_result = nullptr;
+    }
+    else {
+      if (e->subject == prev->subject) {
+        e->in_out = !prev->in_out;
+        e->other_in_out = prev->other_in_out;
+      }
+      else {
+        e->in_out = !prev->other_in_out;
+        e->other_in_out = clip_is_vertical(prev) ? !prev->in_out : prev->in_out;
+      }
+
+      e->prev_in_result = !prev->in_result || clip_is_vertical(prev) ? prev->prev_in_result : prev;
+    }
+
+    e->in_result = clip_in_result(e, op);
+    e->result_inside = e->in_result && clip_result_inside(e, op);
+  }
+
+  // Splits the segment of left event `e` at `p`.
+  void polygon_sweep::divide_segment(clip_event* e, const nano::point<double>& p) {
+    clip_event* r = allocate(p, false, e, e->subject);
+    clip_event* l = allocate(p, true, e->other, e->subject);
+    r->contour_id = e->contour_id;
+    l->contour_id = e->contour_id;
+
+    // Rounding may put the new left event after its right end.
+    if (clip_event_after(l, e->other)) {
+      e->other->left = true;
+      l->left = false;
+    }
+
+    e->other->other = l;
+    e->other = r;
+
+    push(l);
+    push(r);
+  }
+
+  // Returns 0 without intersection, 1 when split at a point, 2 when both segments start
+  // at the same point and overlap, 3 for other overlaps.
+  int polygon_sweep::possible_intersection(clip_event* a, clip_event* b) {
+    nano::point<double> inter[2];
+    const int n = clip_intersection(a->p, a->other->p, b->p, b->other->p, inter);
+
+    if (n == 0) {
+      return 0;
+    }
+
+    // Intersection at an endpoint of both segments.
+    if (n == 1 && (clip_same_point(a->p, b->p) || clip_same_point(a->other->p, b->other->p))) {
+      return 0;
+    }
+
+    // Overlapping edges of the same operand are left as they are.
+    if (n == 2 && a->subject == b->subject) {
+      return 0;
+    }
+
+    if (n == 1) {
+      if (!clip_same_point(a->p, inter[0]) && !clip_same_point(a->other->p, inter[0])) {
+        divide_segment(a, inter[0]);
+      }
+
+      if (!clip_same_point(b->p, inter[0]) && !clip_same_point(b->other->p, inter[0])) {
+        divide_segment(b, inter[0]);
+      }
+
+      return 1;
+    }
+
+    clip_event* events[4];
+    std::size_t count = 0;
+    const bool left_coincide = clip_same_point(a->p, b->p);
+    const bool right_coincide = clip_same_point(a->other->p, b->other->p);
+
+    if (!left_coincide) {
+      events[count++] = clip_event_after(a, b) ? b : a;
+      events[count++] = clip_event_after(a, b) ? a : b;
+    }
+
+    if (!right_coincide) {
+      events[count++] = clip_event_after(a->other, b->other) ? b->other : a->other;
+      events[count++] = clip_event_after(a->other, b->other) ? a->other : b->other;
+    }
+
+    if (left_coincide) {
+      // Same segment or same left endpoint, only one of them contributes.
+      b->type = clip_edge_type::non_contributing;
+      a->type = b->in_out == a->in_out ? clip_edge_type::same_transition : clip_edge_type::different_transition;
+
+      if (!right_coincide) {
+        divide_segment(events[1]->other, events[0]->p);
+      }
+
+      return 2;
+    }
+
+    if (right_coincide) {
+      divide_segment(events[0], events[1]->p);
+      return 3;
+    }
+
+    if (events[0] != events[3]->other) {
+      // One segment includes the other.
+      divide_segment(events[0], events[1]->p);
+      divide_segment(events[1], events[2]->p);
+      return 3;
+    }
+
+    divide_segment(events[0], events[1]->p);
+    divide_segment(events[3]->other, events[2]->p);
+    return 3;
+  }
+
+  void polygon_sweep::run(boolean_operation op) {
+    _contours.clear();
+    _points.clear();
+
+    if (!_has_edges[0]) {
+      return;
+    }
+
+    const double subject_right = _right[0];
+    const double clipping_right = _has_edges[1] ? _right[1] : subject_right;
+    const double right_limit = op == boolean_operation::intersection ? std::min(subject_right, clipping_right)
+        : op == boolean_operation::difference                        ? subject_right
+                                                                     : std::numeric_limits<double>::infinity();
+
+    clip_status status;
+
+    while (!_queue.empty()) {
+      clip_event* e = pop();
+
+      // Nothing past the bounds of the subject (or of both operands) is in the result.
+      if (e->p.x > right_limit) {
+        break;
+      }
+
+      _processed.push_back(e);
+
+      if (e->left) {
+        e->position = status.insert(e).first;
+        e->in_status = true;
+        clip_status::iterator next = std::next(e->position);
+        clip_event* prev = e->position == status.begin() ? nullptr : *std::prev(e->position);
+
+        compute_fields(e, prev, op);
+
+        if (next != status.end() && possible_intersection(e, *next) == 2) {
+          compute_fields(e, prev, op);
+          compute_fields(*next, e, op);
+        }
+
+        if (prev && possible_intersection(prev, e) == 2) {
+          clip_status::iterator prev_it = prev->position;
+          clip_event* prev_prev = prev_it == status.begin() ? nullptr : *std::prev(prev_it);
+          compute_fields(prev, prev_prev, op);
+          compute_fields(e, prev, op);
+        }
+      }
+      else {
+        clip_event* left = e->other;
+        if (left->in_status) {
+          clip_status::iterator it = left->position;
+          clip_event* prev = it == status.begin() ? nullptr : *std::prev(it);
+          clip_status::iterator next = std::next(it);
+          clip_event* next_event = next == status.end() ? nullptr : *next;
+
+          status.erase(it);
+          left->in_status = false;
+
+          if (prev && next_event) {
+            possible_intersection(prev, next_event);
+          }
+        }
+      }
+    }
+
+    connect_edges(op);
+  }
+
+  std::size_t polygon_sweep::next_position(std::size_t pos) const NANO_NOEXCEPT {
+    const nano::point<double>& p = _result[pos]->p;
+
+    for (std::size_t i = pos + 1; i < _result.size() && clip_same_point(_result[i]->p, p); i++) {
+      if (!_visited[i]) {
+        return i;
+      }
+    }
+
+    for (std::size_t i = pos; i-- > 0 && clip_same_point(_result[i]->p, p);) {
+      if (!_visited[i]) {
+        return i;
+      }
+    }
+
+    return npos;
+  }
+
+  // Chains the result edges into contours and finds the hole of each one from the
+  // closest result edge below its first point.
+  void polygon_sweep::connect_edges(boolean_operation) {
+    _result.clear();
+    for (clip_event* e : _processed) {
+      if ((e->left && e->in_result) || (!e->left && e->other->in_result)) {
+        _result.push_back(e);
+      }
+    }
+
+    // Nearly sorted already, only rounding can swap neighbors.
+    for (std::size_t i = 1; i < _result.size(); i++) {
+      for (std::size_t j = i; j > 0 && clip_event_after(_result[j - 1], _result[j]); j--) {
+        std::swap(_result[j - 1], _result[j]);
+      }
+    }
+
+    for (std::size_t i = 0; i < _result.size(); i++) {
+      _result[i]->result_position = i;
+    }
+
+    // Each event points to the position of the other end of its segment.
+    for (clip_event* e : _result) {
+      if (!e->left) {
+        std::swap(e->result_position, e->other->result_position);
+      }
+    }
+
+    _visited.assign(_result.size(), 0);
+
+    for (std::size_t i = 0; i < _result.size(); i++) {
+      if (_visited[i]) {
+        continue;
+      }
+
+      const std::size_t contour_id = _contours.size();
+      contour c = { _points.size(), 0, npos, 0 };
+
+      const clip_event* below = _result[i]->prev_in_result;
+      if (below && below->output_contour != npos) {
+        const contour& lower = _contours[below->output_contour];
+
+        if (below->result_inside) {
+          c.hole_of = lower.hole_of != npos ? lower.hole_of : below->output_contour;
+          c.depth = lower.hole_of != npos ? lower.depth : lower.depth + 1;
+        }
+        else {
+          c.depth = lower.depth;
+        }
+      }
+
+      const nano::point<double> start = _result[i]->p;
+      _points.push_back(start);
+      std::size_t pos = i;
+
+      for (;;) {
+        _visited[pos] = 1;
+        _result[pos]->output_contour = contour_id;
+        pos = _result[pos]->result_position;
+        _visited[pos] = 1;
+        _result[pos]->output_contour = contour_id;
+
+        if (clip_same_point(_result[pos]->p, start)) {
+          break;
+        }
+
+        _points.push_back(_result[pos]->p);
+        pos = next_position(pos);
+
+        if (pos == npos) {
+          break;
+        }
+      }
+
+      c.last = _points.size();
+      // Outer rings counter-clockwise, holes clockwise.
+      double area = 0;
+      for (std::size_t k = c.first, j = c.last - 1; k < c.last; j = k++) {
+        area += _points[j].x * _points[k].y - _points[k].x * _points[j].y;
+      }
+
+      if ((area > 0) != (c.hole_of == npos)) {
+        std::reverse(_points.begin() + static_cast<std::ptrdiff_t>(c.first),
+            _points.begin() + static_cast<std::ptrdiff_t>(c.last));
+      }
+
+      _contours.push_back(c);
+    }
+  }
+} // namespace detail.
+
+//
+// MARK: - polygon_clipper -
+//
+
+template <typename T>
+typename polygon_clipper<T>::rect_type polygon_clipper<T>::bounds(const set_type& s) NANO_NOEXCEPT {
+  const std::vector<point_type>& points = s.points();
+  if (points.empty()) {
+    return rect_type(0, 0, 0, 0);
+  }
+
+  T l = points[0].x;
+  T t = points[0].y;
+  T r = points[0].x;
+  T b = points[0].y;
+
+  for (const point_type& p : points) {
+    l = std::min(l, p.x);
+    t = std::min(t, p.y);
+    r = std::max(r, p.x);
+    b = std::max(b, p.y);
+  }
+
+  return rect_type::create_from_point({ l, t }, { r, b });
+}
+
+// Copies the polygons of `s` with the output orientation.
+template <typename T>
+void polygon_clipper<T>::append(const set_type& s, set_type& result) {
+  for (std::size_t i = 0; i < s.size(); i++) {
+    const nano::polygon_view<T> poly = s[i];
+    result.begin_polygon();
+
+    for (std::size_t r = 0; r < poly.ring_count(); r++) {
+      const bool positive = poly.ring_signed_area(r) > 0;
+      result.add_ring(poly.points() + poly.ring_begin(r), poly.ring_end(r) - poly.ring_begin(r), positive != (r == 0));
+    }
+  }
+}
+
+template <typename T>
+void polygon_clipper<T>::append_rect(const rect_type& r, set_type& result, const rect_type* hole) {
+  const point_type corners[4] = { { r.origin.x, r.origin.y }, { r.origin.x + r.size.width, r.origin.y },
+    { r.origin.x + r.size.width, r.origin.y + r.size.height }, { r.origin.x, r.origin.y + r.size.height } };
+
+  result.begin_polygon();
+  result.add_ring(corners, 4, false);
+
+  if (hole) {
+    const point_type hole_corners[4] = { { hole->origin.x, hole->origin.y },
+      { hole->origin.x, hole->origin.y + hole->size.height },
+      { hole->origin.x + hole->size.width, hole->origin.y + hole->size.height },
+      { hole->origin.x + hole->size.width, hole->origin.y } };
+    result.add_ring(hole_corners, 4, false);
+  }
+}
+
+// Operands whose bounds do not overlap, or an empty operand.
+template <typename T>
+bool polygon_clipper<T>::trivial(const set_type& a, const set_type& b, boolean_operation op, set_type& result) const {
+  if (!a.empty() && !b.empty()) {
+    const rect_type ba = bounds(a);
+    const rect_type bb = bounds(b);
+
+    // Touching operands may merge, they go through the sweep.
+    if (ba.origin.x <= bb.origin.x + bb.size.width && bb.origin.x <= ba.origin.x + ba.size.width
+        && ba.origin.y <= bb.origin.y + bb.size.height && bb.origin.y <= ba.origin.y + ba.size.height) {
+      return false;
+    }
+  }
+
+  switch (op) {
+  case boolean_operation::intersection:
+    break;
+
+  case boolean_operation::difference:
+    append(a, result);
+    break;
+
+  case boolean_operation::unite:
+  case boolean_operation::exclusive_or:
+    append(a, result);
+    append(b, result);
+    break;
+  }
+
+  return true;
+}
+
+template <typename T>
+void polygon_clipper<T>::run_sweep(const set_type& a, const set_type& b, boolean_operation op, set_type& result) {
+  _sweep.reset();
+
+  const auto add = [&](const set_type& s, bool subject) {
+    for (std::size_t i = 0; i < s.size(); i++) {
+      const nano::polygon_view<T> poly = s[i];
+      for (std::size_t r = 0; r < poly.ring_count(); r++) {
+        _sweep.add_ring(poly.points() + poly.ring_begin(r), poly.ring_end(r) - poly.ring_begin(r), subject);
+      }
+    }
+  };
+
+  add(a, true);
+  add(b, false);
+  _sweep.run(op);
+
+  using contour = detail::polygon_sweep::contour;
+  const std::vector<contour>& contours = _sweep.contours();
+  const std::vector<nano::point<double>>& points = _sweep.points();
+
+  // Degenerate contours are kept by the sweep to preserve the numbering.
+  const auto valid = [&](std::size_t i) { return contours[i].last - contours[i].first >= 3; };
+
+  const auto is_hole = [&](std::size_t i) { return contours[i].hole_of != detail::polygon_sweep::npos; };
+
+  // Bucket the holes by outer contour, _hole_first[i] to _hole_first[i + 1] once filled.
+  _hole_first.assign(contours.size() + 1, 0);
+  for (std::size_t i = 0; i < contours.size(); i++) {
+    if (is_hole(i) && valid(i)) {
+      _hole_first[contours[i].hole_of]++;
+    }
+  }
+
+  std::size_t hole_count = 0;
+  for (std::size_t& first : _hole_first) {
+    hole_count += first;
+    first = hole_count;
+  }
+
+  _holes.resize(hole_count);
+  for (std::size_t i = contours.size(); i-- > 0;) {
+    if (is_hole(i) && valid(i)) {
+      _holes[--_hole_first[contours[i].hole_of]] = i;
+    }
+  }
+
+  for (std::size_t i = 0; i < contours.size(); i++) {
+    if (is_hole(i) || !valid(i)) {
+      continue;
+    }
+
+    result.begin_polygon();
+    result.add_ring(points.data() + contours[i].first, contours[i].last - contours[i].first);
+
+    for (std::size_t k = _hole_first[i]; k < _hole_first[i + 1]; k++) {
+      const contour& hole = contours[_holes[k]];
+      result.add_ring(points.data() + hole.first, hole.last - hole.first);
+    }
+  }
+}
+
+template <typename T>
+void polygon_clipper<T>::compute(const set_type& a, const set_type& b, boolean_operation op, set_type& result) {
+  NANO_GEOMETRY_TRACE_SCOPE("polygon_clipper::compute", a.size() + b.size(), 0);
+  result.clear();
+
+  if (trivial(a, b, op, result)) {
+    return;
+  }
+
+  if (op == boolean_operation::exclusive_or) {
+    // Four result edges meet at every crossing point of a single xor sweep and the edge
+    // chaining would join the two sides into figure eights. The two differences have
+    // disjoint interiors and can simply be appended.
+    run_sweep(a, b, boolean_operation::difference, result);
+    run_sweep(b, a, boolean_operation::difference, result);
+    return;
+  }
+
+  run_sweep(a, b, op, result);
+}
+
+template <typename T>
+void polygon_clipper<T>::compute(const rect_type& a, const rect_type& b, boolean_operation op, set_type& result) {
+  result.clear();
+
+  const bool a_empty = !(a.size.width > 0 && a.size.height > 0);
+  const bool b_empty = !(b.size.width > 0 && b.size.height > 0);
+  const bool overlap = !a_empty && !b_empty && a.intersects(b);
+
+  // `inner` inside `outer`, strictly when `strict` is true.
+  const auto contains = [](const rect_type& outer, const rect_type& inner, bool strict) {
+    const T left = inner.origin.x - outer.origin.x;
+    const T top = inner.origin.y - outer.origin.y;
+    const T right = outer.origin.x + outer.size.width - (inner.origin.x + inner.size.width);
+    const T bottom = outer.origin.y + outer.size.height - (inner.origin.y + inner.size.height);
+    return strict ? left > 0 && top > 0 && right > 0 && bottom > 0
+                  : left >= 0 && top >= 0 && right >= 0 && bottom >= 0;
+  };
+
+  const auto touching = [&]() {
+    return a.origin.x <= b.origin.x + b.size.width && b.origin.x <= a.origin.x + a.size.width
+        && a.origin.y <= b.origin.y + b.size.height && b.origin.y <= a.origin.y + a.size.height;
+  };
+
+  if (!overlap) {
+    switch (op) {
+    case boolean_operation::intersection:
+      return;
+
+    case boolean_operation::difference:
+      if (!a_empty) {
+        append_rect(a, result);
+      }
+      return;
+
+    case boolean_operation::unite:
+    case boolean_operation::exclusive_or:
+      if (a_empty || b_empty || !touching()) {
+        if (!a_empty) {
+          append_rect(a, result);
+        }
+
+        if (!b_empty) {
+          append_rect(b, result);
+        }
+
+        return;
+      }
+      break;
+    }
+  }
+  else if (op == boolean_operation::intersection) {
+    append_rect(a.intersection(b), result);
+    return;
+  }
+  else if (op == boolean_operation::unite && (contains(a, b, false) || contains(b, a, false))) {
+    append_rect(contains(a, b, false) ? a : b, result);
+    return;
+  }
+  else if (op == boolean_operation::difference && contains(b, a, false)) {
+    return;
+  }
+  else if (op == boolean_operation::difference && contains(a, b, true)) {
+    append_rect(a, result, &b);
+    return;
+  }
+  else if (op == boolean_operation::exclusive_or && (contains(a, b, true) || contains(b, a, true))) {
+    const bool b_in_a = contains(a, b, true);
+    append_rect(b_in_a ? a : b, result, b_in_a ? &b : &a);
+    return;
+  }
+
+  // Partial overlap or shared edges, the result is not a rect.
+  set_type sa;
+  set_type sb;
+  append_rect(a, sa);
+  append_rect(b, sb);
+  compute(sa, sb, op, result);
+}
+
+template <typename T>
+void polygon_boolean(const nano::polygon_set<T>& a, const nano::polygon_set<T>& b, boolean_operation op,
+    nano::polygon_set<T>& result) {
+  polygon_clipper<T> clipper;
+  clipper.compute(a, b, op, result);
+}
+
+template <typename T>
+void polygon_boolean(
+    const nano::rect<T>& a, const nano::rect<T>& b, boolean_operation op, nano::polygon_set<T>& result) {
+  polygon_clipper<T> clipper;
+  clipper.compute(a, b, op, result);
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
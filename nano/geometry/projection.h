@@ -0,0 +1,367 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/projection.h
+ * @brief     nano map projections
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/trace.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Map projections of longitude and latitude in degrees (point x and y) to meters on the
+/// WGS 84 sphere (radius 6378137), x to the east and y to the north.
+enum class map_projection {
+  /// Spherical mercator of web maps (EPSG:3857). Latitudes are clamped to +/-85.0511287798
+  /// degrees, the world is then a square of +/-20037508.34 meters.
+  web_mercator,
+
+  /// Plate carree, longitude and latitude scaled to meters.
+  equirectangular
+};
+
+/// Projects `count` longitude, latitude points to `out`, which can be `lon_lat`.
+///
+/// The logarithm, exponential and trigonometric functions are polynomial approximations
+/// evaluated by branch-free loops that the compiler can vectorize (double also needs 64-bit
+/// integer comparisons, e.g. SSE4.2, AVX2 or NEON). The measured web mercator error is below
+/// 1e-8 meters with double and below 3 meters with float, about one float step at the edge
+/// of the world.
+template <typename T>
+inline void project(map_projection projection, const nano::point<T>* lon_lat, std::size_t count,
+    nano::point<T>* out) NANO_NOEXCEPT;
+
+/// Same as above followed by `t.apply()`, e.g. to go directly to screen space.
+template <typename T>
+inline void project(map_projection projection, const nano::point<T>* lon_lat, std::size_t count,
+    const nano::transform<T>& t, nano::point<T>* out) NANO_NOEXCEPT;
+
+/// Converts `count` projected points back to longitude and latitude in `lon_lat`, which
+/// can be `points`. The latitude error is below 1e-13 degrees with double and 2e-5 degrees
+/// with float.
+template <typename T>
+inline void unproject(map_projection projection, const nano::point<T>* points, std::size_t count,
+    nano::point<T>* lon_lat) NANO_NOEXCEPT;
+
+/// Same as above with `inverse.apply()` first, e.g. from screen space with the inverse of
+/// the transform given to project().
+template <typename T>
+inline void unproject(map_projection projection, const nano::point<T>* points, std::size_t count,
+    const nano::transform<T>& inverse, nano::point<T>* lon_lat) NANO_NOEXCEPT;
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+  /// Bit layout and number of polynomial terms for the precision of each type. Every series
+  /// is cut after the first term below the rounding error of the type on its reduced range.
+  template <typename T>
+  struct projection_traits;
+
+  template <>
+  struct projection_traits<float> {
+    using bits_type = std::uint32_t;
+    static constexpr int mantissa_bits = 23;
+    static constexpr int exponent_bias = 127;
+    static constexpr bits_type sqrt2_mantissa = 0x3504F3;
+    static constexpr bits_type one_bits = 0x3F800000;
+    static constexpr bits_type exponent_mask = 0x7F800000;
+    static constexpr std::size_t sin_terms = 5;
+    static constexpr std::size_t log_terms = 5;
+    static constexpr std::size_t exp_terms = 8;
+    static constexpr std::size_t atan_terms = 9;
+  };
+
+  template <>
+  struct projection_traits<double> {
+    using bits_type = std::uint64_t;
+    static constexpr int mantissa_bits = 52;
+    static constexpr int exponent_bias = 1023;
+    static constexpr bits_type sqrt2_mantissa = 0x6A09E667F3BCD;
+    static constexpr bits_type one_bits = 0x3FF0000000000000;
+    static constexpr bits_type exponent_mask = 0x7FF0000000000000;
+    static constexpr std::size_t sin_terms = 9;
+    static constexpr std::size_t log_terms = 10;
+    static constexpr std::size_t exp_terms = 14;
+    static constexpr std::size_t atan_terms = 20;
+  };
+
+  // Taylor series of sin(x) / x in x^2, |x| <= pi / 4.
+  inline constexpr double sin_coefficients[9] = { 1.0, -1.0 / 6, 1.0 / 120, -1.0 / 5040, 1.0 / 362880,
+    -1.0 / 39916800, 1.0 / 6227020800.0, -1.0 / 1307674368000.0, 1.0 / 355687428096000.0 };
+
+  // Series of atanh(z) / z in z^2, log(m) = 2 atanh((m - 1) / (m + 1)) with |z| <= 0.1716
+  // for m in [sqrt(0.5), sqrt(2)).
+  inline constexpr double log_coefficients[10]
+      = { 1.0, 1.0 / 3, 1.0 / 5, 1.0 / 7, 1.0 / 9, 1.0 / 11, 1.0 / 13, 1.0 / 15, 1.0 / 17, 1.0 / 19 };
+
+  // Taylor series of exp(r), |r| <= log(2) / 2.
+  inline constexpr double exp_coefficients[14] = { 1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720,
+    1.0 / 5040, 1.0 / 40320, 1.0 / 362880, 1.0 / 3628800, 1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800.0 };
+
+  // Taylor series of atan(x) / x in x^2, |x| <= tan(pi / 8).
+  inline constexpr double atan_coefficients[20] = { 1.0, -1.0 / 3, 1.0 / 5, -1.0 / 7, 1.0 / 9, -1.0 / 11, 1.0 / 13,
+    -1.0 / 15, 1.0 / 17, -1.0 / 19, 1.0 / 21, -1.0 / 23, 1.0 / 25, -1.0 / 27, 1.0 / 29, -1.0 / 31, 1.0 / 33,
+    -1.0 / 35, 1.0 / 37, -1.0 / 39 };
+
+  inline constexpr double earth_radius = 6378137.0;
+  inline constexpr double pi = 3.14159265358979323846;
+  inline constexpr double web_mercator_max_latitude = 85.0511287798066;
+
+  /// Horner evaluation of the first `N` coefficients, unrolled at compile time so that the
+  /// loops calling it stay innermost for the vectorizer.
+  template <std::size_t N, std::size_t I = 0, typename T>
+  NANO_NODC_INLINE T polynomial(T x, const double* coefficients) NANO_NOEXCEPT {
+    if constexpr (I + 1 == N) {
+      return static_cast<T>(coefficients[I]);
+    }
+    else {
+      return static_cast<T>(coefficients[I]) + x * polynomial<N, I + 1>(x, coefficients);
+    }
+  }
+
+  /// sin(x) for |x| <= pi / 4.
+  template <typename T>
+  NANO_NODC_INLINE T approx_sin(T x) NANO_NOEXCEPT {
+    return x * polynomial<projection_traits<T>::sin_terms>(x * x, sin_coefficients);
+  }
+
+  /// log(x) for a positive normal x.
+  template <typename T>
+  NANO_NODC_INLINE T approx_log(T x) NANO_NOEXCEPT {
+    using traits = projection_traits<T>;
+    using bits_type = typename traits::bits_type;
+    constexpr bits_type mantissa_mask = (bits_type(1) << traits::mantissa_bits) - 1;
+
+    // x = 2^e * m with m in [sqrt(0.5), sqrt(2)), the exponent is picked on the bits. Selecting
+    // on floats would let the compiler move the arithmetic into branches and stop vectorizing.
+    bits_type bits;
+    std::memcpy(&bits, &x, sizeof(T));
+    const bits_type mantissa = bits & mantissa_mask;
+    const bits_type upper = mantissa > traits::sqrt2_mantissa;
+    const std::int32_t e = static_cast<std::int32_t>(bits >> traits::mantissa_bits) - traits::exponent_bias
+        + static_cast<std::int32_t>(upper);
+    bits = mantissa | ((static_cast<bits_type>(traits::exponent_bias) - upper) << traits::mantissa_bits);
+
+    T m;
+    std::memcpy(&m, &bits, sizeof(T));
+
+    const T z = (m - T(1)) / (m + T(1));
+    const T log_m = T(2) * z * polynomial<traits::log_terms>(z * z, log_coefficients);
+    return static_cast<T>(e) * static_cast<T>(0.6931471805599453) + log_m;
+  }
+
+  /// exp(x) for |x| <= 80.
+  template <typename T>
+  NANO_NODC_INLINE T approx_exp(T x) NANO_NOEXCEPT {
+    using traits = projection_traits<T>;
+    using bits_type = typename traits::bits_type;
+
+    // x = n log(2) + r, with n rounded by adding 1.5 2^mantissa_bits which leaves 2^(mantissa_bits - 1) + n
+    // in the mantissa. The constant is split so that n log(2) is exact.
+    constexpr bits_type half = bits_type(1) << (traits::mantissa_bits - 1);
+    constexpr T shifter = static_cast<T>(3 * half);
+    const T shifted = x * static_cast<T>(1.4426950408889634) + shifter;
+    const T n = shifted - shifter;
+    const T r = (x - n * static_cast<T>(0.693145751953125)) - n * static_cast<T>(1.428606820309417e-06);
+
+    // 2^n from the low bits of the shifted value, the exponent bits above are shifted out.
+    bits_type scale_bits;
+    std::memcpy(&scale_bits, &shifted, sizeof(T));
+    scale_bits = (scale_bits + (static_cast<bits_type>(traits::exponent_bias) - half)) << traits::mantissa_bits;
+    T scale;
+    std::memcpy(&scale, &scale_bits, sizeof(T));
+    return scale * polynomial<traits::exp_terms>(r, exp_coefficients);
+  }
+
+  /// atan(x) for |x| <= 1.
+  template <typename T>
+  NANO_NODC_INLINE T approx_atan(T x) NANO_NOEXCEPT {
+    // atan(a) = pi / 4 + atan((a - 1) / (a + 1)) brings a in [tan(pi / 8), 1] to |a| <= tan(pi / 8).
+    // The shift is 0 or 1 from a bit mask, for the same reason as in approx_log().
+    using bits_type = typename projection_traits<T>::bits_type;
+    const T a = std::abs(x);
+    const bits_type shift_bits
+        = projection_traits<T>::one_bits & (bits_type(0) - (a > static_cast<T>(0.41421356237309503)));
+    T shift;
+    std::memcpy(&shift, &shift_bits, sizeof(T));
+    const T r = (a - shift) / (a * shift + T(1));
+    const T result = r * polynomial<projection_traits<T>::atan_terms>(r * r, atan_coefficients)
+        + shift * static_cast<T>(pi / 4);
+    return std::copysign(result, x);
+  }
+
+  /// min(|x|, limit) on the bits, the order of positive floats is the order of their bits. A float
+  /// comparison would be turned into branches with the clamped value propagated as a constant.
+  /// NaN, whose magnitude bits are above the exponent mask, is kept by a bit select.
+  template <typename T>
+  NANO_NODC_INLINE T clamped_magnitude(T x, T limit) NANO_NOEXCEPT {
+    using bits_type = typename projection_traits<T>::bits_type;
+    constexpr bits_type magnitude_mask = ~bits_type(0) >> 1;
+
+    bits_type bits;
+    bits_type limit_bits;
+    std::memcpy(&bits, &x, sizeof(T));
+    std::memcpy(&limit_bits, &limit, sizeof(T));
+    const bits_type magnitude = bits & magnitude_mask;
+    const bits_type nan = bits_type(0) - (magnitude > projection_traits<T>::exponent_mask);
+    bits = (magnitude & nan) | (std::min<bits_type>(magnitude, limit_bits) & ~nan);
+    std::memcpy(&x, &bits, sizeof(T));
+    return x;
+  }
+
+  template <typename T>
+  NANO_NODC_INLINE nano::point<T> web_mercator(const nano::point<T>& p) NANO_NOEXCEPT {
+    // y = atanh(sin(lat)) = log((1 + sin(lat)) / (1 - sin(lat))) / 2, with 1 - sin(lat) = 2 q^2 and
+    // q = sin(pi / 4 - |lat| / 2) to avoid the cancellation near the poles.
+    const T latitude = clamped_magnitude(p.y, static_cast<T>(web_mercator_max_latitude));
+    const T q = approx_sin((T(90) - latitude) * static_cast<T>(pi / 360));
+    const T q2 = q * q;
+
+    // approx_log() works on the bits and turns NaN into a number, latitude - latitude is 0 or NaN.
+    return { p.x * static_cast<T>(earth_radius * pi / 180),
+      std::copysign(static_cast<T>(earth_radius / 2) * approx_log((T(1) - q2) / q2) + (latitude - latitude), p.y) };
+  }
+
+  template <typename T>
+  NANO_NODC_INLINE nano::point<T> web_mercator_inverse(const nano::point<T>& p) NANO_NOEXCEPT {
+    // lat = gd(y / R) = 2 atan(tanh(y / 2R)), on the magnitude so that the exponential is at most 1.
+    const T u = clamped_magnitude(p.y * static_cast<T>(1 / earth_radius), T(40));
+    const T e = approx_exp(-u);
+    return { p.x * static_cast<T>(180 / (earth_radius * pi)),
+      std::copysign(static_cast<T>(360 / pi) * approx_atan((T(1) - e) / (T(1) + e)), p.y) };
+  }
+
+  template <typename T>
+  NANO_NODC_INLINE nano::point<T> equirectangular(const nano::point<T>& p) NANO_NOEXCEPT {
+    return p * static_cast<T>(earth_radius * pi / 180);
+  }
+
+  template <typename T>
+  NANO_NODC_INLINE nano::point<T> equirectangular_inverse(const nano::point<T>& p) NANO_NOEXCEPT {
+    return p * static_cast<T>(180 / (earth_radius * pi));
+  }
+
+  template <typename T, typename Fct>
+  NANO_INLINE void map_points(const nano::point<T>* in, std::size_t count, nano::point<T>* out, Fct&& fct)
+      NANO_NOEXCEPT {
+    for (std::size_t i = 0; i < count; i++) {
+      out[i] = fct(in[i]);
+    }
+  }
+} // namespace detail.
+
+template <typename T>
+void project(map_projection projection, const nano::point<T>* lon_lat, std::size_t count,
+    nano::point<T>* out) NANO_NOEXCEPT {
+  static_assert(std::is_floating_point_v<T>, "nano::project requires a floating point type");
+  NANO_GEOMETRY_TRACE_SCOPE("project", count, count * sizeof(nano::point<T>));
+
+  switch (projection) {
+  case map_projection::web_mercator:
+    detail::map_points(lon_lat, count, out, [](const nano::point<T>& p) { return detail::web_mercator(p); });
+    break;
+
+  case map_projection::equirectangular:
+    detail::map_points(lon_lat, count, out, [](const nano::point<T>& p) { return detail::equirectangular(p); });
+    break;
+  }
+}
+
+template <typename T>
+void project(map_projection projection, const nano::point<T>* lon_lat, std::size_t count,
+    const nano::transform<T>& t, nano::point<T>* out) NANO_NOEXCEPT {
+  static_assert(std::is_floating_point_v<T>, "nano::project requires a floating point type");
+  NANO_GEOMETRY_TRACE_SCOPE("project", count, count * sizeof(nano::point<T>));
+
+  switch (projection) {
+  case map_projection::web_mercator:
+    detail::map_points(lon_lat, count, out,
+        [t](const nano::point<T>& p) { return t.apply(detail::web_mercator(p)); });
+    break;
+
+  case map_projection::equirectangular:
+    detail::map_points(lon_lat, count, out,
+        [t](const nano::point<T>& p) { return t.apply(detail::equirectangular(p)); });
+    break;
+  }
+}
+
+template <typename T>
+void unproject(map_projection projection, const nano::point<T>* points, std::size_t count,
+    nano::point<T>* lon_lat) NANO_NOEXCEPT {
+  static_assert(std::is_floating_point_v<T>, "nano::unproject requires a floating point type");
+  NANO_GEOMETRY_TRACE_SCOPE("unproject", count, count * sizeof(nano::point<T>));
+
+  switch (projection) {
+  case map_projection::web_mercator:
+    detail::map_points(
+        points, count, lon_lat, [](const nano::point<T>& p) { return detail::web_mercator_inverse(p); });
+    break;
+
+  case map_projection::equirectangular:
+    detail::map_points(
+        points, count, lon_lat, [](const nano::point<T>& p) { return detail::equirectangular_inverse(p); });
+    break;
+  }
+}
+
+template <typename T>
+void unproject(map_projection projection, const nano::point<T>* points, std::size_t count,
+    const nano::transform<T>& inverse, nano::point<T>* lon_lat) NANO_NOEXCEPT {
+  static_assert(std::is_floating_point_v<T>, "nano::unproject requires a floating point type");
+  NANO_GEOMETRY_TRACE_SCOPE("unproject", count, count * sizeof(nano::point<T>));
+
+  switch (projection) {
+  case map_projection::web_mercator:
+    detail::map_points(points, count, lon_lat,
+        [inverse](const nano::point<T>& p) { return detail::web_mercator_inverse(inverse.apply(p)); });
+    break;
+
+  case map_projection::equirectangular:
+    detail::map_points(points, count, lon_lat,
+        [inverse](const nano::point<T>& p) { return detail::equirectangular_inverse(inverse.apply(p)); });
+    break;
+  }
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,421 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/rect_index.h
+ * @brief     nano static rect spatial index
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/trace.h>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+namespace detail {
+  /// Edge representation of a rect used for the index nodes.
+  template <typename T>
+  struct index_box {
+    T left, top, right, bottom;
+  };
+
+  template <typename T>
+  NANO_NODC_INLINE_CXPR index_box<T> to_index_box(const nano::rect<T>& r) NANO_NOEXCEPT;
+
+  template <typename T>
+  NANO_NODC_INLINE_CXPR index_box<T> merge_index_box(const index_box<T>& a, const index_box<T>& b) NANO_NOEXCEPT;
+
+  /// Same predicate as rect::intersects (touching edges do not intersect), without
+  /// the subtraction so that it stays monotonic when applied to merged node boxes.
+  template <typename T>
+  NANO_NODC_INLINE_CXPR bool index_box_intersects(const index_box<T>& a, const index_box<T>& b) NANO_NOEXCEPT;
+
+  /// Position of (x, y) along a 16-bit order Hilbert curve.
+  NANO_NODC_INLINE_CXPR std::uint32_t hilbert_index(std::uint32_t x, std::uint32_t y) NANO_NOEXCEPT;
+
+  /// Hilbert value of the rect center mapped on a 16-bit grid covering `bounds`.
+  template <typename T>
+  NANO_NODC_INLINE_CXPR std::uint32_t hilbert_index(const nano::rect<T>& r, const index_box<T>& bounds) NANO_NOEXCEPT;
+
+  /// Number of nodes of a packed tree of `count` items with `node_size` children per node.
+  NANO_NODC_INLINE_CXPR std::size_t packed_node_count(std::size_t count, std::size_t node_size) NANO_NOEXCEPT;
+
+  /// Number of levels of a packed tree of `count` items with `node_size` children per node.
+  NANO_NODC_INLINE_CXPR std::size_t packed_level_count(std::size_t count, std::size_t node_size) NANO_NOEXCEPT;
+
+  /// Visits the subtree of `node` at `level` of a packed tree stored as flat arrays and calls
+  /// `fct(id, rect)` for every item intersecting `rbox`.
+  ///
+  /// `level_offsets[l]` is the position of the first node of level `l` in `nodes`, level 0
+  /// being the one grouping the items.
+  template <typename T, typename Id, typename Offset, typename Fct>
+  NANO_INLINE_CXPR void packed_index_query(const nano::rect<T>* items, const Id* ids, std::size_t count,
+      const index_box<T>* nodes, const Offset* level_offsets, std::size_t node_size, std::size_t level,
+      std::size_t node, const index_box<T>& rbox, Fct& fct);
+} // namespace detail.
+
+template <typename T>
+class rect_index_builder;
+
+template <typename T>
+class shared_rect_index;
+
+/// Static packed R-tree over a set of rects.
+///
+/// Items are sorted along a Hilbert curve and grouped by `node_size` into leaves,
+/// upper levels are stored contiguously so that the tree needs no child pointers.
+/// Queries use the same predicate as rect::intersects, i.e. the result of a query
+/// is exactly the set of items `r` for which `r.intersects(query)` is true.
+///
+/// Item ids are the position of the rects in the input sequence.
+template <typename T>
+class rect_index {
+public:
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using box_type = detail::index_box<value_type>;
+  using id_type = std::uint32_t;
+
+  /// Number of children per node.
+  static constexpr std::size_t node_size = 16;
+
+  rect_index() = default;
+  rect_index(const rect_index&) = default;
+  rect_index(rect_index&&) NANO_NOEXCEPT = default;
+
+  inline rect_index(const rect_type* rects, std::size_t count);
+
+  inline explicit rect_index(const std::vector<rect_type>& rects);
+
+  ~rect_index() = default;
+
+  rect_index& operator=(const rect_index&) = default;
+  rect_index& operator=(rect_index&&) NANO_NOEXCEPT = default;
+
+  /// Rebuilds the index from scratch.
+  inline void build(const rect_type* rects, std::size_t count);
+
+  /// Removes all items.
+  inline void clear() NANO_NOEXCEPT;
+
+  /// Calls `fct(id, rect)` for every item intersecting `r`.
+  template <typename Fct>
+  inline void query(const rect_type& r, Fct&& fct) const;
+
+  /// Appends the id of every item intersecting `r` to `ids`.
+  inline void query(const rect_type& r, std::vector<id_type>& ids) const;
+
+  /// Returns the number of indexed items.
+  NANO_NODC_INLINE std::size_t size() const NANO_NOEXCEPT;
+
+  /// Returns true if the index contains no items.
+  NANO_NODC_INLINE bool empty() const NANO_NOEXCEPT;
+
+  /// Returns the union of all indexed rects.
+  NANO_NODC_INLINE rect_type bounds() const NANO_NOEXCEPT;
+
+  /// Returns the number of node levels above the items.
+  NANO_NODC_INLINE std::size_t levels() const NANO_NOEXCEPT;
+
+private:
+  friend class rect_index_builder<T>;
+  friend class shared_rect_index<T>;
+
+  std::vector<rect_type> _items;
+  std::vector<id_type> _ids;
+  std::vector<box_type> _nodes;
+  std::vector<std::size_t> _level_offsets;
+
+  inline void build_levels();
+};
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+//
+// MARK: - detail -
+//
+
+namespace detail {
+  template <typename T>
+  NANO_INLINE_CXPR index_box<T> to_index_box(const nano::rect<T>& r) NANO_NOEXCEPT {
+    return { r.origin.x, r.origin.y, r.origin.x + r.size.width, r.origin.y + r.size.height };
+  }
+
+  template <typename T>
+  NANO_INLINE_CXPR index_box<T> merge_index_box(const index_box<T>& a, const index_box<T>& b) NANO_NOEXCEPT {
+    return { std::min(a.left, b.left), std::min(a.top, b.top), std::max(a.right, b.right),
+      std::max(a.bottom, b.bottom) };
+  }
+
+  template <typename T>
+  NANO_INLINE_CXPR bool index_box_intersects(const index_box<T>& a, const index_box<T>& b) NANO_NOEXCEPT {
+    return std::min(a.right, b.right) > std::max(a.left, b.left)
+        && std::min(a.bottom, b.bottom) > std::max(a.top, b.top);
+  }
+
+  NANO_INLINE_CXPR std::uint32_t hilbert_index(std::uint32_t x, std::uint32_t y) NANO_NOEXCEPT {
+    constexpr std::uint32_t n = 1u << 16;
+    std::uint32_t d = 0;
+
+    for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+      const std::uint32_t rx = (x & s) ? 1u : 0u;
+      const std::uint32_t ry = (y & s) ? 1u : 0u;
+      d += s * s * ((3u * rx) ^ ry);
+
+      if (ry == 0) {
+        if (rx == 1) {
+          x = n - 1 - x;
+          y = n - 1 - y;
+        }
+
+        std::uint32_t tmp = x;
+        x = y;
+        y = tmp;
+      }
+    }
+
+    return d;
+  }
+
+  template <typename T>
+  NANO_INLINE_CXPR std::uint32_t hilbert_index(const nano::rect<T>& r, const index_box<T>& bounds) NANO_NOEXCEPT {
+    const double w = static_cast<double>(bounds.right) - static_cast<double>(bounds.left);
+    const double h = static_cast<double>(bounds.bottom) - static_cast<double>(bounds.top);
+    const double cx = static_cast<double>(r.origin.x) + static_cast<double>(r.size.width) * 0.5;
+    const double cy = static_cast<double>(r.origin.y) + static_cast<double>(r.size.height) * 0.5;
+    const double nx = w > 0 ? (cx - static_cast<double>(bounds.left)) / w : 0.0;
+    const double ny = h > 0 ? (cy - static_cast<double>(bounds.top)) / h : 0.0;
+    return hilbert_index(static_cast<std::uint32_t>(std::clamp(nx, 0.0, 1.0) * 65535.0),
+        static_cast<std::uint32_t>(std::clamp(ny, 0.0, 1.0) * 65535.0));
+  }
+
+  NANO_INLINE_CXPR std::size_t packed_node_count(std::size_t count, std::size_t node_size) NANO_NOEXCEPT {
+    std::size_t total = 0;
+    std::size_t level_count = count;
+
+    do {
+      level_count = (level_count + node_size - 1) / node_size;
+      total += level_count;
+    } while (level_count > 1);
+
+    return count == 0 ? 0 : total;
+  }
+
+  NANO_INLINE_CXPR std::size_t packed_level_count(std::size_t count, std::size_t node_size) NANO_NOEXCEPT {
+    std::size_t levels = 0;
+    std::size_t level_count = count;
+
+    do {
+      level_count = (level_count + node_size - 1) / node_size;
+      levels++;
+    } while (level_count > 1);
+
+    return count == 0 ? 0 : levels;
+  }
+
+  template <typename T, typename Id, typename Offset, typename Fct>
+  NANO_INLINE_CXPR void packed_index_query(const nano::rect<T>* items, const Id* ids, std::size_t count,
+      const index_box<T>* nodes, const Offset* level_offsets, std::size_t node_size, std::size_t level,
+      std::size_t node, const index_box<T>& rbox, Fct& fct) {
+    if (!index_box_intersects(nodes[static_cast<std::size_t>(level_offsets[level]) + node], rbox)) {
+      return;
+    }
+
+    const std::size_t first = node * node_size;
+
+    if (level == 0) {
+      const std::size_t last = std::min(first + node_size, count);
+
+      for (std::size_t i = first; i < last; i++) {
+        if (index_box_intersects(to_index_box(items[i]), rbox)) {
+          fct(ids[i], items[i]);
+        }
+      }
+
+      return;
+    }
+
+    const std::size_t child_count = static_cast<std::size_t>(level_offsets[level] - level_offsets[level - 1]);
+    const std::size_t last = std::min(first + node_size, child_count);
+
+    for (std::size_t i = first; i < last; i++) {
+      packed_index_query(items, ids, count, nodes, level_offsets, node_size, level - 1, i, rbox, fct);
+    }
+  }
+} // namespace detail.
+
+//
+// MARK: - rect_index -
+//
+
+template <typename T>
+rect_index<T>::rect_index(const rect_type* rects, std::size_t count) {
+  build(rects, count);
+}
+
+template <typename T>
+rect_index<T>::rect_index(const std::vector<rect_type>& rects) {
+  build(rects.data(), rects.size());
+}
+
+template <typename T>
+void rect_index<T>::build(const rect_type* rects, std::size_t count) {
+  NANO_GEOMETRY_TRACE_SCOPE("rect_index::build", count, count * sizeof(rect_type));
+  clear();
+
+  if (count == 0) {
+    return;
+  }
+
+  box_type bounds = detail::to_index_box(rects[0]);
+  for (std::size_t i = 1; i < count; i++) {
+    bounds = detail::merge_index_box(bounds, detail::to_index_box(rects[i]));
+  }
+
+  std::vector<std::pair<std::uint32_t, id_type>> keys(count);
+  for (std::size_t i = 0; i < count; i++) {
+    keys[i] = { detail::hilbert_index(rects[i], bounds), static_cast<id_type>(i) };
+  }
+
+  std::sort(keys.begin(), keys.end());
+
+  _items.resize(count);
+  _ids.resize(count);
+  for (std::size_t i = 0; i < count; i++) {
+    _items[i] = rects[keys[i].second];
+    _ids[i] = keys[i].second;
+  }
+
+  build_levels();
+}
+
+template <typename T>
+void rect_index<T>::build_levels() {
+  // Level 0 groups the items, every following level groups the nodes of the previous one.
+  std::size_t level_count = (_items.size() + node_size - 1) / node_size;
+  _level_offsets.push_back(0);
+  _nodes.reserve(level_count + level_count / (node_size - 1) + 1);
+
+  for (std::size_t i = 0; i < level_count; i++) {
+    const std::size_t first = i * node_size;
+    const std::size_t last = std::min(first + node_size, _items.size());
+    box_type box = detail::to_index_box(_items[first]);
+
+    for (std::size_t k = first + 1; k < last; k++) {
+      box = detail::merge_index_box(box, detail::to_index_box(_items[k]));
+    }
+
+    _nodes.push_back(box);
+  }
+
+  _level_offsets.push_back(_nodes.size());
+
+  while (level_count > 1) {
+    const std::size_t prev_offset = _level_offsets[_level_offsets.size() - 2];
+    const std::size_t prev_count = level_count;
+    level_count = (prev_count + node_size - 1) / node_size;
+
+    for (std::size_t i = 0; i < level_count; i++) {
+      const std::size_t first = prev_offset + i * node_size;
+      const std::size_t last = prev_offset + std::min((i + 1) * node_size, prev_count);
+      box_type box = _nodes[first];
+
+      for (std::size_t k = first + 1; k < last; k++) {
+        box = detail::merge_index_box(box, _nodes[k]);
+      }
+
+      _nodes.push_back(box);
+    }
+
+    _level_offsets.push_back(_nodes.size());
+  }
+}
+
+template <typename T>
+void rect_index<T>::clear() NANO_NOEXCEPT {
+  _items.clear();
+  _ids.clear();
+  _nodes.clear();
+  _level_offsets.clear();
+}
+
+template <typename T>
+template <typename Fct>
+void rect_index<T>::query(const rect_type& r, Fct&& fct) const {
+  if (_items.empty()) {
+    return;
+  }
+
+  const box_type rbox = detail::to_index_box(r);
+  detail::packed_index_query(_items.data(), _ids.data(), _items.size(), _nodes.data(), _level_offsets.data(),
+      node_size, levels() - 1, 0, rbox, fct);
+}
+
+template <typename T>
+void rect_index<T>::query(const rect_type& r, std::vector<id_type>& ids) const {
+  query(r, [&](id_type id, const rect_type&) { ids.push_back(id); });
+}
+
+template <typename T>
+std::size_t rect_index<T>::size() const NANO_NOEXCEPT {
+  return _items.size();
+}
+
+template <typename T>
+bool rect_index<T>::empty() const NANO_NOEXCEPT {
+  return _items.empty();
+}
+
+template <typename T>
+typename rect_index<T>::rect_type rect_index<T>::bounds() const NANO_NOEXCEPT {
+  if (_nodes.empty()) {
+    return { 0, 0, 0, 0 };
+  }
+
+  const box_type& root = _nodes.back();
+  return rect_type::create_from_point({ root.left, root.top }, { root.right, root.bottom });
+}
+
+template <typename T>
+std::size_t rect_index<T>::levels() const NANO_NOEXCEPT {
+  return _level_offsets.empty() ? 0 : _level_offsets.size() - 1;
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
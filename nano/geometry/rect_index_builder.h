@@ -0,0 +1,403 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/rect_index_builder.h
+ * @brief     nano time-sliced rect index construction
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/rect_index.h>
+#include <nano/geometry/trace.h>
+#include <array>
+#include <chrono>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Resumable construction of a rect_index.
+///
+/// Each call to step() performs at most the given time budget of work (give or take
+/// one chunk of `chunk_size` items) and returns once the budget is spent, which lets
+/// a large index be built over several frames. While the build is in progress,
+/// queries fall back to a linear scan of the items. Once the last step completes,
+/// the finished index replaces the fallback in a single move, so a query never sees
+/// a partially built tree.
+///
+/// The resulting index is identical to the one built by rect_index::build().
+/// The builder is not thread safe, step() and query() are meant to be called from
+/// the same thread (e.g. once per frame).
+template <typename T>
+class rect_index_builder {
+public:
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using index_type = nano::rect_index<value_type>;
+  using box_type = typename index_type::box_type;
+  using id_type = typename index_type::id_type;
+  using duration = std::chrono::microseconds;
+
+  /// Number of items processed between two budget checks.
+  static constexpr std::size_t chunk_size = 512;
+
+  rect_index_builder() = default;
+
+  inline explicit rect_index_builder(std::vector<rect_type> rects);
+
+  /// Discards any build in progress and starts a new one over `rects`.
+  inline void reset(std::vector<rect_type> rects);
+
+  /// Resumes the build for at most `budget` and returns true once the index is complete.
+  inline bool step(duration budget);
+
+  /// Completes the build regardless of the time it takes.
+  inline void finish();
+
+  /// Returns true once the index is complete.
+  NANO_NODC_INLINE bool done() const NANO_NOEXCEPT;
+
+  /// Returns the amount of work done in the [0, 1] range.
+  NANO_NODC_INLINE float progress() const NANO_NOEXCEPT;
+
+  /// Returns the finished index (empty until done() is true).
+  NANO_NODC_INLINE const index_type& index() const NANO_NOEXCEPT;
+
+  /// Calls `fct(id, rect)` for every item intersecting `r`, whether the build is complete or not.
+  template <typename Fct>
+  inline void query(const rect_type& r, Fct&& fct) const;
+
+  /// Appends the id of every item intersecting `r` to `ids`.
+  inline void query(const rect_type& r, std::vector<id_type>& ids) const;
+
+private:
+  enum class phase { bounds, keys, histogram, scatter, gather, levels, done };
+
+  static constexpr std::size_t radix_bits = 8;
+  static constexpr std::size_t radix_size = 1 << radix_bits;
+  static constexpr std::size_t radix_passes = 32 / radix_bits;
+
+  std::vector<rect_type> _rects;
+  index_type _index;
+  index_type _staging;
+
+  // Sort state.
+  std::vector<std::uint32_t> _keys;
+  std::vector<std::uint32_t> _keys_tmp;
+  std::vector<id_type> _ids_tmp;
+  std::array<std::size_t, radix_size> _offsets = {};
+  std::size_t _pass = 0;
+
+  // Level state.
+  std::size_t _level = 0;
+
+  box_type _bounds = {};
+  std::size_t _cursor = 0;
+  std::size_t _work_done = 0;
+  std::size_t _work_total = 0;
+  phase _phase = phase::done;
+
+  /// Processes up to `chunk_size` items of the current phase.
+  inline void run_chunk();
+
+  inline void run_levels_chunk();
+
+  inline void next_phase(phase p) NANO_NOEXCEPT;
+};
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+template <typename T>
+rect_index_builder<T>::rect_index_builder(std::vector<rect_type> rects) {
+  reset(std::move(rects));
+}
+
+template <typename T>
+void rect_index_builder<T>::reset(std::vector<rect_type> rects) {
+  _rects = std::move(rects);
+  _index.clear();
+  _staging.clear();
+  _keys.clear();
+  _keys_tmp.clear();
+  _ids_tmp.clear();
+  _pass = 0;
+  _level = 0;
+  _work_done = 0;
+
+  const std::size_t count = _rects.size();
+  const std::size_t level_work = count / (index_type::node_size - 1) + 1;
+  _work_total = count * (3 + 2 * radix_passes) + level_work;
+
+  if (count == 0) {
+    _phase = phase::done;
+    return;
+  }
+
+  _bounds = detail::to_index_box(_rects[0]);
+  next_phase(phase::bounds);
+}
+
+template <typename T>
+bool rect_index_builder<T>::step(duration budget) {
+  NANO_GEOMETRY_TRACE_SCOPE("rect_index_builder::step", _rects.size(), _rects.size() * sizeof(rect_type));
+  using clock = std::chrono::steady_clock;
+  const clock::time_point deadline = clock::now() + budget;
+
+  while (_phase != phase::done) {
+    run_chunk();
+
+    if (clock::now() >= deadline) {
+      break;
+    }
+  }
+
+  return _phase == phase::done;
+}
+
+template <typename T>
+void rect_index_builder<T>::finish() {
+  NANO_GEOMETRY_TRACE_SCOPE("rect_index_builder::finish", _rects.size(), _rects.size() * sizeof(rect_type));
+  while (_phase != phase::done) {
+    run_chunk();
+  }
+}
+
+template <typename T>
+bool rect_index_builder<T>::done() const NANO_NOEXCEPT {
+  return _phase == phase::done;
+}
+
+template <typename T>
+float rect_index_builder<T>::progress() const NANO_NOEXCEPT {
+  if (_phase == phase::done) {
+    return 1.0f;
+  }
+
+  return std::min(static_cast<float>(_work_done) / static_cast<float>(_work_total), 1.0f);
+}
+
+template <typename T>
+const typename rect_index_builder<T>::index_type& rect_index_builder<T>::index() const NANO_NOEXCEPT {
+  return _index;
+}
+
+template <typename T>
+template <typename Fct>
+void rect_index_builder<T>::query(const rect_type& r, Fct&& fct) const {
+  if (_phase == phase::done) {
+    _index.query(r, fct);
+    return;
+  }
+
+  const box_type rbox = detail::to_index_box(r);
+
+  for (std::size_t i = 0; i < _rects.size(); i++) {
+    if (detail::index_box_intersects(detail::to_index_box(_rects[i]), rbox)) {
+      fct(static_cast<id_type>(i), _rects[i]);
+    }
+  }
+}
+
+template <typename T>
+void rect_index_builder<T>::query(const rect_type& r, std::vector<id_type>& ids) const {
+  query(r, [&](id_type id, const rect_type&) { ids.push_back(id); });
+}
+
+template <typename T>
+void rect_index_builder<T>::next_phase(phase p) NANO_NOEXCEPT {
+  _phase = p;
+  _cursor = 0;
+}
+
+template <typename T>
+void rect_index_builder<T>::run_chunk() {
+  if (_phase == phase::levels) {
+    run_levels_chunk();
+    return;
+  }
+
+  const std::size_t count = _rects.size();
+  const std::size_t first = _cursor;
+  const std::size_t last = std::min(first + chunk_size, count);
+  _cursor = last;
+  _work_done += last - first;
+
+  switch (_phase) {
+  case phase::bounds:
+    for (std::size_t i = first; i < last; i++) {
+      _bounds = detail::merge_index_box(_bounds, detail::to_index_box(_rects[i]));
+    }
+
+    if (last == count) {
+      _keys.resize(count);
+      _keys_tmp.resize(count);
+      _ids_tmp.resize(count);
+      _staging._ids.resize(count);
+      next_phase(phase::keys);
+    }
+    break;
+
+  case phase::keys:
+    for (std::size_t i = first; i < last; i++) {
+      _keys[i] = detail::hilbert_index(_rects[i], _bounds);
+      _staging._ids[i] = static_cast<id_type>(i);
+    }
+
+    if (last == count) {
+      _offsets.fill(0);
+      next_phase(phase::histogram);
+    }
+    break;
+
+  // Least significant digit radix sort of the keys, stable so that equal keys stay in id order.
+  case phase::histogram: {
+    const std::size_t shift = _pass * radix_bits;
+    for (std::size_t i = first; i < last; i++) {
+      _offsets[(_keys[i] >> shift) & (radix_size - 1)]++;
+    }
+
+    if (last == count) {
+      std::size_t sum = 0;
+      for (std::size_t& offset : _offsets) {
+        const std::size_t n = offset;
+        offset = sum;
+        sum += n;
+      }
+
+      next_phase(phase::scatter);
+    }
+  } break;
+
+  case phase::scatter: {
+    const std::size_t shift = _pass * radix_bits;
+    for (std::size_t i = first; i < last; i++) {
+      const std::size_t dst = _offsets[(_keys[i] >> shift) & (radix_size - 1)]++;
+      _keys_tmp[dst] = _keys[i];
+      _ids_tmp[dst] = _staging._ids[i];
+    }
+
+    if (last == count) {
+      _keys.swap(_keys_tmp);
+      _staging._ids.swap(_ids_tmp);
+
+      if (++_pass < radix_passes) {
+        _offsets.fill(0);
+        next_phase(phase::histogram);
+      }
+      else {
+        _keys = std::vector<std::uint32_t>();
+        _keys_tmp = std::vector<std::uint32_t>();
+        _ids_tmp = std::vector<id_type>();
+        _staging._items.resize(count);
+        next_phase(phase::gather);
+      }
+    }
+  } break;
+
+  case phase::gather:
+    for (std::size_t i = first; i < last; i++) {
+      _staging._items[i] = _rects[_staging._ids[i]];
+    }
+
+    if (last == count) {
+      _level = 0;
+      _staging._level_offsets.assign(1, 0);
+      next_phase(phase::levels);
+    }
+    break;
+
+  case phase::levels:
+  case phase::done:
+    break;
+  }
+}
+
+template <typename T>
+void rect_index_builder<T>::run_levels_chunk() {
+  constexpr std::size_t node_size = index_type::node_size;
+  std::vector<box_type>& nodes = _staging._nodes;
+  std::vector<std::size_t>& level_offsets = _staging._level_offsets;
+
+  const std::size_t child_count
+      = _level == 0 ? _staging._items.size() : level_offsets[_level] - level_offsets[_level - 1];
+  const std::size_t node_count = (child_count + node_size - 1) / node_size;
+  const std::size_t first = _cursor;
+  const std::size_t last = std::min(first + chunk_size / node_size, node_count);
+
+  for (std::size_t i = first; i < last; i++) {
+    const std::size_t c_first = i * node_size;
+    const std::size_t c_last = std::min(c_first + node_size, child_count);
+    box_type box;
+
+    if (_level == 0) {
+      box = detail::to_index_box(_staging._items[c_first]);
+      for (std::size_t k = c_first + 1; k < c_last; k++) {
+        box = detail::merge_index_box(box, detail::to_index_box(_staging._items[k]));
+      }
+    }
+    else {
+      const std::size_t offset = level_offsets[_level - 1];
+      box = nodes[offset + c_first];
+      for (std::size_t k = c_first + 1; k < c_last; k++) {
+        box = detail::merge_index_box(box, nodes[offset + k]);
+      }
+    }
+
+    nodes.push_back(box);
+  }
+
+  _cursor = last;
+  _work_done += last - first;
+
+  if (last < node_count) {
+    return;
+  }
+
+  level_offsets.push_back(nodes.size());
+  _level++;
+  _cursor = 0;
+
+  if (node_count > 1) {
+    return;
+  }
+
+  _index = std::move(_staging);
+  _staging.clear();
+  _rects = std::vector<rect_type>();
+  _phase = phase::done;
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
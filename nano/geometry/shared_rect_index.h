@@ -0,0 +1,789 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/shared_rect_index.h
+ * @brief     nano relocatable rect index for shared memory
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/rect_index.h>
+#include <nano/geometry/trace.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+  #define NANO_GEOMETRY_HAS_SHARED_MEMORY 1
+#else
+  #define NANO_GEOMETRY_HAS_SHARED_MEMORY 0
+#endif
+
+#if NANO_GEOMETRY_HAS_SHARED_MEMORY
+  #include <string>
+
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Memory layout of a shared_rect_index.
+///
+/// An image is a header followed by four arrays: the items sorted along a Hilbert
+/// curve, their ids, the node boxes level by level and the level offsets. Arrays are
+/// located by byte offsets from the start of the image, so an image can be mapped at
+/// any address, copied or written to a file as is. All values are stored in native
+/// byte order.
+namespace shared_format {
+  inline constexpr char magic[8] = { 'N', 'G', 'S', 'R', 'I', 'D', 'X', '\0' };
+  inline constexpr std::uint32_t version = 1;
+
+  /// Alignment of the image and of every array in it.
+  inline constexpr std::size_t alignment = 64;
+
+  struct header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t value_type;
+    std::uint32_t node_size;
+    std::uint32_t levels;
+    std::uint64_t generation;
+    std::uint64_t count;
+    std::uint64_t node_count;
+    std::uint64_t items_offset;
+    std::uint64_t ids_offset;
+    std::uint64_t nodes_offset;
+    std::uint64_t level_offsets_offset;
+    std::uint64_t total_size;
+  };
+
+  /// Control block of a published index, see shared_rect_index_publisher.
+  struct control {
+    char magic[8];
+    std::atomic<std::uint64_t> generation;
+  };
+
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+      "nano::shared_format::control requires a lock-free std::atomic<std::uint64_t>");
+
+  /// Identifies the coordinate type of an image: its size, whether it is a floating
+  /// point type and whether it is signed.
+  template <typename T>
+  NANO_NODC_INLINE_CXPR std::uint32_t value_type_id() NANO_NOEXCEPT {
+    return static_cast<std::uint32_t>(sizeof(T)) | (std::is_floating_point_v<T> ? 0x100u : 0u)
+        | (std::is_signed_v<T> ? 0x200u : 0u);
+  }
+} // namespace shared_format.
+
+/// Read-only view of a packed rect index stored in a relocatable memory image.
+///
+/// The image is written once by build() into caller provided memory (a POSIX shared
+/// memory segment, a mapped file or a plain buffer) and can then be attached from any
+/// process without deserialization: attach() only validates the header and bounds of
+/// the arrays, queries read the image in place.
+///
+/// The tree has the same layout as rect_index and returns the same results.
+/// The view does not own the memory, which must outlive it and stay unchanged while
+/// attached. Attached views are safe to query from several threads.
+template <typename T>
+class shared_rect_index {
+public:
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using index_type = nano::rect_index<value_type>;
+  using box_type = typename index_type::box_type;
+  using id_type = typename index_type::id_type;
+
+  shared_rect_index() = default;
+
+  /// Number of bytes needed to build an image of `count` items.
+  NANO_NODC_INLINE static std::size_t required_size(std::size_t count) NANO_NOEXCEPT;
+
+  /// Builds an image of `rects` in `memory` and returns false if `size` is smaller than
+  /// required_size(count) or `memory` is not aligned on shared_format::alignment.
+  ///
+  /// The magic of the header is written last, a reader attaching to a partially written
+  /// image is therefore rejected.
+  static inline bool build(
+      void* memory, std::size_t size, const rect_type* rects, std::size_t count, std::uint64_t generation = 0);
+
+  static inline bool build(
+      void* memory, std::size_t size, const std::vector<rect_type>& rects, std::uint64_t generation = 0);
+
+  /// Attaches the view to an image of `size` bytes and returns false if the image is
+  /// not valid for this value type.
+  inline bool attach(const void* memory, std::size_t size) NANO_NOEXCEPT;
+
+  inline void detach() NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE bool is_attached() const NANO_NOEXCEPT;
+
+  /// Calls `fct(id, rect)` for every item intersecting `r`.
+  template <typename Fct>
+  inline void query(const rect_type& r, Fct&& fct) const;
+
+  /// Appends the id of every item intersecting `r` to `ids`.
+  inline void query(const rect_type& r, std::vector<id_type>& ids) const;
+
+  NANO_NODC_INLINE std::size_t size() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE bool empty() const NANO_NOEXCEPT;
+
+  /// Union of all the items (empty rect when empty).
+  NANO_NODC_INLINE rect_type bounds() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE std::size_t levels() const NANO_NOEXCEPT;
+
+  /// Generation given to build().
+  NANO_NODC_INLINE std::uint64_t generation() const NANO_NOEXCEPT;
+
+  /// Start of the attached image.
+  NANO_NODC_INLINE const void* data() const NANO_NOEXCEPT;
+
+private:
+  const shared_format::header* _header = nullptr;
+  const rect_type* _items = nullptr;
+  const id_type* _ids = nullptr;
+  const box_type* _nodes = nullptr;
+  const std::uint64_t* _level_offsets = nullptr;
+
+  struct layout {
+    std::size_t node_count;
+    std::size_t items_offset;
+    std::size_t ids_offset;
+    std::size_t nodes_offset;
+    std::size_t level_offsets_offset;
+    std::size_t total_size;
+  };
+
+  NANO_NODC_INLINE static layout compute_layout(std::size_t count, std::size_t levels) NANO_NOEXCEPT;
+};
+
+#if NANO_GEOMETRY_HAS_SHARED_MEMORY
+
+/// Memory mapping of a POSIX shared memory object or of a file.
+///
+/// Shared memory names follow shm_open(): a leading slash and no other one.
+/// Mappings are shared, a segment stays valid while mapped even after being unlinked.
+class mapped_memory {
+public:
+  mapped_memory() = default;
+
+  mapped_memory(const mapped_memory&) = delete;
+  mapped_memory& operator=(const mapped_memory&) = delete;
+
+  inline mapped_memory(mapped_memory&& other) NANO_NOEXCEPT;
+  inline mapped_memory& operator=(mapped_memory&& other) NANO_NOEXCEPT;
+
+  inline ~mapped_memory();
+
+  /// Creates (or truncates) a read-write shared memory object of `size` bytes.
+  inline bool create_shared(const std::string& name, std::size_t size);
+
+  /// Maps an existing shared memory object, read-only unless `writable`.
+  inline bool open_shared(const std::string& name, bool writable = false);
+
+  /// Creates (or truncates) a read-write file of `size` bytes.
+  inline bool create_file(const std::string& path, std::size_t size);
+
+  /// Maps an existing file, read-only unless `writable`.
+  inline bool open_file(const std::string& path, bool writable = false);
+
+  /// Removes a shared memory object name, existing mappings remain valid.
+  static inline bool unlink_shared(const std::string& name) NANO_NOEXCEPT;
+
+  inline void close() NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE bool is_open() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE void* data() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE std::size_t size() const NANO_NOEXCEPT;
+
+private:
+  void* _data = nullptr;
+  std::size_t _size = 0;
+
+  inline bool map_fd(int fd, std::size_t size, bool writable) NANO_NOEXCEPT;
+  inline bool create_fd(int fd, std::size_t size) NANO_NOEXCEPT;
+  inline bool open_fd(int fd, bool writable) NANO_NOEXCEPT;
+};
+
+/// Publishes successive generations of a shared_rect_index under a name.
+///
+/// Generation `g` is built in its own shared memory object named `<name>.<g>`, then
+/// announced by storing `g` in the control object `<name>` with release semantics.
+/// An image is never modified once announced, so readers switching generations only
+/// ever see complete images. The object of generation `g - 2` is unlinked when `g` is
+/// published: readers still attached to it keep a valid mapping, a reader that missed
+/// two generations simply attaches to the latest one.
+template <typename T>
+class shared_rect_index_publisher {
+public:
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using index_type = nano::shared_rect_index<value_type>;
+
+  inline explicit shared_rect_index_publisher(std::string name);
+
+  shared_rect_index_publisher(const shared_rect_index_publisher&) = delete;
+  shared_rect_index_publisher& operator=(const shared_rect_index_publisher&) = delete;
+
+  /// Builds and announces a new generation, returns false if a segment could not be created.
+  inline bool publish(const rect_type* rects, std::size_t count);
+
+  inline bool publish(const std::vector<rect_type>& rects);
+
+  /// Unlinks the control object and the last two generations.
+  inline void unlink() NANO_NOEXCEPT;
+
+  /// Last published generation, 0 before the first one.
+  NANO_NODC_INLINE std::uint64_t generation() const NANO_NOEXCEPT;
+
+private:
+  std::string _name;
+  mapped_memory _control;
+  std::uint64_t _generation = 0;
+
+  inline bool open_control();
+};
+
+/// Attaches to the latest generation published by a shared_rect_index_publisher.
+template <typename T>
+class shared_rect_index_reader {
+public:
+  using value_type = T;
+  using index_type = nano::shared_rect_index<value_type>;
+
+  inline explicit shared_rect_index_reader(std::string name);
+
+  /// Attaches to the latest generation if it changed and returns true if it did.
+  ///
+  /// On failure the previous generation stays attached.
+  inline bool refresh();
+
+  /// Currently attached index (not attached before the first successful refresh()).
+  NANO_NODC_INLINE const index_type& index() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE std::uint64_t generation() const NANO_NOEXCEPT;
+
+private:
+  std::string _name;
+  mapped_memory _control;
+  mapped_memory _image;
+  index_type _index;
+};
+
+#endif // NANO_GEOMETRY_HAS_SHARED_MEMORY
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+  NANO_INLINE_CXPR std::size_t shared_align(std::size_t value) NANO_NOEXCEPT {
+    return (value + shared_format::alignment - 1) & ~(shared_format::alignment - 1);
+  }
+} // namespace detail.
+
+template <typename T>
+typename shared_rect_index<T>::layout shared_rect_index<T>::compute_layout(
+    std::size_t count, std::size_t levels) NANO_NOEXCEPT {
+  layout l;
+  l.node_count = detail::packed_node_count(count, index_type::node_size);
+  l.items_offset = detail::shared_align(sizeof(shared_format::header));
+  l.ids_offset = detail::shared_align(l.items_offset + count * sizeof(rect_type));
+  l.nodes_offset = detail::shared_align(l.ids_offset + count * sizeof(id_type));
+  l.level_offsets_offset = detail::shared_align(l.nodes_offset + l.node_count * sizeof(box_type));
+  l.total_size = l.level_offsets_offset + (levels + 1) * sizeof(std::uint64_t);
+  return l;
+}
+
+template <typename T>
+std::size_t shared_rect_index<T>::required_size(std::size_t count) NANO_NOEXCEPT {
+  return compute_layout(count, detail::packed_level_count(count, index_type::node_size)).total_size;
+}
+
+template <typename T>
+bool shared_rect_index<T>::build(
+    void* memory, std::size_t size, const rect_type* rects, std::size_t count, std::uint64_t generation) {
+  NANO_GEOMETRY_TRACE_SCOPE("shared_rect_index::build", count, size);
+  if (!memory || reinterpret_cast<std::uintptr_t>(memory) % shared_format::alignment != 0
+      || size < required_size(count)) {
+    return false;
+  }
+
+  const index_type index(rects, count);
+  const layout l = compute_layout(count, index.levels());
+  unsigned char* data = static_cast<unsigned char*>(memory);
+
+  shared_format::header header = {};
+  header.version = shared_format::version;
+  header.value_type = shared_format::value_type_id<value_type>();
+  header.node_size = static_cast<std::uint32_t>(index_type::node_size);
+  header.levels = static_cast<std::uint32_t>(index.levels());
+  header.generation = generation;
+  header.count = count;
+  header.node_count = index._nodes.size();
+  header.items_offset = l.items_offset;
+  header.ids_offset = l.ids_offset;
+  header.nodes_offset = l.nodes_offset;
+  header.level_offsets_offset = l.level_offsets_offset;
+  header.total_size = l.total_size;
+  std::memcpy(data, &header, sizeof(header));
+
+  if (count) {
+    std::memcpy(data + l.items_offset, index._items.data(), count * sizeof(rect_type));
+    std::memcpy(data + l.ids_offset, index._ids.data(), count * sizeof(id_type));
+    std::memcpy(data + l.nodes_offset, index._nodes.data(), index._nodes.size() * sizeof(box_type));
+
+    std::uint64_t* level_offsets = reinterpret_cast<std::uint64_t*>(data + l.level_offsets_offset);
+    for (std::size_t i = 0; i < index._level_offsets.size(); i++) {
+      level_offsets[i] = index._level_offsets[i];
+    }
+  }
+
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(data, shared_format::magic, sizeof(shared_format::magic));
+  return true;
+}
+
+template <typename T>
+bool shared_rect_index<T>::build(
+    void* memory, std::size_t size, const std::vector<rect_type>& rects, std::uint64_t generation) {
+  return build(memory, size, rects.data(), rects.size(), generation);
+}
+
+template <typename T>
+bool shared_rect_index<T>::attach(const void* memory, std::size_t size) NANO_NOEXCEPT {
+  detach();
+
+  if (!memory || size < sizeof(shared_format::header)
+      || reinterpret_cast<std::uintptr_t>(memory) % alignof(shared_format::header) != 0) {
+    return false;
+  }
+
+  const shared_format::header* header = static_cast<const shared_format::header*>(memory);
+
+  if (std::memcmp(header->magic, shared_format::magic, sizeof(shared_format::magic)) != 0) {
+    return false;
+  }
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  if (header->version != shared_format::version || header->value_type != shared_format::value_type_id<value_type>()
+      || header->node_size != index_type::node_size || header->count > size / sizeof(rect_type)) {
+    return false;
+  }
+
+  // Offsets are recomputed rather than trusted, the image must match this layout exactly.
+  const std::size_t count = static_cast<std::size_t>(header->count);
+  const layout l = compute_layout(count, header->levels);
+
+  if (header->levels != detail::packed_level_count(count, index_type::node_size) || l.node_count != header->node_count
+      || l.items_offset != header->items_offset || l.ids_offset != header->ids_offset
+      || l.nodes_offset != header->nodes_offset || l.level_offsets_offset != header->level_offsets_offset
+      || l.total_size != header->total_size || l.total_size > size) {
+    return false;
+  }
+
+  const unsigned char* data = static_cast<const unsigned char*>(memory);
+  const std::uint64_t* level_offsets = reinterpret_cast<const std::uint64_t*>(data + l.level_offsets_offset);
+
+  // Each level must hold exactly the nodes grouping the level below, which also makes the
+  // offsets strictly increasing and leaves a single root node on the top level.
+  std::size_t level_nodes = count;
+  std::uint64_t offset = 0;
+
+  for (std::size_t i = 0; i < header->levels; i++) {
+    level_nodes = (level_nodes + index_type::node_size - 1) / index_type::node_size;
+
+    if (level_offsets[i] != offset || level_offsets[i + 1] - offset != level_nodes) {
+      return false;
+    }
+
+    offset = level_offsets[i + 1];
+  }
+
+  if (offset != l.node_count || (count && level_nodes != 1)) {
+    return false;
+  }
+
+  _header = header;
+  _items = reinterpret_cast<const rect_type*>(data + l.items_offset);
+  _ids = reinterpret_cast<const id_type*>(data + l.ids_offset);
+  _nodes = reinterpret_cast<const box_type*>(data + l.nodes_offset);
+  _level_offsets = level_offsets;
+  return true;
+}
+
+template <typename T>
+void shared_rect_index<T>::detach() NANO_NOEXCEPT {
+  _header = nullptr;
+  _items = nullptr;
+  _ids = nullptr;
+  _nodes = nullptr;
+  _level_offsets = nullptr;
+}
+
+template <typename T>
+bool shared_rect_index<T>::is_attached() const NANO_NOEXCEPT {
+  return _header != nullptr;
+}
+
+template <typename T>
+template <typename Fct>
+void shared_rect_index<T>::query(const rect_type& r, Fct&& fct) const {
+  if (empty()) {
+    return;
+  }
+
+  const box_type rbox = detail::to_index_box(r);
+  detail::packed_index_query(
+      _items, _ids, size(), _nodes, _level_offsets, index_type::node_size, levels() - 1, 0, rbox, fct);
+}
+
+template <typename T>
+void shared_rect_index<T>::query(const rect_type& r, std::vector<id_type>& ids) const {
+  query(r, [&](id_type id, const rect_type&) { ids.push_back(id); });
+}
+
+template <typename T>
+std::size_t shared_rect_index<T>::size() const NANO_NOEXCEPT {
+  return _header ? static_cast<std::size_t>(_header->count) : 0;
+}
+
+template <typename T>
+bool shared_rect_index<T>::empty() const NANO_NOEXCEPT {
+  return size() == 0;
+}
+
+template <typename T>
+typename shared_rect_index<T>::rect_type shared_rect_index<T>::bounds() const NANO_NOEXCEPT {
+  if (empty()) {
+    return rect_type{ 0, 0, 0, 0 };
+  }
+
+  const box_type& root = _nodes[_header->node_count - 1];
+  return rect_type::create_from_point({ root.left, root.top }, { root.right, root.bottom });
+}
+
+template <typename T>
+std::size_t shared_rect_index<T>::levels() const NANO_NOEXCEPT {
+  return _header ? _header->levels : 0;
+}
+
+template <typename T>
+std::uint64_t shared_rect_index<T>::generation() const NANO_NOEXCEPT {
+  return _header ? _header->generation : 0;
+}
+
+template <typename T>
+const void* shared_rect_index<T>::data() const NANO_NOEXCEPT {
+  return _header;
+}
+
+#if NANO_GEOMETRY_HAS_SHARED_MEMORY
+
+//
+// MARK: - mapped_memory -
+//
+
+mapped_memory::mapped_memory(mapped_memory&& other) NANO_NOEXCEPT : _data(other._data),
+                                                                    _size(other._size) {
+  other._data = nullptr;
+  other._size = 0;
+}
+
+mapped_memory& mapped_memory::operator=(mapped_memory&& other) NANO_NOEXCEPT {
+  if (this != &other) {
+    close();
+    _data = other._data;
+    _size = other._size;
+    other._data = nullptr;
+    other._size = 0;
+  }
+
+  return *this;
+}
+
+mapped_memory::~mapped_memory() {
+  close();
+}
+
+bool mapped_memory::create_shared(const std::string& name, std::size_t size) {
+  close();
+  return create_fd(::shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600), size);
+}
+
+bool mapped_memory::open_shared(const std::string& name, bool writable) {
+  close();
+  return open_fd(::shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0), writable);
+}
+
+bool mapped_memory::create_file(const std::string& path, std::size_t size) {
+  close();
+  return create_fd(::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644), size);
+}
+
+bool mapped_memory::open_file(const std::string& path, bool writable) {
+  close();
+  return open_fd(::open(path.c_str(), writable ? O_RDWR : O_RDONLY), writable);
+}
+
+bool mapped_memory::unlink_shared(const std::string& name) NANO_NOEXCEPT {
+  return ::shm_unlink(name.c_str()) == 0;
+}
+
+bool mapped_memory::create_fd(int fd, std::size_t size) NANO_NOEXCEPT {
+  if (fd < 0) {
+    return false;
+  }
+
+  const bool valid = ::ftruncate(fd, static_cast<off_t>(size)) == 0 && map_fd(fd, size, true);
+  ::close(fd);
+  return valid;
+}
+
+bool mapped_memory::open_fd(int fd, bool writable) NANO_NOEXCEPT {
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st = {};
+  const bool valid = ::fstat(fd, &st) == 0 && map_fd(fd, static_cast<std::size_t>(st.st_size), writable);
+  ::close(fd);
+  return valid;
+}
+
+bool mapped_memory::map_fd(int fd, std::size_t size, bool writable) NANO_NOEXCEPT {
+  if (size == 0) {
+    return false;
+  }
+
+  void* map = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+  _data = map;
+  _size = size;
+  return true;
+}
+
+void mapped_memory::close() NANO_NOEXCEPT {
+  if (_data) {
+    ::munmap(_data, _size);
+    _data = nullptr;
+    _size = 0;
+  }
+}
+
+bool mapped_memory::is_open() const NANO_NOEXCEPT {
+  return _data != nullptr;
+}
+
+void* mapped_memory::data() const NANO_NOEXCEPT {
+  return _data;
+}
+
+std::size_t mapped_memory::size() const NANO_NOEXCEPT {
+  return _size;
+}
+
+//
+// MARK: - shared_rect_index_publisher -
+//
+
+namespace detail {
+  inline std::string shared_generation_name(const std::string& name, std::uint64_t generation) {
+    return name + "." + std::to_string(generation);
+  }
+
+  inline std::atomic<std::uint64_t>* shared_control_generation(const mapped_memory& control) NANO_NOEXCEPT {
+    if (!control.is_open() || control.size() < sizeof(shared_format::control)) {
+      return nullptr;
+    }
+
+    shared_format::control* c = static_cast<shared_format::control*>(control.data());
+    if (std::memcmp(c->magic, shared_format::magic, sizeof(shared_format::magic)) != 0) {
+      return nullptr;
+    }
+
+    return &c->generation;
+  }
+} // namespace detail.
+
+template <typename T>
+shared_rect_index_publisher<T>::shared_rect_index_publisher(std::string name)
+    : _name(std::move(name)) {}
+
+template <typename T>
+bool shared_rect_index_publisher<T>::open_control() {
+  if (_control.is_open()) {
+    return true;
+  }
+
+  // Resume after the generation of a previous publisher if the control object exists.
+  if (_control.open_shared(_name, true)) {
+    if (std::atomic<std::uint64_t>* g = detail::shared_control_generation(_control)) {
+      _generation = g->load(std::memory_order_acquire);
+      return true;
+    }
+
+    _control.close();
+  }
+
+  if (!_control.create_shared(_name, sizeof(shared_format::control))) {
+    return false;
+  }
+
+  shared_format::control* c = new (_control.data()) shared_format::control{ {}, { 0 } };
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(c->magic, shared_format::magic, sizeof(shared_format::magic));
+  _generation = 0;
+  return true;
+}
+
+template <typename T>
+bool shared_rect_index_publisher<T>::publish(const rect_type* rects, std::size_t count) {
+  if (!open_control()) {
+    return false;
+  }
+
+  const std::uint64_t next = _generation + 1;
+  const std::string image_name = detail::shared_generation_name(_name, next);
+  const std::size_t size = index_type::required_size(count);
+
+  {
+    mapped_memory image;
+    if (!image.create_shared(image_name, size) || !index_type::build(image.data(), size, rects, count, next)) {
+      mapped_memory::unlink_shared(image_name);
+      return false;
+    }
+  }
+
+  detail::shared_control_generation(_control)->store(next, std::memory_order_release);
+  _generation = next;
+
+  if (next > 2) {
+    mapped_memory::unlink_shared(detail::shared_generation_name(_name, next - 2));
+  }
+
+  return true;
+}
+
+template <typename T>
+bool shared_rect_index_publisher<T>::publish(const std::vector<rect_type>& rects) {
+  return publish(rects.data(), rects.size());
+}
+
+template <typename T>
+void shared_rect_index_publisher<T>::unlink() NANO_NOEXCEPT {
+  if (_generation > 0) {
+    mapped_memory::unlink_shared(detail::shared_generation_name(_name, _generation));
+  }
+
+  if (_generation > 1) {
+    mapped_memory::unlink_shared(detail::shared_generation_name(_name, _generation - 1));
+  }
+
+  _control.close();
+  mapped_memory::unlink_shared(_name);
+  _generation = 0;
+}
+
+template <typename T>
+std::uint64_t shared_rect_index_publisher<T>::generation() const NANO_NOEXCEPT {
+  return _generation;
+}
+
+//
+// MARK: - shared_rect_index_reader -
+//
+
+template <typename T>
+shared_rect_index_reader<T>::shared_rect_index_reader(std::string name)
+    : _name(std::move(name)) {}
+
+template <typename T>
+bool shared_rect_index_reader<T>::refresh() {
+  if (!_control.is_open() && !_control.open_shared(_name)) {
+    return false;
+  }
+
+  const std::atomic<std::uint64_t>* g = detail::shared_control_generation(_control);
+  if (!g) {
+    _control.close();
+    return false;
+  }
+
+  const std::uint64_t generation = g->load(std::memory_order_acquire);
+  if (generation == 0 || generation == _index.generation()) {
+    return false;
+  }
+
+  mapped_memory image;
+  index_type index;
+  if (!image.open_shared(detail::shared_generation_name(_name, generation))
+      || !index.attach(image.data(), image.size()) || index.generation() != generation) {
+    return false;
+  }
+
+  _index = index;
+  _image = std::move(image);
+  return true;
+}
+
+template <typename T>
+const typename shared_rect_index_reader<T>::index_type& shared_rect_index_reader<T>::index() const NANO_NOEXCEPT {
+  return _index;
+}
+
+template <typename T>
+std::uint64_t shared_rect_index_reader<T>::generation() const NANO_NOEXCEPT {
+  return _index.generation();
+}
+
+#endif // NANO_GEOMETRY_HAS_SHARED_MEMORY
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,431 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/simplify.h
+ * @brief     nano polyline simplification
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/trace.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+enum class simplify_method {
+  /// Keeps the vertices farther than the tolerance from the simplified line.
+  /// The tolerance is a distance.
+  douglas_peucker,
+
+  /// Removes the vertices forming the smallest triangles with their neighbors first.
+  /// The tolerance is an area.
+  visvalingam
+};
+
+/// Polyline simplification with reusable working memory.
+///
+/// The first and last points are always kept. Closed polylines (with the first point
+/// repeated at the end) are supported.
+template <typename T>
+class polyline_simplifier {
+public:
+  static_assert(std::is_floating_point_v<T>, "nano::polyline_simplifier requires a floating point type");
+
+  using value_type = T;
+  using point_type = nano::point<value_type>;
+
+  /// Removes the points of `points` that are not needed for `tolerance`, compacting the
+  /// remaining ones at the front in their original order. Returns the new size.
+  inline std::size_t simplify(point_type* points, std::size_t count, value_type tolerance,
+      simplify_method method = simplify_method::douglas_peucker);
+
+  /// Writes the importance of every point: the largest tolerance for which the point is
+  /// kept by simplify() with the same method. The endpoints are infinitely important.
+  ///
+  /// Once computed, simplify_by_importance() gives the simplification at any tolerance
+  /// with a single comparison per point, e.g. to switch zoom levels without running the
+  /// simplification again.
+  inline void compute_importance(const point_type* points, std::size_t count, value_type* importance,
+      simplify_method method = simplify_method::douglas_peucker);
+
+private:
+  struct range {
+    std::size_t first;
+    std::size_t last;
+    value_type cap;
+  };
+
+  std::vector<range> _stack;
+  std::vector<value_type> _importance;
+  std::vector<std::size_t> _prev;
+  std::vector<std::size_t> _next;
+  std::vector<std::size_t> _heap;
+  std::vector<std::size_t> _heap_position;
+  std::vector<value_type> _area;
+
+  inline void douglas_peucker(const point_type* points, std::size_t count, value_type* importance, value_type stop);
+  inline void visvalingam(const point_type* points, std::size_t count, value_type* importance, value_type stop);
+
+  inline void heap_up(std::size_t i) NANO_NOEXCEPT;
+  inline void heap_down(std::size_t i) NANO_NOEXCEPT;
+  inline void heap_swap(std::size_t a, std::size_t b) NANO_NOEXCEPT;
+};
+
+/// Simplifies `points` in place with a temporary polyline_simplifier, returns the new size.
+template <typename T>
+inline std::size_t simplify(nano::point<T>* points, std::size_t count, T tolerance,
+    simplify_method method = simplify_method::douglas_peucker);
+
+/// Copies the points whose importance is above `tolerance` to `out`, returns their count.
+/// `out` can be `points` to compact in place.
+template <typename T>
+inline std::size_t simplify_by_importance(const nano::point<T>* points, const T* importance, std::size_t count,
+    T tolerance, nano::point<T>* out) NANO_NOEXCEPT;
+
+/// Simplifies many polylines in place, in parallel.
+///
+/// Polyline `i` is made of the points in [offsets[i], offsets[i + 1]), `offsets` has
+/// `polyline_count + 1` values. Each polyline is compacted at the start of its own range
+/// and its new size is written to `sizes[i]`. Polylines are handed to the threads in
+/// small groups so that uneven sizes balance out. `thread_count` 0 uses one thread per
+/// hardware thread.
+template <typename T>
+inline void simplify_batch(nano::point<T>* points, const std::size_t* offsets, std::size_t polyline_count,
+    T tolerance, std::size_t* sizes, simplify_method method = simplify_method::douglas_peucker,
+    std::size_t thread_count = 0);
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+  /// Squared distance from `p` to the segment [a, b].
+  template <typename T>
+  NANO_INLINE T segment_distance_squared(
+      const nano::point<T>& p, const nano::point<T>& a, const nano::point<T>& b) NANO_NOEXCEPT {
+    const T dx = b.x - a.x;
+    const T dy = b.y - a.y;
+    const T len2 = dx * dx + dy * dy;
+    T t = len2 > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / len2 : T(0);
+    t = std::clamp(t, T(0), T(1));
+    const T ex = a.x + t * dx - p.x;
+    const T ey = a.y + t * dy - p.y;
+    return ex * ex + ey * ey;
+  }
+
+  /// Area of the triangle (a, b, c).
+  template <typename T>
+  NANO_INLINE T triangle_area(const nano::point<T>& a, const nano::point<T>& b, const nano::point<T>& c) NANO_NOEXCEPT {
+    return std::abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2;
+  }
+
+  /// Number of polylines taken at once by a simplify_batch() thread.
+  inline constexpr std::size_t simplify_batch_grain = 32;
+} // namespace detail.
+
+//
+// MARK: - polyline_simplifier -
+//
+
+// The importance of a point is the distance at which it splits its range, capped by the
+// importance of the point that created the range, so that a point is never kept
+// without its parents. Ranges whose farthest point is within `stop` are not split
+// further and their points keep a zero importance.
+template <typename T>
+void polyline_simplifier<T>::douglas_peucker(
+    const point_type* points, std::size_t count, value_type* importance, value_type stop) {
+  std::fill(importance, importance + count, value_type(0));
+  importance[0] = std::numeric_limits<value_type>::infinity();
+  importance[count - 1] = std::numeric_limits<value_type>::infinity();
+
+  const value_type stop2 = stop * stop;
+  _stack.clear();
+  _stack.push_back({ 0, count - 1, std::numeric_limits<value_type>::infinity() });
+
+  while (!_stack.empty()) {
+    const range r = _stack.back();
+    _stack.pop_back();
+
+    if (r.last - r.first < 2) {
+      continue;
+    }
+
+    value_type max_distance = -1;
+    std::size_t index = r.first + 1;
+
+    for (std::size_t i = r.first + 1; i < r.last; i++) {
+      const value_type d = detail::segment_distance_squared(points[i], points[r.first], points[r.last]);
+      if (d > max_distance) {
+        max_distance = d;
+        index = i;
+      }
+    }
+
+    if (max_distance <= stop2) {
+      continue;
+    }
+
+    const value_type value = std::min(std::sqrt(max_distance), r.cap);
+    importance[index] = value;
+    _stack.push_back({ r.first, index, value });
+    _stack.push_back({ index, r.last, value });
+  }
+}
+
+// The importance of a point is the area of its triangle when it is removed, raised to
+// the largest area removed so far so that it grows monotonically with the removal order.
+// The removal stops at the first area above `stop`, the remaining points keep an
+// infinite importance.
+template <typename T>
+void polyline_simplifier<T>::visvalingam(
+    const point_type* points, std::size_t count, value_type* importance, value_type stop) {
+  std::fill(importance, importance + count, std::numeric_limits<value_type>::infinity());
+
+  _prev.resize(count);
+  _next.resize(count);
+  _area.resize(count);
+  _heap.clear();
+  _heap_position.assign(count, 0);
+
+  for (std::size_t i = 0; i < count; i++) {
+    _prev[i] = i - 1;
+    _next[i] = i + 1;
+  }
+
+  for (std::size_t i = 1; i + 1 < count; i++) {
+    _area[i] = detail::triangle_area(points[i - 1], points[i], points[i + 1]);
+    _heap_position[i] = _heap.size();
+    _heap.push_back(i);
+    heap_up(_heap.size() - 1);
+  }
+
+  value_type max_area = 0;
+
+  while (!_heap.empty()) {
+    const std::size_t i = _heap[0];
+    if (_area[i] > stop) {
+      break;
+    }
+
+    max_area = std::max(max_area, _area[i]);
+    importance[i] = max_area;
+
+    heap_swap(0, _heap.size() - 1);
+    _heap.pop_back();
+    if (!_heap.empty()) {
+      heap_down(0);
+    }
+
+    const std::size_t p = _prev[i];
+    const std::size_t n = _next[i];
+    _next[p] = n;
+    _prev[n] = p;
+
+    // Recompute the neighbors, the endpoints are not in the heap.
+    const std::size_t neighbors[2] = { p, n };
+    for (const std::size_t k : neighbors) {
+      if (k == 0 || k == count - 1) {
+        continue;
+      }
+
+      const value_type previous = _area[k];
+      _area[k] = detail::triangle_area(points[_prev[k]], points[k], points[_next[k]]);
+
+      if (_area[k] < previous) {
+        heap_up(_heap_position[k]);
+      }
+      else {
+        heap_down(_heap_position[k]);
+      }
+    }
+  }
+}
+
+template <typename T>
+void polyline_simplifier<T>::heap_swap(std::size_t a, std::size_t b) NANO_NOEXCEPT {
+  std::swap(_heap[a], _heap[b]);
+  _heap_position[_heap[a]] = a;
+  _heap_position[_heap[b]] = b;
+}
+
+// Ties are broken by position so that the removal order does not depend on the heap layout.
+template <typename T>
+void polyline_simplifier<T>::heap_up(std::size_t i) NANO_NOEXCEPT {
+  while (i > 0) {
+    const std::size_t parent = (i - 1) / 2;
+    const std::size_t a = _heap[i];
+    const std::size_t b = _heap[parent];
+
+    if (_area[b] < _area[a] || (_area[b] == _area[a] && b < a)) {
+      break;
+    }
+
+    heap_swap(i, parent);
+    i = parent;
+  }
+}
+
+template <typename T>
+void polyline_simplifier<T>::heap_down(std::size_t i) NANO_NOEXCEPT {
+  const std::size_t size = _heap.size();
+
+  for (;;) {
+    std::size_t smallest = i;
+    for (std::size_t child = 2 * i + 1; child <= 2 * i + 2 && child < size; child++) {
+      const std::size_t a = _heap[child];
+      const std::size_t b = _heap[smallest];
+
+      if (_area[a] < _area[b] || (_area[a] == _area[b] && a < b)) {
+        smallest = child;
+      }
+    }
+
+    if (smallest == i) {
+      return;
+    }
+
+    heap_swap(i, smallest);
+    i = smallest;
+  }
+}
+
+template <typename T>
+std::size_t polyline_simplifier<T>::simplify(
+    point_type* points, std::size_t count, value_type tolerance, simplify_method method) {
+  NANO_GEOMETRY_TRACE_SCOPE("polyline_simplifier::simplify", count, count * sizeof(point_type));
+  if (count < 3) {
+    return count;
+  }
+
+  _importance.resize(count);
+
+  if (method == simplify_method::douglas_peucker) {
+    douglas_peucker(points, count, _importance.data(), std::max(tolerance, value_type(0)));
+  }
+  else {
+    visvalingam(points, count, _importance.data(), tolerance);
+  }
+
+  return simplify_by_importance(points, _importance.data(), count, tolerance, points);
+}
+
+template <typename T>
+void polyline_simplifier<T>::compute_importance(
+    const point_type* points, std::size_t count, value_type* importance, simplify_method method) {
+  if (count < 3) {
+    std::fill(importance, importance + count, std::numeric_limits<value_type>::infinity());
+    return;
+  }
+
+  if (method == simplify_method::douglas_peucker) {
+    douglas_peucker(points, count, importance, 0);
+  }
+  else {
+    visvalingam(points, count, importance, std::numeric_limits<value_type>::infinity());
+  }
+}
+
+//
+// MARK: - Free functions -
+//
+
+template <typename T>
+std::size_t simplify(nano::point<T>* points, std::size_t count, T tolerance, simplify_method method) {
+  polyline_simplifier<T> simplifier;
+  return simplifier.simplify(points, count, tolerance, method);
+}
+
+template <typename T>
+std::size_t simplify_by_importance(const nano::point<T>* points, const T* importance, std::size_t count,
+    T tolerance, nano::point<T>* out) NANO_NOEXCEPT {
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < count; i++) {
+    if (importance[i] > tolerance) {
+      out[n++] = points[i];
+    }
+  }
+
+  return n;
+}
+
+template <typename T>
+void simplify_batch(nano::point<T>* points, const std::size_t* offsets, std::size_t polyline_count, T tolerance,
+    std::size_t* sizes, simplify_method method, std::size_t thread_count) {
+  NANO_GEOMETRY_TRACE_SCOPE(
+      "simplify_batch", polyline_count, (offsets[polyline_count] - offsets[0]) * sizeof(nano::point<T>));
+  if (thread_count == 0) {
+    thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  const std::size_t group_count = (polyline_count + detail::simplify_batch_grain - 1) / detail::simplify_batch_grain;
+  thread_count = std::min(thread_count, group_count);
+
+  std::atomic<std::size_t> next_group = 0;
+
+  const auto work = [&]() {
+    polyline_simplifier<T> simplifier;
+
+    for (;;) {
+      const std::size_t first = next_group.fetch_add(1, std::memory_order_relaxed) * detail::simplify_batch_grain;
+      if (first >= polyline_count) {
+        return;
+      }
+
+      const std::size_t last = std::min(first + detail::simplify_batch_grain, polyline_count);
+      for (std::size_t i = first; i < last; i++) {
+        sizes[i] = simplifier.simplify(points + offsets[i], offsets[i + 1] - offsets[i], tolerance, method);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < thread_count; i++) {
+    threads.emplace_back(work);
+  }
+
+  work();
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,319 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/static_rect_index.h
+ * @brief     nano compile-time packed R-tree
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/rect_index.h>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Packed R-tree over a fixed number of rects, built by a constexpr constructor.
+///
+/// Same layout and query semantics as rect_index (Hilbert sorted items, flat node
+/// levels, rect::intersects predicate) but stored in std::arrays, so that a layout known
+/// at compile time can be indexed by a constexpr variable: there is no work at startup
+/// and the tree lives in read-only memory.
+///
+/// \code
+/// constexpr std::array<nano::rect<float>, 3> layout = { { { 0, 0, 100, 30 }, ... } };
+/// constexpr nano::static_rect_index index(layout);
+/// static_assert(index.hit_test({ 10, 10 }) == 0);
+/// \endcode
+///
+/// The build sorts with a heap sort, compile time grows as N log N. Item ids are the
+/// position of the rects in the input array.
+template <typename T, std::size_t N, std::size_t NodeSize = 16>
+class static_rect_index {
+public:
+  static_assert(NodeSize >= 2, "nano::static_rect_index requires at least two children per node");
+
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using point_type = nano::point<value_type>;
+  using box_type = detail::index_box<value_type>;
+  using id_type = std::uint32_t;
+
+  /// Number of children per node.
+  static constexpr std::size_t node_size = NodeSize;
+
+  /// Number of nodes of all levels.
+  static constexpr std::size_t node_count = detail::packed_node_count(N, NodeSize);
+
+  /// Number of node levels above the items.
+  static constexpr std::size_t level_count = detail::packed_level_count(N, NodeSize);
+
+  /// Returned by hit_test() when no item contains the point.
+  static constexpr id_type no_id = std::numeric_limits<id_type>::max();
+
+  NANO_INLINE_CXPR explicit static_rect_index(const std::array<rect_type, N>& rects) NANO_NOEXCEPT;
+
+  /// Calls `fct(id, rect)` for every item intersecting `r`.
+  template <typename Fct>
+  NANO_INLINE_CXPR void query(const rect_type& r, Fct&& fct) const;
+
+  /// Calls `fct(id, rect)` for every item containing `p` (rect::contains, edges included).
+  template <typename Fct>
+  NANO_INLINE_CXPR void query(const point_type& p, Fct&& fct) const;
+
+  /// Returns the number of items intersecting `r`.
+  NANO_NODC_INLINE_CXPR std::size_t count(const rect_type& r) const NANO_NOEXCEPT;
+
+  /// Returns the highest id of the items containing `p`, i.e. the top-most widget when ids
+  /// follow the drawing order, or no_id.
+  NANO_NODC_INLINE_CXPR id_type hit_test(const point_type& p) const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE_CXPR std::size_t size() const NANO_NOEXCEPT { return N; }
+
+  NANO_NODC_INLINE_CXPR bool empty() const NANO_NOEXCEPT { return N == 0; }
+
+  /// Returns the union of all indexed rects.
+  NANO_NODC_INLINE_CXPR rect_type bounds() const NANO_NOEXCEPT;
+
+private:
+  std::array<rect_type, N> _items = {};
+  std::array<id_type, N> _ids = {};
+  std::array<box_type, node_count> _nodes = {};
+  std::array<std::size_t, level_count + 1> _level_offsets = {};
+
+  template <typename Fct>
+  NANO_INLINE_CXPR void query_point(std::size_t level, std::size_t node, const point_type& p, Fct& fct) const;
+};
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+namespace detail {
+  struct static_index_key {
+    std::uint32_t hilbert;
+    std::uint32_t id;
+
+    NANO_NODC_INLINE_CXPR bool operator<(const static_index_key& k) const NANO_NOEXCEPT {
+      return hilbert < k.hilbert || (hilbert == k.hilbert && id < k.id);
+    }
+  };
+
+  template <typename Key, std::size_t N>
+  NANO_INLINE_CXPR void static_index_sift_down(
+      std::array<Key, N>& keys, std::size_t i, std::size_t count) NANO_NOEXCEPT {
+    for (std::size_t child = 2 * i + 1; child < count; child = 2 * i + 1) {
+      if (child + 1 < count && keys[child] < keys[child + 1]) {
+        child++;
+      }
+
+      if (!(keys[i] < keys[child])) {
+        return;
+      }
+
+      const Key tmp = keys[i];
+      keys[i] = keys[child];
+      keys[child] = tmp;
+      i = child;
+    }
+  }
+
+  /// std::sort is not constexpr before C++20.
+  template <typename Key, std::size_t N>
+  NANO_INLINE_CXPR void static_index_sort(std::array<Key, N>& keys) NANO_NOEXCEPT {
+    for (std::size_t i = N / 2; i-- > 0;) {
+      static_index_sift_down(keys, i, N);
+    }
+
+    for (std::size_t last = N; last-- > 1;) {
+      const Key tmp = keys[0];
+      keys[0] = keys[last];
+      keys[last] = tmp;
+      static_index_sift_down(keys, 0, last);
+    }
+  }
+
+  /// Same as rect::contains, which can not be evaluated at compile time (it reads the
+  /// rect through its x, y, width and height union members).
+  template <typename T>
+  NANO_INLINE_CXPR bool index_box_contains(const index_box<T>& b, const nano::point<T>& p) NANO_NOEXCEPT {
+    return p.x >= b.left && p.x <= b.right && p.y >= b.top && p.y <= b.bottom;
+  }
+} // namespace detail.
+
+//
+// MARK: - static_rect_index -
+//
+
+template <typename T, std::size_t N, std::size_t NodeSize>
+NANO_INLINE_CXPR static_rect_index<T, N, NodeSize>::static_rect_index(
+    const std::array<rect_type, N>& rects) NANO_NOEXCEPT {
+  static_assert(N <= no_id, "nano::static_rect_index ids are 32-bit");
+
+  if constexpr (N > 0) {
+    box_type bounds = detail::to_index_box(rects[0]);
+    for (std::size_t i = 1; i < N; i++) {
+      bounds = detail::merge_index_box(bounds, detail::to_index_box(rects[i]));
+    }
+
+    std::array<detail::static_index_key, N> keys = {};
+    for (std::size_t i = 0; i < N; i++) {
+      keys[i] = { detail::hilbert_index(rects[i], bounds), static_cast<id_type>(i) };
+    }
+
+    detail::static_index_sort(keys);
+
+    for (std::size_t i = 0; i < N; i++) {
+      _ids[i] = keys[i].id;
+      _items[i] = rects[keys[i].id];
+    }
+
+    // Level 0 groups the items, every following level groups the nodes of the previous one.
+    std::size_t level_size = (N + NodeSize - 1) / NodeSize;
+    std::size_t offset = 0;
+
+    for (std::size_t i = 0; i < level_size; i++) {
+      const std::size_t first = i * NodeSize;
+      const std::size_t last = std::min(first + NodeSize, N);
+      box_type box = detail::to_index_box(_items[first]);
+
+      for (std::size_t k = first + 1; k < last; k++) {
+        box = detail::merge_index_box(box, detail::to_index_box(_items[k]));
+      }
+
+      _nodes[offset++] = box;
+    }
+
+    for (std::size_t level = 1; level <= level_count; level++) {
+      _level_offsets[level] = offset;
+
+      if (level == level_count) {
+        break;
+      }
+
+      const std::size_t prev_offset = _level_offsets[level - 1];
+      const std::size_t prev_size = level_size;
+      level_size = (prev_size + NodeSize - 1) / NodeSize;
+
+      for (std::size_t i = 0; i < level_size; i++) {
+        const std::size_t first = prev_offset + i * NodeSize;
+        const std::size_t last = prev_offset + std::min((i + 1) * NodeSize, prev_size);
+        box_type box = _nodes[first];
+
+        for (std::size_t k = first + 1; k < last; k++) {
+          box = detail::merge_index_box(box, _nodes[k]);
+        }
+
+        _nodes[offset++] = box;
+      }
+    }
+  }
+}
+
+template <typename T, std::size_t N, std::size_t NodeSize>
+template <typename Fct>
+NANO_INLINE_CXPR void static_rect_index<T, N, NodeSize>::query(const rect_type& r, Fct&& fct) const {
+  if constexpr (N > 0) {
+    detail::packed_index_query(_items.data(), _ids.data(), N, _nodes.data(), _level_offsets.data(), NodeSize,
+        level_count - 1, 0, detail::to_index_box(r), fct);
+  }
+}
+
+template <typename T, std::size_t N, std::size_t NodeSize>
+template <typename Fct>
+NANO_INLINE_CXPR void static_rect_index<T, N, NodeSize>::query(const point_type& p, Fct&& fct) const {
+  if constexpr (N > 0) {
+    query_point(level_count - 1, 0, p, fct);
+  }
+}
+
+template <typename T, std::size_t N, std::size_t NodeSize>
+template <typename Fct>
+NANO_INLINE_CXPR void static_rect_index<T, N, NodeSize>::query_point(
+    std::size_t level, std::size_t node, const point_type& p, Fct& fct) const {
+  if (!detail::index_box_contains(_nodes[_level_offsets[level] + node], p)) {
+    return;
+  }
+
+  const std::size_t first = node * NodeSize;
+
+  if (level == 0) {
+    const std::size_t last = std::min(first + NodeSize, N);
+
+    for (std::size_t i = first; i < last; i++) {
+      if (detail::index_box_contains(detail::to_index_box(_items[i]), p)) {
+        fct(_ids[i], _items[i]);
+      }
+    }
+
+    return;
+  }
+
+  const std::size_t child_count = _level_offsets[level] - _level_offsets[level - 1];
+  const std::size_t last = std::min(first + NodeSize, child_count);
+
+  for (std::size_t i = first; i < last; i++) {
+    query_point(level - 1, i, p, fct);
+  }
+}
+
+template <typename T, std::size_t N, std::size_t NodeSize>
+NANO_INLINE_CXPR std::size_t static_rect_index<T, N, NodeSize>::count(const rect_type& r) const NANO_NOEXCEPT {
+  std::size_t n = 0;
+  query(r, [&n](id_type, const rect_type&) { n++; });
+  return n;
+}
+
+template <typename T, std::size_t N, std::size_t NodeSize>
+NANO_INLINE_CXPR typename static_rect_index<T, N, NodeSize>::id_type static_rect_index<T, N, NodeSize>::hit_test(
+    const point_type& p) const NANO_NOEXCEPT {
+  id_type top = no_id;
+  query(p, [&top](id_type id, const rect_type&) { top = top == no_id || id > top ? id : top; });
+  return top;
+}
+
+template <typename T, std::size_t N, std::size_t NodeSize>
+NANO_INLINE_CXPR typename static_rect_index<T, N, NodeSize>::rect_type
+static_rect_index<T, N, NodeSize>::bounds() const NANO_NOEXCEPT {
+  if constexpr (N == 0) {
+    return { 0, 0, 0, 0 };
+  }
+  else {
+    const box_type& root = _nodes[node_count - 1];
+    return rect_type::create_from_point({ root.left, root.top }, { root.right, root.bottom });
+  }
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
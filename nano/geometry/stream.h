@@ -0,0 +1,68 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/stream.h
+ * @brief     nano geometry stream operators
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <ostream>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+// The operator<< overloads are kept out of nano/geometry.h so that including it does
+// not require <ostream>. nano/geometry.h still includes this header unless
+// NANO_GEOMETRY_STREAM_OPERATORS is 0.
+
+namespace nano {
+template <typename T>
+NANO_INLINE std::ostream& operator<<(std::ostream& s, const nano::point<T>& point) {
+  return s << '{' << point.x << ',' << point.y << '}';
+}
+
+template <typename T>
+NANO_INLINE std::ostream& operator<<(std::ostream& s, const nano::size<T>& size) {
+  return s << '{' << size.width << ',' << size.height << '}';
+}
+
+template <typename T>
+NANO_INLINE std::ostream& operator<<(std::ostream& s, const nano::rect<T>& rect) {
+  return s << '{' << rect.x << ',' << rect.y << ',' << rect.width << ',' << rect.height << '}';
+}
+
+template <class T>
+NANO_INLINE std::ostream& operator<<(std::ostream& s, const range<T>& r) {
+  return s << '{' << r.start << ',' << r.end << '}';
+}
+
+template <typename T>
+NANO_INLINE std::ostream& operator<<(std::ostream& s, const padding<T>& p) {
+  return s << '{' << p.top << ',' << p.left << ',' << p.bottom << ',' << p.right << '}';
+}
+
+template <typename T>
+NANO_INLINE std::ostream& operator<<(std::ostream& s, const quad<T>& q) {
+  return s << "[{" << q.top_left << "}, {" << q.top_right << "}, {" << q.bottom_right << "}, {" << q.bottom_left
+           << "}]";
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,418 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/stroke.h
+ * @brief     nano polyline stroking
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/trace.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Shape of the outer corner between two segments.
+enum class line_join { miter, bevel, round };
+
+/// Shape of the ends of an open polyline.
+enum class line_cap { butt, square, round };
+
+template <typename T>
+struct stroke_style {
+  /// Full width of the stroke, in the units of the points.
+  T width = 1;
+
+  line_join join = line_join::miter;
+
+  line_cap cap = line_cap::butt;
+
+  /// Miter joins longer than `miter_limit * width / 2` become bevels.
+  T miter_limit = 4;
+
+  /// Maximum distance between the round joins and caps and their arc, in output units.
+  T tolerance = T(0.25);
+
+  /// Connects the last point to the first one with a join instead of caps.
+  bool closed = false;
+
+  /// Applied to every vertex when not null, the width scales with it.
+  const nano::transform<T>* transform = nullptr;
+};
+
+/// Exact number of vertices written by stroke() for the same arguments.
+///
+/// When `bounds` is not null, it receives the bounds of the stroke so that it can be
+/// culled before being emitted, {0, 0, 0, 0} when empty.
+template <typename T>
+inline std::size_t stroke_vertex_count(const nano::point<T>* points, std::size_t count, const stroke_style<T>& style,
+    nano::rect<T>* bounds = nullptr) NANO_NOEXCEPT;
+
+/// Expands a polyline into a triangle strip written to `vertices`.
+///
+/// `vertices` must have room for stroke_vertex_count() vertices. Consecutive duplicate
+/// points are skipped. Joins are emitted as fans around the shared point and separated
+/// from the segments by degenerate triangles, so the whole stroke is a single strip.
+/// The inner side of a join overlaps itself, translucent strokes should be rendered
+/// with a stencil or an opaque intermediate target.
+///
+/// Returns the number of vertices written, 0 if the polyline has no non-empty segment.
+template <typename T>
+inline std::size_t stroke(const nano::point<T>* points, std::size_t count, const stroke_style<T>& style,
+    nano::point<T>* vertices, nano::rect<T>* bounds = nullptr) NANO_NOEXCEPT;
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+  /// Number of segment directions computed before being joined.
+  inline constexpr std::size_t stroke_chunk_size = 256;
+
+  // Unit direction and length of the segments [a[i], b[i]], zero for empty segments.
+  // Branch-free so that it vectorizes.
+  template <typename T>
+  NANO_INLINE void stroke_directions(
+      const nano::point<T>* a, const nano::point<T>* b, std::size_t n, T* dx, T* dy, T* length) NANO_NOEXCEPT {
+    for (std::size_t i = 0; i < n; i++) {
+      const T ex = b[i].x - a[i].x;
+      const T ey = b[i].y - a[i].y;
+      const T len = std::sqrt(ex * ex + ey * ey);
+      const T inv = len > 0 ? T(1) / len : T(0);
+      dx[i] = ex * inv;
+      dy[i] = ey * inv;
+      length[i] = len;
+    }
+  }
+
+  // Counting and writing share this code path so that the vertex count is exact.
+  template <typename T>
+  class stroker {
+  public:
+    inline stroker(const stroke_style<T>& style, nano::point<T>* out) NANO_NOEXCEPT;
+
+    inline std::size_t run(const nano::point<T>* points, std::size_t count, nano::rect<T>* bounds) NANO_NOEXCEPT;
+
+  private:
+    const stroke_style<T>& _style;
+    nano::point<T>* _out;
+    std::size_t _count = 0;
+    T _half_width;
+    T _tolerance;
+    T _max_angle;
+    T _left = std::numeric_limits<T>::max();
+    T _top = std::numeric_limits<T>::max();
+    T _right = std::numeric_limits<T>::lowest();
+    T _bottom = std::numeric_limits<T>::lowest();
+
+    inline void push(T x, T y) NANO_NOEXCEPT;
+    inline void pair(const nano::point<T>& p, T dx, T dy) NANO_NOEXCEPT;
+    inline void start(const nano::point<T>& p, T dx, T dy) NANO_NOEXCEPT;
+    inline void finish(const nano::point<T>& p, T dx, T dy) NANO_NOEXCEPT;
+    inline void join(const nano::point<T>& p, T adx, T ady, T bdx, T bdy) NANO_NOEXCEPT;
+    inline void round_cap_pairs(const nano::point<T>& p, T dx, T dy, bool at_end) NANO_NOEXCEPT;
+    inline std::size_t arc_steps(T angle) const NANO_NOEXCEPT;
+  };
+
+  template <typename T>
+  stroker<T>::stroker(const stroke_style<T>& style, nano::point<T>* out) NANO_NOEXCEPT : _style(style),
+                                                                                       _out(out) {
+    _half_width = style.width / 2;
+
+    // The tolerance is given in output units, bring it back to the units of the points.
+    _tolerance = style.tolerance;
+    if (style.transform) {
+      const nano::transform<T>& t = *style.transform;
+      const T scale = std::sqrt(std::abs(t.a * t.d - t.b * t.c));
+      _tolerance = scale > 0 ? _tolerance / scale : _tolerance;
+    }
+
+    // Largest angle of an arc step keeping the chord within the tolerance.
+    _max_angle = _tolerance > 0 && _tolerance < _half_width ? 2 * std::acos(1 - _tolerance / _half_width)
+                                                            : T(3.14159265358979323846);
+  }
+
+  template <typename T>
+  void stroker<T>::push(T x, T y) NANO_NOEXCEPT {
+    if (_style.transform) {
+      const nano::transform<T>& t = *_style.transform;
+      const T tx = t.a * x + t.c * y + t.tx;
+      y = t.b * x + t.d * y + t.ty;
+      x = tx;
+    }
+
+    _left = std::min(_left, x);
+    _top = std::min(_top, y);
+    _right = std::max(_right, x);
+    _bottom = std::max(_bottom, y);
+
+    if (_out) {
+      _out[_count] = { x, y };
+    }
+
+    _count++;
+  }
+
+  // Left and right offsets of `p`, the left normal of (dx, dy) is (-dy, dx).
+  template <typename T>
+  void stroker<T>::pair(const nano::point<T>& p, T dx, T dy) NANO_NOEXCEPT {
+    push(p.x - dy * _half_width, p.y + dx * _half_width);
+    push(p.x + dy * _half_width, p.y - dx * _half_width);
+  }
+
+  template <typename T>
+  std::size_t stroker<T>::arc_steps(T angle) const NANO_NOEXCEPT {
+    return std::max(std::size_t(1), static_cast<std::size_t>(std::ceil(angle / _max_angle)));
+  }
+
+  // Pairs of a half circle cap from the tip to the sides, excluding both.
+  template <typename T>
+  void stroker<T>::round_cap_pairs(const nano::point<T>& p, T dx, T dy, bool at_end) NANO_NOEXCEPT {
+    const std::size_t steps = arc_steps(T(3.14159265358979323846) / 2);
+    const T forward = at_end ? _half_width : -_half_width;
+
+    for (std::size_t k = 1; k < steps; k++) {
+      const std::size_t i = at_end ? steps - k : k;
+      const T alpha = T(3.14159265358979323846) / 2 * static_cast<T>(i) / static_cast<T>(steps);
+      const T c = std::cos(alpha) * forward;
+      const T s = std::sin(alpha) * _half_width;
+      push(p.x + c * dx - s * dy, p.y + c * dy + s * dx);
+      push(p.x + c * dx + s * dy, p.y + c * dy - s * dx);
+    }
+  }
+
+  template <typename T>
+  void stroker<T>::start(const nano::point<T>& p, T dx, T dy) NANO_NOEXCEPT {
+    switch (_style.cap) {
+    case line_cap::butt:
+      pair(p, dx, dy);
+      break;
+
+    case line_cap::square:
+      pair({ p.x - dx * _half_width, p.y - dy * _half_width }, dx, dy);
+      break;
+
+    case line_cap::round:
+      push(p.x - dx * _half_width, p.y - dy * _half_width);
+      round_cap_pairs(p, dx, dy, false);
+      pair(p, dx, dy);
+      break;
+    }
+  }
+
+  template <typename T>
+  void stroker<T>::finish(const nano::point<T>& p, T dx, T dy) NANO_NOEXCEPT {
+    switch (_style.cap) {
+    case line_cap::butt:
+      pair(p, dx, dy);
+      break;
+
+    case line_cap::square:
+      pair({ p.x + dx * _half_width, p.y + dy * _half_width }, dx, dy);
+      break;
+
+    case line_cap::round:
+      pair(p, dx, dy);
+      round_cap_pairs(p, dx, dy, true);
+      push(p.x + dx * _half_width, p.y + dy * _half_width);
+      break;
+    }
+  }
+
+  // Ends the incoming segment, fans the outer corner around `p` (p, w0, p, w1, ...),
+  // then starts the outgoing segment. Every transition is a degenerate triangle.
+  template <typename T>
+  void stroker<T>::join(const nano::point<T>& p, T adx, T ady, T bdx, T bdy) NANO_NOEXCEPT {
+    const T cross = adx * bdy - ady * bdx;
+    const T dot = adx * bdx + ady * bdy;
+
+    // Nearly collinear, the missing wedge is below the tolerance.
+    if (dot > 0 && std::abs(cross) * _half_width <= _tolerance) {
+      pair(p, bdx, bdy);
+      return;
+    }
+
+    pair(p, adx, ady);
+
+    // Turning left, the outer side is on the right.
+    const T side = cross > 0 ? -_half_width : _half_width;
+    const T ax = -ady * side;
+    const T ay = adx * side;
+    const T bx = -bdy * side;
+    const T by = bdx * side;
+
+    push(p.x, p.y);
+    push(p.x + ax, p.y + ay);
+
+    switch (_style.join) {
+    case line_join::miter: {
+      // The miter length over the half width is 1 / cos(angle / 2).
+      const T half_cos2 = (1 + dot) / 2;
+      if (half_cos2 * _style.miter_limit * _style.miter_limit >= 1) {
+        push(p.x, p.y);
+        push(p.x + (ax + bx) / (1 + dot), p.y + (ay + by) / (1 + dot));
+      }
+      break;
+    }
+
+    case line_join::round: {
+      const T angle = std::atan2(std::abs(cross), dot);
+      const std::size_t steps = arc_steps(angle);
+      const T step = (cross > 0 ? angle : -angle) / static_cast<T>(steps);
+      const T c = std::cos(step);
+      const T s = std::sin(step);
+      T vx = ax;
+      T vy = ay;
+
+      for (std::size_t k = 1; k < steps; k++) {
+        const T rx = vx * c - vy * s;
+        vy = vx * s + vy * c;
+        vx = rx;
+        push(p.x, p.y);
+        push(p.x + vx, p.y + vy);
+      }
+      break;
+    }
+
+    case line_join::bevel:
+      break;
+    }
+
+    push(p.x, p.y);
+    push(p.x + bx, p.y + by);
+    pair(p, bdx, bdy);
+  }
+
+  template <typename T>
+  std::size_t stroker<T>::run(const nano::point<T>* points, std::size_t count, nano::rect<T>* bounds) NANO_NOEXCEPT {
+    if (bounds) {
+      *bounds = nano::rect<T>(0, 0, 0, 0);
+    }
+
+    if (count < 2 || !(_half_width > 0)) {
+      return 0;
+    }
+
+    T dx[stroke_chunk_size];
+    T dy[stroke_chunk_size];
+    T length[stroke_chunk_size];
+
+    bool has_previous = false;
+    T pdx = 0;
+    T pdy = 0;
+    T fdx = 0;
+    T fdy = 0;
+    nano::point<T> first_point = points[0];
+    nano::point<T> last_point = points[0];
+
+    const auto visit = [&](const nano::point<T>& p, T sdx, T sdy) {
+      if (!has_previous) {
+        has_previous = true;
+        first_point = p;
+        fdx = sdx;
+        fdy = sdy;
+
+        if (_style.closed) {
+          pair(p, sdx, sdy);
+        }
+        else {
+          start(p, sdx, sdy);
+        }
+      }
+      else {
+        join(p, pdx, pdy, sdx, sdy);
+      }
+
+      pdx = sdx;
+      pdy = sdy;
+    };
+
+    for (std::size_t first = 0; first < count - 1; first += stroke_chunk_size) {
+      const std::size_t n = std::min(stroke_chunk_size, count - 1 - first);
+      stroke_directions(points + first, points + first + 1, n, dx, dy, length);
+
+      for (std::size_t i = 0; i < n; i++) {
+        if (length[i] > 0) {
+          visit(points[first + i], dx[i], dy[i]);
+          last_point = points[first + i + 1];
+        }
+      }
+    }
+
+    if (_style.closed) {
+      stroke_directions(points + count - 1, points, 1, dx, dy, length);
+      if (length[0] > 0) {
+        visit(points[count - 1], dx[0], dy[0]);
+      }
+    }
+
+    if (!has_previous) {
+      return 0;
+    }
+
+    if (_style.closed) {
+      join(first_point, pdx, pdy, fdx, fdy);
+    }
+    else {
+      finish(last_point, pdx, pdy);
+    }
+
+    if (bounds) {
+      *bounds = nano::rect<T>::create_from_point({ _left, _top }, { _right, _bottom });
+    }
+
+    return _count;
+  }
+} // namespace detail.
+
+template <typename T>
+std::size_t stroke_vertex_count(const nano::point<T>* points, std::size_t count, const stroke_style<T>& style,
+    nano::rect<T>* bounds) NANO_NOEXCEPT {
+  static_assert(std::is_floating_point_v<T>, "nano::stroke_vertex_count requires a floating point type");
+  return detail::stroker<T>(style, nullptr).run(points, count, bounds);
+}
+
+template <typename T>
+std::size_t stroke(const nano::point<T>* points, std::size_t count, const stroke_style<T>& style,
+    nano::point<T>* vertices, nano::rect<T>* bounds) NANO_NOEXCEPT {
+  NANO_GEOMETRY_TRACE_SCOPE("stroke", count, count * sizeof(nano::point<T>));
+  static_assert(std::is_floating_point_v<T>, "nano::stroke requires a floating point type");
+  return detail::stroker<T>(style, vertices).run(points, count, bounds);
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,380 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/tile_pyramid.h
+ * @brief     nano slippy map tile pyramid
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Tile (z, x, y) of a slippy map pyramid: zoom level `z` has 2^z x 2^z tiles, x grows to
+/// the right and y downward from the top left tile (0, 0).
+///
+/// Zoom levels go up to `max_zoom`, the deepest level whose coordinates fit in the 29 bits
+/// of id(). Keys above it are not valid.
+struct tile_key {
+  static constexpr std::uint32_t max_zoom = 29;
+
+  std::uint32_t z;
+  std::uint32_t x;
+  std::uint32_t y;
+
+  /// Tile covering this one at the previous zoom level, the tile itself at zoom 0.
+  NANO_NODC_INLINE_CXPR tile_key parent() const NANO_NOEXCEPT;
+
+  /// Tile `i` of the four tiles covering this one at the next zoom level:
+  /// 0 top left, 1 top right, 2 bottom left and 3 bottom right. The tile itself at max_zoom.
+  NANO_NODC_INLINE_CXPR tile_key child(std::uint32_t i) const NANO_NOEXCEPT;
+
+  /// Unique 64 bits id, ordered by zoom level, then x and y.
+  NANO_NODC_INLINE_CXPR std::uint64_t id() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE_CXPR bool operator==(const tile_key& k) const NANO_NOEXCEPT;
+  NANO_NODC_INLINE_CXPR bool operator!=(const tile_key& k) const NANO_NOEXCEPT;
+  NANO_NODC_INLINE_CXPR bool operator<(const tile_key& k) const NANO_NOEXCEPT;
+};
+
+/// Block of tiles of a zoom level, `left` and `top` included, `right` and `bottom` excluded.
+struct tile_range {
+  std::uint32_t z;
+  std::uint32_t left;
+  std::uint32_t top;
+  std::uint32_t right;
+  std::uint32_t bottom;
+
+  NANO_NODC_INLINE_CXPR bool empty() const NANO_NOEXCEPT;
+
+  /// Number of tiles.
+  NANO_NODC_INLINE_CXPR std::size_t size() const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE_CXPR bool contains(const tile_key& k) const NANO_NOEXCEPT;
+};
+
+/// Maps the tiles of a slippy map pyramid to the rect they cover in a world rect, e.g.
+/// the web mercator square or { 0, 0, 1, 1 } for normalized coordinates.
+///
+/// A tile covers a viewport when their rects intersect (rect::intersects, tiles only
+/// touching the viewport are not included). Coordinates outside the world do not wrap.
+///
+/// Zoom levels above tile_key::max_zoom are clamped to it.
+template <typename T>
+class tile_pyramid {
+public:
+  using value_type = T;
+  using point_type = nano::point<value_type>;
+  using size_type = nano::size<value_type>;
+  using rect_type = nano::rect<value_type>;
+
+  inline tile_pyramid(const rect_type& world) NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE const rect_type& world() const NANO_NOEXCEPT;
+
+  /// Size of the tiles of zoom level `z`.
+  NANO_NODC_INLINE size_type tile_size(std::uint32_t z) const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE rect_type tile_bounds(const tile_key& k) const NANO_NOEXCEPT;
+
+  /// Tile containing `p` at zoom level `z`, clamped to the world. NaN coordinates give 0.
+  NANO_NODC_INLINE tile_key tile_at(const point_type& p, std::uint32_t z) const NANO_NOEXCEPT;
+
+  /// Tiles of zoom level `z` covering `viewport`, empty for a non finite viewport.
+  NANO_NODC_INLINE tile_range range(const rect_type& viewport, std::uint32_t z) const NANO_NOEXCEPT;
+
+  /// Appends the tiles of zoom level `z` covering `viewport` to `tiles`, closest to the
+  /// middle of the viewport first.
+  inline void covering_tiles(const rect_type& viewport, std::uint32_t z, std::vector<tile_key>& tiles) const;
+
+  /// Sorts `[first, last)` by the distance of the tile centers from `p`, closest first.
+  /// Equally distant tiles are sorted by tile_key::operator<.
+  inline void sort_by_distance(const point_type& p, tile_key* first, tile_key* last) const;
+
+private:
+  rect_type _world;
+};
+
+/// Keeps track of the tiles covering a moving viewport.
+///
+/// The tracker keeps a pointer to the pyramid, which must outlive it.
+template <typename T>
+class tile_tracker {
+public:
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using pyramid_type = nano::tile_pyramid<value_type>;
+
+  inline tile_tracker(const pyramid_type& pyramid) NANO_NOEXCEPT;
+
+  /// Forgets the current tiles, the next update reports all of its tiles as entered.
+  inline void reset() NANO_NOEXCEPT;
+
+  /// Moves the viewport and appends the tiles that started covering it to `entered`,
+  /// closest to the middle of the viewport first, and the ones that no longer cover it to
+  /// `exited`. Changing the zoom level exits all the previous tiles.
+  inline void update(const rect_type& viewport, std::uint32_t z, std::vector<tile_key>& entered,
+      std::vector<tile_key>& exited);
+
+  /// Tiles covering the current viewport.
+  NANO_NODC_INLINE const tile_range& range() const NANO_NOEXCEPT;
+
+private:
+  const pyramid_type* _pyramid;
+  tile_range _range;
+};
+} // namespace nano.
+
+namespace std {
+template <>
+struct hash<::nano::tile_key> {
+  NANO_NODC_INLINE std::size_t operator()(const ::nano::tile_key& k) const NANO_NOEXCEPT {
+    return std::hash<std::uint64_t>{}(k.id());
+  }
+};
+} // namespace std.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+namespace detail {
+  NANO_NODC_INLINE_CXPR std::uint32_t clamp_zoom(std::uint32_t z) NANO_NOEXCEPT {
+    return std::min(z, tile_key::max_zoom);
+  }
+} // namespace detail.
+
+//
+// MARK: - tile_key -
+//
+
+NANO_INLINE_CXPR tile_key tile_key::parent() const NANO_NOEXCEPT {
+  return z ? tile_key{ z - 1, x >> 1, y >> 1 } : *this;
+}
+
+NANO_INLINE_CXPR tile_key tile_key::child(std::uint32_t i) const NANO_NOEXCEPT {
+  return z < max_zoom ? tile_key{ z + 1, (x << 1) | (i & 1), (y << 1) | (i >> 1) } : *this;
+}
+
+NANO_INLINE_CXPR std::uint64_t tile_key::id() const NANO_NOEXCEPT {
+  return (static_cast<std::uint64_t>(z) << 58) | (static_cast<std::uint64_t>(x) << 29) | y;
+}
+
+NANO_INLINE_CXPR bool tile_key::operator==(const tile_key& k) const NANO_NOEXCEPT {
+  return z == k.z && x == k.x && y == k.y;
+}
+
+NANO_INLINE_CXPR bool tile_key::operator!=(const tile_key& k) const NANO_NOEXCEPT { return !operator==(k); }
+
+NANO_INLINE_CXPR bool tile_key::operator<(const tile_key& k) const NANO_NOEXCEPT { return id() < k.id(); }
+
+//
+// MARK: - tile_range -
+//
+
+NANO_INLINE_CXPR bool tile_range::empty() const NANO_NOEXCEPT { return left >= right || top >= bottom; }
+
+NANO_INLINE_CXPR std::size_t tile_range::size() const NANO_NOEXCEPT {
+  return empty() ? 0 : static_cast<std::size_t>(right - left) * static_cast<std::size_t>(bottom - top);
+}
+
+NANO_INLINE_CXPR bool tile_range::contains(const tile_key& k) const NANO_NOEXCEPT {
+  return k.z == z && k.x >= left && k.x < right && k.y >= top && k.y < bottom;
+}
+
+//
+// MARK: - tile_pyramid -
+//
+
+template <typename T>
+tile_pyramid<T>::tile_pyramid(const rect_type& world) NANO_NOEXCEPT : _world(world) {}
+
+template <typename T>
+const typename tile_pyramid<T>::rect_type& tile_pyramid<T>::world() const NANO_NOEXCEPT {
+  return _world;
+}
+
+template <typename T>
+typename tile_pyramid<T>::size_type tile_pyramid<T>::tile_size(std::uint32_t z) const NANO_NOEXCEPT {
+  const double scale = std::ldexp(1.0, -static_cast<int>(detail::clamp_zoom(z)));
+  return { static_cast<value_type>(static_cast<double>(_world.size.width) * scale),
+    static_cast<value_type>(static_cast<double>(_world.size.height) * scale) };
+}
+
+template <typename T>
+typename tile_pyramid<T>::rect_type tile_pyramid<T>::tile_bounds(const tile_key& k) const NANO_NOEXCEPT {
+  // Both edges from the tile index so that neighbors share their edges exactly.
+  const double scale = std::ldexp(1.0, -static_cast<int>(detail::clamp_zoom(k.z)));
+  const double w = static_cast<double>(_world.size.width) * scale;
+  const double h = static_cast<double>(_world.size.height) * scale;
+  const double l = static_cast<double>(_world.origin.x) + static_cast<double>(k.x) * w;
+  const double t = static_cast<double>(_world.origin.y) + static_cast<double>(k.y) * h;
+  return rect_type::create_from_point({ static_cast<value_type>(l), static_cast<value_type>(t) },
+      { static_cast<value_type>(l + w), static_cast<value_type>(t + h) });
+}
+
+template <typename T>
+tile_key tile_pyramid<T>::tile_at(const point_type& p, std::uint32_t z) const NANO_NOEXCEPT {
+  z = detail::clamp_zoom(z);
+  const double count = std::ldexp(1.0, static_cast<int>(z));
+
+  // NaN fails the comparison and gives 0 instead of reaching the cast.
+  const auto index = [&](value_type v, value_type origin, value_type length) {
+    const double i = std::floor((static_cast<double>(v) - static_cast<double>(origin)) * count
+        / static_cast<double>(length));
+    return i > 0 ? static_cast<std::uint32_t>(std::min(i, count - 1)) : 0u;
+  };
+
+  return { z, index(p.x, _world.origin.x, _world.size.width), index(p.y, _world.origin.y, _world.size.height) };
+}
+
+template <typename T>
+tile_range tile_pyramid<T>::range(const rect_type& viewport, std::uint32_t z) const NANO_NOEXCEPT {
+  z = detail::clamp_zoom(z);
+
+  if (!(viewport.size.width > 0 && viewport.size.height > 0 && _world.size.width > 0 && _world.size.height > 0)) {
+    return { z, 0, 0, 0, 0 };
+  }
+
+  // Tile k covers (k, k + 1) in tile units, it intersects (a, b) when k >= floor(a) and k < ceil(b).
+  const double count = std::ldexp(1.0, static_cast<int>(z));
+  const auto clamp = [&](double v) { return static_cast<std::uint32_t>(std::min(std::max(v, 0.0), count)); };
+  const auto first = [&](double v) { return clamp(std::floor(v)); };
+  const auto last = [&](double v) { return clamp(std::ceil(v)); };
+
+  const double sx = count / static_cast<double>(_world.size.width);
+  const double sy = count / static_cast<double>(_world.size.height);
+  const double l = (static_cast<double>(viewport.origin.x) - static_cast<double>(_world.origin.x)) * sx;
+  const double t = (static_cast<double>(viewport.origin.y) - static_cast<double>(_world.origin.y)) * sy;
+  const double r = l + static_cast<double>(viewport.size.width) * sx;
+  const double b = t + static_cast<double>(viewport.size.height) * sy;
+
+  if (!(std::isfinite(l) && std::isfinite(t) && std::isfinite(r) && std::isfinite(b))) {
+    return { z, 0, 0, 0, 0 };
+  }
+
+  return { z, first(l), first(t), last(r), last(b) };
+}
+
+template <typename T>
+void tile_pyramid<T>::sort_by_distance(const point_type& p, tile_key* first, tile_key* last) const {
+  if (first == last) {
+    return;
+  }
+
+  // In tile units of the zoom level of the first tile, the tiles are expected to share it.
+  const double count = std::ldexp(1.0, static_cast<int>(detail::clamp_zoom(first->z)));
+  const double px = (static_cast<double>(p.x) - static_cast<double>(_world.origin.x)) * count
+      / static_cast<double>(_world.size.width);
+  const double py = (static_cast<double>(p.y) - static_cast<double>(_world.origin.y)) * count
+      / static_cast<double>(_world.size.height);
+
+  const auto distance = [&](const tile_key& k) {
+    const double dx = static_cast<double>(k.x) + 0.5 - px;
+    const double dy = static_cast<double>(k.y) + 0.5 - py;
+    return dx * dx + dy * dy;
+  };
+
+  std::sort(first, last, [&](const tile_key& a, const tile_key& b) {
+    const double da = distance(a);
+    const double db = distance(b);
+    return da < db || (da == db && a < b);
+  });
+}
+
+template <typename T>
+void tile_pyramid<T>::covering_tiles(const rect_type& viewport, std::uint32_t z, std::vector<tile_key>& tiles) const {
+  const tile_range r = range(viewport, z);
+  const std::size_t offset = tiles.size();
+  tiles.reserve(offset + r.size());
+
+  for (std::uint32_t y = r.top; y < r.bottom; y++) {
+    for (std::uint32_t x = r.left; x < r.right; x++) {
+      tiles.push_back({ r.z, x, y });
+    }
+  }
+
+  sort_by_distance(viewport.middle(), tiles.data() + offset, tiles.data() + tiles.size());
+}
+
+//
+// MARK: - tile_tracker -
+//
+
+template <typename T>
+tile_tracker<T>::tile_tracker(const pyramid_type& pyramid) NANO_NOEXCEPT : _pyramid(&pyramid),
+                                                                          _range{ 0, 0, 0, 0, 0 } {}
+
+template <typename T>
+void tile_tracker<T>::reset() NANO_NOEXCEPT {
+  _range = { 0, 0, 0, 0, 0 };
+}
+
+template <typename T>
+const tile_range& tile_tracker<T>::range() const NANO_NOEXCEPT {
+  return _range;
+}
+
+template <typename T>
+void tile_tracker<T>::update(
+    const rect_type& viewport, std::uint32_t z, std::vector<tile_key>& entered, std::vector<tile_key>& exited) {
+  const tile_range previous = _range;
+  _range = _pyramid->range(viewport, z);
+
+  // The ranges are small (the tiles of one screen), scanning them beats any set difference.
+  for (std::uint32_t y = previous.top; y < previous.bottom; y++) {
+    for (std::uint32_t x = previous.left; x < previous.right; x++) {
+      if (!_range.contains({ previous.z, x, y })) {
+        exited.push_back({ previous.z, x, y });
+      }
+    }
+  }
+
+  const std::size_t offset = entered.size();
+  for (std::uint32_t y = _range.top; y < _range.bottom; y++) {
+    for (std::uint32_t x = _range.left; x < _range.right; x++) {
+      if (!previous.contains({ _range.z, x, y })) {
+        entered.push_back({ _range.z, x, y });
+      }
+    }
+  }
+
+  _pyramid->sort_by_distance(viewport.middle(), entered.data() + offset, entered.data() + entered.size());
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
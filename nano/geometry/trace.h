@@ -0,0 +1,361 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/trace.h
+ * @brief     nano geometry tracing
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+
+/// Tracing of the batch operations, off unless NANO_GEOMETRY_TRACE is defined to 1 (the
+/// NANO_GEOMETRY_TRACE cmake option). When off, NANO_GEOMETRY_TRACE_SCOPE() expands to
+/// nothing and none of the nano::trace declarations below exist.
+#ifndef NANO_GEOMETRY_TRACE
+  #define NANO_GEOMETRY_TRACE 0
+#endif
+
+#if NANO_GEOMETRY_TRACE
+  #define NANO_GEOMETRY_TRACE_CONCAT_IMPL(a, b) a##b
+  #define NANO_GEOMETRY_TRACE_CONCAT(a, b) NANO_GEOMETRY_TRACE_CONCAT_IMPL(a, b)
+
+  /// Records a span from here to the end of the enclosing block. `name` must be a string
+  /// literal (only the pointer is kept).
+  #define NANO_GEOMETRY_TRACE_SCOPE(name, items, bytes)                                                               \
+    const ::nano::trace::scope NANO_GEOMETRY_TRACE_CONCAT(nano_trace_scope_, __LINE__)(name, items, bytes)
+#else
+  #define NANO_GEOMETRY_TRACE_SCOPE(name, items, bytes) static_cast<void>(0)
+#endif
+
+#if NANO_GEOMETRY_TRACE
+
+  #include <algorithm>
+  #include <atomic>
+  #include <chrono>
+  #include <cstdint>
+  #include <cstdio>
+  #include <memory>
+  #include <mutex>
+  #include <string>
+  #include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano::trace {
+
+/// A finished span. Times are in nanoseconds since the first event of the process.
+struct event {
+  const char* name;
+  std::uint64_t begin;
+  std::uint64_t duration;
+  std::uint64_t items;
+  std::uint64_t bytes;
+  std::uint32_t thread;
+};
+
+/// Number of events kept per thread, older events are overwritten.
+inline constexpr std::size_t buffer_capacity = 8192;
+
+/// Span from construction to destruction, recorded in the ring buffer of the calling thread.
+///
+/// Each thread writes to its own buffer without locking, the only lock is taken once per
+/// thread when its buffer is created. Reading (collect(), to_chrome_json()) can happen on
+/// any thread at any time, events being overwritten during the copy are skipped.
+class scope {
+public:
+  inline scope(const char* name, std::size_t items = 0, std::size_t bytes = 0) NANO_NOEXCEPT;
+
+  scope(const scope&) = delete;
+  scope& operator=(const scope&) = delete;
+
+  inline ~scope() NANO_NOEXCEPT;
+
+  /// Sets the counts when they are only known at the end of the span.
+  inline void set_items(std::size_t items) NANO_NOEXCEPT;
+  inline void set_bytes(std::size_t bytes) NANO_NOEXCEPT;
+
+private:
+  const char* _name;
+  std::uint64_t _begin;
+  std::uint64_t _items;
+  std::uint64_t _bytes;
+};
+
+/// Names the calling thread in the exported traces, `name` is copied.
+inline void set_thread_name(const std::string& name);
+
+/// Appends the events of every thread to `events`, oldest first for each thread.
+inline void collect(std::vector<event>& events);
+
+/// Drops the events recorded so far.
+inline void clear() NANO_NOEXCEPT;
+
+/// Returns the events in the Chrome trace event format (chrome://tracing, Perfetto), as
+/// complete events with the item and byte counts in their arguments.
+inline std::string to_chrome_json();
+
+/// Writes to_chrome_json() to `filename`, returns false if the file could not be written.
+inline bool write_chrome_json(const char* filename);
+} // namespace nano::trace.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano::trace {
+
+namespace detail {
+  static_assert((buffer_capacity & (buffer_capacity - 1)) == 0, "nano::trace::buffer_capacity must be a power of 2");
+
+  /// Every field is atomic so that a reader racing the writer is well defined. The sequence
+  /// is the event index + 1 once written and 0 while being written.
+  struct slot {
+    std::atomic<std::uint64_t> sequence{ 0 };
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<std::uint64_t> begin{ 0 };
+    std::atomic<std::uint64_t> duration{ 0 };
+    std::atomic<std::uint64_t> items{ 0 };
+    std::atomic<std::uint64_t> bytes{ 0 };
+  };
+
+  /// Single writer (the owning thread), any number of readers.
+  struct buffer {
+    explicit buffer(std::uint32_t id)
+        : slots(new slot[buffer_capacity]),
+          thread(id) {}
+
+    std::unique_ptr<slot[]> slots;
+    std::atomic<std::uint64_t> head{ 0 };
+    std::atomic<std::uint64_t> tail{ 0 };
+    std::uint32_t thread;
+    std::mutex name_mutex;
+    std::string name;
+
+    inline void push(const char* n, std::uint64_t b, std::uint64_t d, std::uint64_t i, std::uint64_t by) NANO_NOEXCEPT;
+    inline void copy(std::vector<event>& events) const;
+  };
+
+  /// Buffers are never freed so that the events of finished threads can still be exported.
+  struct registry {
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    std::mutex mutex;
+    std::vector<std::unique_ptr<buffer>> buffers;
+
+    inline buffer* create();
+  };
+
+  inline registry& get_registry() {
+    static registry r;
+    return r;
+  }
+
+  inline buffer& local_buffer() {
+    static thread_local buffer* b = get_registry().create();
+    return *b;
+  }
+
+  inline std::uint64_t now() NANO_NOEXCEPT {
+    const std::chrono::steady_clock::duration d = std::chrono::steady_clock::now() - get_registry().epoch;
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+  }
+
+  inline void append_json_string(std::string& json, const char* str) {
+    json += '"';
+    for (; *str; ++str) {
+      const char c = *str;
+      if (c == '"' || c == '\\') {
+        json += '\\';
+        json += c;
+      }
+      else if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+        json += escaped;
+      }
+      else {
+        json += c;
+      }
+    }
+
+    json += '"';
+  }
+
+  void buffer::push(const char* n, std::uint64_t b, std::uint64_t d, std::uint64_t i, std::uint64_t by) NANO_NOEXCEPT {
+    const std::uint64_t index = head.load(std::memory_order_relaxed);
+    slot& s = slots[index & (buffer_capacity - 1)];
+
+    s.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.name.store(n, std::memory_order_relaxed);
+    s.begin.store(b, std::memory_order_relaxed);
+    s.duration.store(d, std::memory_order_relaxed);
+    s.items.store(i, std::memory_order_relaxed);
+    s.bytes.store(by, std::memory_order_relaxed);
+    s.sequence.store(index + 1, std::memory_order_release);
+    head.store(index + 1, std::memory_order_release);
+  }
+
+  void buffer::copy(std::vector<event>& events) const {
+    const std::uint64_t last = head.load(std::memory_order_acquire);
+    const std::uint64_t oldest = last > buffer_capacity ? last - buffer_capacity : 0;
+
+    for (std::uint64_t index = std::max(oldest, tail.load(std::memory_order_relaxed)); index < last; index++) {
+      const slot& s = slots[index & (buffer_capacity - 1)];
+      if (s.sequence.load(std::memory_order_acquire) != index + 1) {
+        continue;
+      }
+
+      const event e = { s.name.load(std::memory_order_relaxed), s.begin.load(std::memory_order_relaxed),
+        s.duration.load(std::memory_order_relaxed), s.items.load(std::memory_order_relaxed),
+        s.bytes.load(std::memory_order_relaxed), thread };
+
+      // Overwritten while reading.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (s.sequence.load(std::memory_order_relaxed) == index + 1) {
+        events.push_back(e);
+      }
+    }
+  }
+
+  buffer* registry::create() {
+    std::lock_guard<std::mutex> lock(mutex);
+    buffers.push_back(std::make_unique<buffer>(static_cast<std::uint32_t>(buffers.size() + 1)));
+    return buffers.back().get();
+  }
+} // namespace detail.
+
+//
+// MARK: - scope -
+//
+
+scope::scope(const char* name, std::size_t items, std::size_t bytes) NANO_NOEXCEPT
+    : _name(name),
+      _begin(detail::now()),
+      _items(items),
+      _bytes(bytes) {}
+
+scope::~scope() NANO_NOEXCEPT {
+  const std::uint64_t end = detail::now();
+  detail::local_buffer().push(_name, _begin, end - _begin, _items, _bytes);
+}
+
+void scope::set_items(std::size_t items) NANO_NOEXCEPT { _items = items; }
+
+void scope::set_bytes(std::size_t bytes) NANO_NOEXCEPT { _bytes = bytes; }
+
+//
+// MARK: - export -
+//
+
+void set_thread_name(const std::string& name) {
+  detail::buffer& b = detail::local_buffer();
+  std::lock_guard<std::mutex> lock(b.name_mutex);
+  b.name = name;
+}
+
+void collect(std::vector<event>& events) {
+  detail::registry& r = detail::get_registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  for (const std::unique_ptr<detail::buffer>& b : r.buffers) {
+    b->copy(events);
+  }
+}
+
+void clear() NANO_NOEXCEPT {
+  detail::registry& r = detail::get_registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  for (const std::unique_ptr<detail::buffer>& b : r.buffers) {
+    b->tail.store(b->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+}
+
+std::string to_chrome_json() {
+  std::vector<event> events;
+  std::vector<std::pair<std::uint32_t, std::string>> names;
+
+  {
+    detail::registry& r = detail::get_registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const std::unique_ptr<detail::buffer>& b : r.buffers) {
+      b->copy(events);
+
+      std::lock_guard<std::mutex> name_lock(b->name_mutex);
+      if (!b->name.empty()) {
+        names.emplace_back(b->thread, b->name);
+      }
+    }
+  }
+
+  std::string json = "{\"traceEvents\":[";
+  bool first = true;
+  char number[160];
+
+  for (const std::pair<std::uint32_t, std::string>& n : names) {
+    std::snprintf(number, sizeof(number),
+        "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",",
+        static_cast<unsigned int>(n.first));
+    json += number;
+    detail::append_json_string(json, n.second.c_str());
+    json += "}}";
+    first = false;
+  }
+
+  // Timestamps are in microseconds.
+  for (const event& e : events) {
+    json += first ? "{\"name\":" : ",{\"name\":";
+    detail::append_json_string(json, e.name);
+    std::snprintf(number, sizeof(number),
+        ",\"cat\":\"nano.geometry\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+        "\"args\":{\"items\":%llu,\"bytes\":%llu}}",
+        static_cast<double>(e.begin) * 1e-3, static_cast<double>(e.duration) * 1e-3,
+        static_cast<unsigned int>(e.thread), static_cast<unsigned long long>(e.items),
+        static_cast<unsigned long long>(e.bytes));
+    json += number;
+    first = false;
+  }
+
+  json += "],\"displayTimeUnit\":\"ns\"}";
+  return json;
+}
+
+bool write_chrome_json(const char* filename) {
+  std::FILE* file = std::fopen(filename, "wb");
+  if (!file) {
+    return false;
+  }
+
+  const std::string json = to_chrome_json();
+  const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+  return std::fclose(file) == 0 && written;
+}
+} // namespace nano::trace.
+
+NANO_CLANG_DIAGNOSTIC_POP()
+
+#endif // NANO_GEOMETRY_TRACE
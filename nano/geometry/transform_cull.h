@@ -0,0 +1,161 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/transform_cull.h
+ * @brief     nano fused transform, bounds and visibility kernel
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/trace.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+namespace detail {
+  /// Bounding rect of `t.apply(r)` computed without building the quad.
+  template <typename T>
+  NANO_NODC_INLINE nano::rect<T> transformed_bounds(const nano::transform<T>& t, const nano::rect<T>& r) NANO_NOEXCEPT;
+} // namespace detail.
+
+/// Transforms local rects, writes their world bounds and the indices of the visible ones.
+///
+/// For every item `i`, `world_bounds[i]` receives the bounding rect of `t.apply(local[i])`
+/// and `i` is appended to `visible` when these bounds intersect `viewport`
+/// (rect::intersects, touching edges are not visible). The items are processed in
+/// chunks: the bounds of a chunk are computed by a branch-free loop, then tested and
+/// compacted while still in cache, so the input and the outputs are streamed once.
+///
+/// `world_bounds` can be null when only the visible list is needed. `visible` must
+/// have room for `count` indices. Returns the number of visible items.
+template <typename T>
+inline std::size_t transform_cull(const nano::rect<T>* local, std::size_t count, const nano::transform<T>& t,
+    const nano::rect<T>& viewport, nano::rect<T>* world_bounds, std::uint32_t* visible) NANO_NOEXCEPT;
+
+/// Same as above with one transform per item.
+template <typename T>
+inline std::size_t transform_cull(const nano::rect<T>* local, const nano::transform<T>* transforms, std::size_t count,
+    const nano::rect<T>& viewport, nano::rect<T>* world_bounds, std::uint32_t* visible) NANO_NOEXCEPT;
+
+/// Same as above with items referring to a shared transform by index,
+/// `local[i]` is transformed by `transforms[transform_ids[i]]`.
+template <typename T>
+inline std::size_t transform_cull(const nano::rect<T>* local, const std::uint32_t* transform_ids,
+    const nano::transform<T>* transforms, std::size_t count, const nano::rect<T>& viewport,
+    nano::rect<T>* world_bounds, std::uint32_t* visible) NANO_NOEXCEPT;
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+  // Each output axis is the transformed origin plus the negative parts of the
+  // transformed extents, the size is the sum of their absolute values.
+  template <typename T>
+  NANO_INLINE nano::rect<T> transformed_bounds(const nano::transform<T>& t, const nano::rect<T>& r) NANO_NOEXCEPT {
+    const T aw = t.a * r.size.width;
+    const T ch = t.c * r.size.height;
+    const T bw = t.b * r.size.width;
+    const T dh = t.d * r.size.height;
+
+    return nano::rect<T>(t.a * r.origin.x + t.c * r.origin.y + t.tx + std::min(aw, T(0)) + std::min(ch, T(0)),
+        t.b * r.origin.x + t.d * r.origin.y + t.ty + std::min(bw, T(0)) + std::min(dh, T(0)),
+        std::abs(aw) + std::abs(ch), std::abs(bw) + std::abs(dh));
+  }
+
+  /// Number of items whose bounds are computed before being tested.
+  inline constexpr std::size_t transform_cull_chunk_size = 256;
+
+  template <typename T, typename TransformFct>
+  inline std::size_t transform_cull(const nano::rect<T>* local, std::size_t count, TransformFct&& transform_of,
+      const nano::rect<T>& viewport, nano::rect<T>* world_bounds, std::uint32_t* visible) NANO_NOEXCEPT {
+    NANO_GEOMETRY_TRACE_SCOPE("transform_cull", count, count * sizeof(nano::rect<T>));
+    const T vl = viewport.origin.x;
+    const T vt = viewport.origin.y;
+    const T vr = viewport.origin.x + viewport.size.width;
+    const T vb = viewport.origin.y + viewport.size.height;
+
+    nano::rect<T> chunk[transform_cull_chunk_size];
+    std::size_t visible_count = 0;
+
+    for (std::size_t first = 0; first < count; first += transform_cull_chunk_size) {
+      const std::size_t n = std::min(transform_cull_chunk_size, count - first);
+      nano::rect<T>* bounds = world_bounds ? world_bounds + first : chunk;
+
+      for (std::size_t i = 0; i < n; i++) {
+        bounds[i] = transformed_bounds(transform_of(first + i), local[first + i]);
+      }
+
+      // Branch-free compaction, the index is always written and only kept when visible.
+      for (std::size_t i = 0; i < n; i++) {
+        const nano::rect<T>& b = bounds[i];
+        const bool is_visible = (std::min(b.origin.x + b.size.width, vr) - std::max(b.origin.x, vl)) > 0
+            && (std::min(b.origin.y + b.size.height, vb) - std::max(b.origin.y, vt)) > 0;
+        visible[visible_count] = static_cast<std::uint32_t>(first + i);
+        visible_count += is_visible;
+      }
+    }
+
+    return visible_count;
+  }
+} // namespace detail.
+
+template <typename T>
+std::size_t transform_cull(const nano::rect<T>* local, std::size_t count, const nano::transform<T>& t,
+    const nano::rect<T>& viewport, nano::rect<T>* world_bounds, std::uint32_t* visible) NANO_NOEXCEPT {
+  return detail::transform_cull(
+      local, count, [&](std::size_t) -> const nano::transform<T>& { return t; }, viewport, world_bounds, visible);
+}
+
+template <typename T>
+std::size_t transform_cull(const nano::rect<T>* local, const nano::transform<T>* transforms, std::size_t count,
+    const nano::rect<T>& viewport, nano::rect<T>* world_bounds, std::uint32_t* visible) NANO_NOEXCEPT {
+  return detail::transform_cull(
+      local, count, [&](std::size_t i) -> const nano::transform<T>& { return transforms[i]; }, viewport,
+      world_bounds, visible);
+}
+
+template <typename T>
+std::size_t transform_cull(const nano::rect<T>* local, const std::uint32_t* transform_ids,
+    const nano::transform<T>* transforms, std::size_t count, const nano::rect<T>& viewport,
+    nano::rect<T>* world_bounds, std::uint32_t* visible) NANO_NOEXCEPT {
+  return detail::transform_cull(
+      local, count, [&](std::size_t i) -> const nano::transform<T>& { return transforms[transform_ids[i]]; },
+      viewport, world_bounds, visible);
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
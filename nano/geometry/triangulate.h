@@ -0,0 +1,1316 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/triangulate.h
+ * @brief     nano polygon triangulation
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+/*
+ * detail::ear_clipper is derived from earcut (https://github.com/mapbox/earcut),
+ * distributed under the following license:
+ *
+ * ISC License
+ *
+ * Copyright (c) 2016, Mapbox
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose
+ * with or without fee is hereby granted, provided that the above copyright notice
+ * and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH REGARD TO
+ * THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+ * IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/polygon.h>
+#include <nano/geometry/trace.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+enum class triangulation_method {
+  /// Monotone partition for large polygons, ear clipping otherwise.
+  automatic,
+
+  /// Ear clipping with a z-order hash of the vertices accelerating the ear test.
+  ear_clipping,
+
+  /// Sweep-line partition into y-monotone pieces, each triangulated in linear time.
+  /// O(n log n) regardless of the shape, falls back to ear clipping on degenerate input.
+  monotone
+};
+
+namespace detail {
+  /// [first, last) point ranges of the rings, the outer one first.
+  using triangulation_rings = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+  /// Ear clipping over a circular linked list of vertices, derived from earcut (see the
+  /// license notice at the top of this file).
+  class ear_clipper {
+  public:
+    inline void run(const double* xs, const double* ys, const triangulation_rings& rings,
+        std::vector<std::uint32_t>& triangles);
+
+  private:
+    struct node {
+      std::uint32_t i;
+      double x;
+      double y;
+      node* prev = nullptr;
+      node* next = nullptr;
+      std::uint32_t z = 0;
+      node* prev_z = nullptr;
+      node* next_z = nullptr;
+      bool steiner = false;
+    };
+
+    std::deque<node> _nodes;
+    std::vector<node*> _queue;
+    std::vector<std::uint32_t>* _triangles = nullptr;
+    double _min_x = 0;
+    double _min_y = 0;
+    double _inv_size = 0;
+
+    inline node* linked_list(const double* xs, const double* ys, std::uint32_t first, std::uint32_t last, bool outer);
+    inline node* insert_node(std::uint32_t i, double x, double y, node* last);
+    inline node* filter_points(node* start, node* end = nullptr);
+    inline void earcut_linked(node* ear, int pass);
+    inline bool is_ear(node* ear) const;
+    inline bool is_ear_hashed(node* ear) const;
+    inline node* cure_local_intersections(node* start);
+    inline void split_earcut(node* start);
+    inline node* eliminate_holes(
+        const double* xs, const double* ys, const triangulation_rings& rings, node* outer);
+    inline node* eliminate_hole(node* hole, node* outer);
+    inline node* find_hole_bridge(node* hole, node* outer) const;
+    inline void index_curve(node* start);
+    inline std::uint32_t z_order(double x, double y) const;
+    inline node* split_polygon(node* a, node* b);
+    inline void emit(const node* a, const node* b, const node* c);
+
+    static inline void remove_node(node* p);
+    static inline node* sort_linked(node* list);
+    static inline node* leftmost(node* start);
+    static inline double area(const node* p, const node* q, const node* r);
+    static inline bool equals(const node* a, const node* b);
+    static inline bool point_in_triangle(
+        double ax, double ay, double bx, double by, double cx, double cy, double px, double py);
+    static inline bool intersects(const node* p1, const node* q1, const node* p2, const node* q2);
+    static inline bool on_segment(const node* p, const node* q, const node* r);
+    static inline bool intersects_polygon(const node* a, const node* b);
+    static inline bool locally_inside(const node* a, const node* b);
+    static inline bool middle_inside(const node* a, const node* b);
+    static inline bool is_valid_diagonal(const node* a, const node* b);
+    static inline bool sector_contains_sector(const node* m, const node* p);
+  };
+
+  /// Sweep-line decomposition in y-monotone pieces.
+  class monotone_triangulator {
+  public:
+    /// Returns false if the input is degenerate (the triangle count does not match).
+    inline bool run(const double* xs, const double* ys,
+        const triangulation_rings& rings, std::vector<std::uint32_t>& triangles);
+
+  private:
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    struct edge_less {
+      const monotone_triangulator* self;
+      inline bool operator()(std::uint32_t a, std::uint32_t b) const;
+    };
+
+    using status_type = std::set<std::uint32_t, edge_less>;
+
+    const double* _xs = nullptr;
+    const double* _ys = nullptr;
+    std::vector<std::uint32_t> _next;
+    std::vector<std::uint32_t> _prev;
+    std::vector<std::uint32_t> _vertices;
+    std::vector<std::uint32_t> _helper;
+    std::vector<status_type::iterator> _edge_its;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> _diagonals;
+    std::vector<std::uint32_t> _adjacency_offsets;
+    std::vector<std::uint32_t> _adjacency;
+    std::vector<std::uint32_t> _adjacency_fill;
+    std::vector<unsigned char> _visited;
+    std::vector<std::uint32_t> _face;
+    std::vector<std::uint32_t> _sorted;
+    std::vector<unsigned char> _left_chain;
+    std::vector<std::uint32_t> _stack;
+    double _sweep_y = 0;
+    double _probe_x = 0;
+
+    inline bool above(std::uint32_t a, std::uint32_t b) const NANO_NOEXCEPT;
+    inline double cross(std::uint32_t o, std::uint32_t a, std::uint32_t b) const NANO_NOEXCEPT;
+    inline double x_at(std::uint32_t e) const NANO_NOEXCEPT;
+    inline bool is_merge(std::uint32_t v) const NANO_NOEXCEPT;
+    inline std::uint32_t left_edge(status_type& status, std::uint32_t v);
+    inline void build_faces(std::vector<std::uint32_t>& triangles);
+    inline void triangulate_face(std::vector<std::uint32_t>& triangles);
+    inline void emit(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::vector<std::uint32_t>& triangles) const;
+  };
+} // namespace detail.
+
+/// Triangulates polygons with holes into index buffers.
+///
+/// Indices refer to positions in the point buffer of the polygon_view, so the points
+/// can be uploaded as is. A polygon of `n` points and `h` holes produces at most
+/// `n + 2h - 2` triangles (see max_triangle_count()), all wound like the outer ring.
+/// Consecutive duplicate points and collinear vertices may produce fewer triangles.
+///
+/// The triangulator keeps its working memory between calls, reusing one instance
+/// avoids allocations once it has processed the largest polygon.
+template <typename T>
+class polygon_triangulator {
+public:
+  using value_type = T;
+  using polygon_type = nano::polygon_view<value_type>;
+
+  /// Number of points from which the automatic method switches to the monotone partition.
+  /// Ear clipping is faster on small polygons, the partition wins from a few thousand points
+  /// (benchmarks/triangulate.cpp).
+  static constexpr std::size_t monotone_threshold = 2048;
+
+  /// Appends the indices of the triangles of `poly` to `indices`, three per triangle.
+  ///
+  /// Returns false if the polygon has fewer than 3 points or if its points cannot be
+  /// addressed with `Index` (16 or 32 bit).
+  template <typename Index>
+  inline bool triangulate(const polygon_type& poly, std::vector<Index>& indices,
+      triangulation_method method = triangulation_method::automatic);
+
+  /// Upper bound of the number of triangles of `poly`.
+  NANO_NODC_INLINE static std::size_t max_triangle_count(const polygon_type& poly) NANO_NOEXCEPT;
+
+private:
+  std::vector<double> _xs;
+  std::vector<double> _ys;
+  detail::triangulation_rings _rings;
+  std::vector<std::uint32_t> _triangles;
+  detail::ear_clipper _ear_clipper;
+  detail::monotone_triangulator _monotone;
+};
+
+/// Triangulates `poly` with a temporary polygon_triangulator.
+template <typename T, typename Index>
+inline bool triangulate(const nano::polygon_view<T>& poly, std::vector<Index>& indices,
+    triangulation_method method = triangulation_method::automatic);
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+
+  //
+  // MARK: - ear_clipper -
+  //
+
+  void ear_clipper::run(const double* xs, const double* ys,
+      const triangulation_rings& rings, std::vector<std::uint32_t>& triangles) {
+    _nodes.clear();
+    _triangles = &triangles;
+    _inv_size = 0;
+
+    node* outer = linked_list(xs, ys, rings[0].first, rings[0].second, true);
+    if (!outer || outer->next == outer->prev) {
+      return;
+    }
+
+    if (rings.size() > 1) {
+      outer = eliminate_holes(xs, ys, rings, outer);
+    }
+
+    // Hash the vertices on a z-order curve so that the ear test only visits the
+    // vertices whose hash falls in the range of the candidate triangle bounds.
+    if (rings[0].second - rings[0].first > 80) {
+      double max_x = xs[rings[0].first];
+      double max_y = ys[rings[0].first];
+      _min_x = max_x;
+      _min_y = max_y;
+
+      for (std::uint32_t i = rings[0].first + 1; i < rings[0].second; i++) {
+        _min_x = std::min(_min_x, xs[i]);
+        _min_y = std::min(_min_y, ys[i]);
+        max_x = std::max(max_x, xs[i]);
+        max_y = std::max(max_y, ys[i]);
+      }
+
+      const double size = std::max(max_x - _min_x, max_y - _min_y);
+      _inv_size = size != 0 ? 32767.0 / size : 0;
+    }
+
+    earcut_linked(outer, 0);
+  }
+
+  ear_clipper::node* ear_clipper::insert_node(std::uint32_t i, double x, double y, node* last) {
+    node* p = &_nodes.emplace_back();
+    p->i = i;
+    p->x = x;
+    p->y = y;
+
+    if (!last) {
+      p->prev = p;
+      p->next = p;
+    }
+    else {
+      p->next = last->next;
+      p->prev = last;
+      last->next->prev = p;
+      last->next = p;
+    }
+
+    return p;
+  }
+
+  void ear_clipper::remove_node(node* p) {
+    p->next->prev = p->prev;
+    p->prev->next = p->next;
+
+    if (p->prev_z) {
+      p->prev_z->next_z = p->next_z;
+    }
+
+    if (p->next_z) {
+      p->next_z->prev_z = p->prev_z;
+    }
+  }
+
+  // The outer ring is linked with a negative area() winding and the holes with the
+  // opposite one, whatever their input orientation.
+  ear_clipper::node* ear_clipper::linked_list(
+      const double* xs, const double* ys, std::uint32_t first, std::uint32_t last, bool outer) {
+    double sum = 0;
+    for (std::uint32_t i = first, j = last - 1; i < last; j = i++) {
+      sum += (xs[j] - xs[i]) * (ys[i] + ys[j]);
+    }
+
+    node* tail = nullptr;
+    if (outer == (sum > 0)) {
+      for (std::uint32_t i = first; i < last; i++) {
+        tail = insert_node(i, xs[i], ys[i], tail);
+      }
+    }
+    else {
+      for (std::uint32_t i = last; i-- > first;) {
+        tail = insert_node(i, xs[i], ys[i], tail);
+      }
+    }
+
+    if (tail && equals(tail, tail->next)) {
+      remove_node(tail);
+      tail = tail->next;
+    }
+
+    return tail;
+  }
+
+  ear_clipper::node* ear_clipper::filter_points(node* start, node* end) {
+    if (!start) {
+      return start;
+    }
+
+    if (!end) {
+      end = start;
+    }
+
+    node* p = start;
+    bool again = false;
+
+    do {
+      again = false;
+
+      if (!p->steiner && (equals(p, p->next) || area(p->prev, p, p->next) == 0)) {
+        remove_node(p);
+        p = end = p->prev;
+
+        if (p == p->next) {
+          break;
+        }
+
+        again = true;
+      }
+      else {
+        p = p->next;
+      }
+    } while (again || p != end);
+
+    return end;
+  }
+
+  void ear_clipper::emit(const node* a, const node* b, const node* c) {
+    _triangles->push_back(a->i);
+    _triangles->push_back(b->i);
+    _triangles->push_back(c->i);
+  }
+
+  void ear_clipper::earcut_linked(node* ear, int pass) {
+    if (!ear) {
+      return;
+    }
+
+    if (!pass && _inv_size != 0) {
+      index_curve(ear);
+    }
+
+    node* stop = ear;
+
+    while (ear->prev != ear->next) {
+      node* prev = ear->prev;
+      node* next = ear->next;
+
+      if (_inv_size != 0 ? is_ear_hashed(ear) : is_ear(ear)) {
+        emit(prev, ear, next);
+        remove_node(ear);
+        ear = next->next;
+        stop = next->next;
+        continue;
+      }
+
+      ear = next;
+
+      // No ear found in a full turn: remove degenerate vertices, then cure local
+      // self-intersections, then split the polygon in two.
+      if (ear == stop) {
+        if (pass == 0) {
+          earcut_linked(filter_points(ear), 1);
+        }
+        else if (pass == 1) {
+          earcut_linked(cure_local_intersections(filter_points(ear)), 2);
+        }
+        else {
+          split_earcut(ear);
+        }
+
+        break;
+      }
+    }
+  }
+
+  bool ear_clipper::is_ear(node* ear) const {
+    const node* a = ear->prev;
+    const node* b = ear;
+    const node* c = ear->next;
+
+    if (area(a, b, c) >= 0) {
+      return false;
+    }
+
+    const double x0 = std::min({ a->x, b->x, c->x });
+    const double y0 = std::min({ a->y, b->y, c->y });
+    const double x1 = std::max({ a->x, b->x, c->x });
+    const double y1 = std::max({ a->y, b->y, c->y });
+
+    for (const node* p = c->next; p != a; p = p->next) {
+      if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1
+          && point_in_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && area(p->prev, p, p->next) >= 0) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool ear_clipper::is_ear_hashed(node* ear) const {
+    const node* a = ear->prev;
+    const node* b = ear;
+    const node* c = ear->next;
+
+    if (area(a, b, c) >= 0) {
+      return false;
+    }
+
+    const double x0 = std::min({ a->x, b->x, c->x });
+    const double y0 = std::min({ a->y, b->y, c->y });
+    const double x1 = std::max({ a->x, b->x, c->x });
+    const double y1 = std::max({ a->y, b->y, c->y });
+    const std::uint32_t min_z = z_order(x0, y0);
+    const std::uint32_t max_z = z_order(x1, y1);
+
+    const auto blocks = [&](const node* p) {
+      return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c
+          && point_in_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && area(p->prev, p, p->next) >= 0;
+    };
+
+    // Walk the z-order list in both directions from the ear.
+    const node* p = ear->prev_z;
+    const node* n = ear->next_z;
+
+    while (p && p->z >= min_z && n && n->z <= max_z) {
+      if (blocks(p)) {
+        return false;
+      }
+
+      p = p->prev_z;
+
+      if (blocks(n)) {
+        return false;
+      }
+
+      n = n->next_z;
+    }
+
+    for (; p && p->z >= min_z; p = p->prev_z) {
+      if (blocks(p)) {
+        return false;
+      }
+    }
+
+    for (; n && n->z <= max_z; n = n->next_z) {
+      if (blocks(n)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  ear_clipper::node* ear_clipper::cure_local_intersections(node* start) {
+    node* p = start;
+
+    do {
+      node* a = p->prev;
+      node* b = p->next->next;
+
+      if (!equals(a, b) && intersects(a, p, p->next, b) && locally_inside(a, b) && locally_inside(b, a)) {
+        emit(a, p, b);
+        remove_node(p);
+        remove_node(p->next);
+        p = start = b;
+      }
+
+      p = p->next;
+    } while (p != start);
+
+    return filter_points(p);
+  }
+
+  void ear_clipper::split_earcut(node* start) {
+    node* a = start;
+
+    do {
+      for (node* b = a->next->next; b != a->prev; b = b->next) {
+        if (a->i != b->i && is_valid_diagonal(a, b)) {
+          node* c = split_polygon(a, b);
+          a = filter_points(a, a->next);
+          c = filter_points(c, c->next);
+          earcut_linked(a, 0);
+          earcut_linked(c, 0);
+          return;
+        }
+      }
+
+      a = a->next;
+    } while (a != start);
+  }
+
+  ear_clipper::node* ear_clipper::eliminate_holes(const double* xs, const double* ys,
+      const triangulation_rings& rings, node* outer) {
+    _queue.clear();
+
+    for (std::size_t i = 1; i < rings.size(); i++) {
+      node* list = linked_list(xs, ys, rings[i].first, rings[i].second, false);
+      if (!list) {
+        continue;
+      }
+
+      if (list == list->next) {
+        list->steiner = true;
+      }
+
+      _queue.push_back(leftmost(list));
+    }
+
+    std::sort(_queue.begin(), _queue.end(), [](const node* a, const node* b) { return a->x < b->x; });
+
+    for (node* hole : _queue) {
+      outer = eliminate_hole(hole, outer);
+    }
+
+    return outer;
+  }
+
+  ear_clipper::node* ear_clipper::eliminate_hole(node* hole, node* outer) {
+    node* bridge = find_hole_bridge(hole, outer);
+    if (!bridge) {
+      return outer;
+    }
+
+    node* bridge_reverse = split_polygon(bridge, hole);
+    filter_points(bridge_reverse, bridge_reverse->next);
+    return filter_points(bridge, bridge->next);
+  }
+
+  // Casts a ray from the leftmost hole vertex to the left and connects it to the
+  // closest visible outer vertex.
+  ear_clipper::node* ear_clipper::find_hole_bridge(node* hole, node* outer) const {
+    node* p = outer;
+    const double hx = hole->x;
+    const double hy = hole->y;
+    double qx = -std::numeric_limits<double>::infinity();
+    node* m = nullptr;
+
+    do {
+      if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+        const double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+        if (x <= hx && x > qx) {
+          qx = x;
+          m = p->x < p->next->x ? p : p->next;
+
+          if (x == hx) {
+            return m;
+          }
+        }
+      }
+
+      p = p->next;
+    } while (p != outer);
+
+    if (!m) {
+      return nullptr;
+    }
+
+    const node* stop = m;
+    const double mx = m->x;
+    const double my = m->y;
+    double tan_min = std::numeric_limits<double>::infinity();
+    p = m;
+
+    do {
+      if (hx >= p->x && p->x >= mx && hx != p->x
+          && point_in_triangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+        const double tan = std::abs(hy - p->y) / (hx - p->x);
+
+        if (locally_inside(p, hole)
+            && (tan < tan_min
+                || (tan == tan_min && (p->x > m->x || (p->x == m->x && sector_contains_sector(m, p)))))) {
+          m = p;
+          tan_min = tan;
+        }
+      }
+
+      p = p->next;
+    } while (p != stop);
+
+    return m;
+  }
+
+  void ear_clipper::index_curve(node* start) {
+    node* p = start;
+
+    do {
+      if (p->z == 0) {
+        p->z = z_order(p->x, p->y);
+      }
+
+      p->prev_z = p->prev;
+      p->next_z = p->next;
+      p = p->next;
+    } while (p != start);
+
+    p->prev_z->next_z = nullptr;
+    p->prev_z = nullptr;
+    sort_linked(p);
+  }
+
+  // Bottom-up merge sort of the z-order list.
+  ear_clipper::node* ear_clipper::sort_linked(node* list) {
+    std::size_t in_size = 1;
+    std::size_t merges = 0;
+
+    do {
+      node* p = list;
+      node* tail = nullptr;
+      list = nullptr;
+      merges = 0;
+
+      while (p) {
+        merges++;
+        node* q = p;
+        std::size_t p_size = 0;
+
+        for (std::size_t i = 0; i < in_size; i++) {
+          p_size++;
+          q = q->next_z;
+
+          if (!q) {
+            break;
+          }
+        }
+
+        std::size_t q_size = in_size;
+
+        while (p_size > 0 || (q_size > 0 && q)) {
+          node* e = nullptr;
+
+          if (p_size != 0 && (q_size == 0 || !q || p->z <= q->z)) {
+            e = p;
+            p = p->next_z;
+            p_size--;
+          }
+          else {
+            e = q;
+            q = q->next_z;
+            q_size--;
+          }
+
+          if (tail) {
+            tail->next_z = e;
+          }
+          else {
+            list = e;
+          }
+
+          e->prev_z = tail;
+          tail = e;
+        }
+
+        p = q;
+      }
+
+      tail->next_z = nullptr;
+      in_size *= 2;
+    } while (merges > 1);
+
+    return list;
+  }
+
+  std::uint32_t ear_clipper::z_order(double x, double y) const {
+    std::uint32_t ix = static_cast<std::uint32_t>((x - _min_x) * _inv_size);
+    std::uint32_t iy = static_cast<std::uint32_t>((y - _min_y) * _inv_size);
+
+    ix = (ix | (ix << 8)) & 0x00FF00FF;
+    ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+    ix = (ix | (ix << 2)) & 0x33333333;
+    ix = (ix | (ix << 1)) & 0x55555555;
+
+    iy = (iy | (iy << 8)) & 0x00FF00FF;
+    iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+    iy = (iy | (iy << 2)) & 0x33333333;
+    iy = (iy | (iy << 1)) & 0x55555555;
+
+    return ix | (iy << 1);
+  }
+
+  ear_clipper::node* ear_clipper::leftmost(node* start) {
+    node* p = start;
+    node* left = start;
+
+    do {
+      if (p->x < left->x || (p->x == left->x && p->y < left->y)) {
+        left = p;
+      }
+
+      p = p->next;
+    } while (p != start);
+
+    return left;
+  }
+
+  double ear_clipper::area(const node* p, const node* q, const node* r) {
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+  }
+
+  bool ear_clipper::equals(const node* a, const node* b) {
+    return a->x == b->x && a->y == b->y;
+  }
+
+  bool ear_clipper::point_in_triangle(
+      double ax, double ay, double bx, double by, double cx, double cy, double px, double py) {
+    return (cx - px) * (ay - py) >= (ax - px) * (cy - py) && (ax - px) * (by - py) >= (bx - px) * (ay - py)
+        && (bx - px) * (cy - py) >= (cx - px) * (by - py);
+  }
+
+  bool ear_clipper::on_segment(const node* p, const node* q, const node* r) {
+    return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x) && q->y <= std::max(p->y, r->y)
+        && q->y >= std::min(p->y, r->y);
+  }
+
+  bool ear_clipper::intersects(const node* p1, const node* q1, const node* p2, const node* q2) {
+    const auto sign = [](double v) { return v > 0 ? 1 : (v < 0 ? -1 : 0); };
+    const int o1 = sign(area(p1, q1, p2));
+    const int o2 = sign(area(p1, q1, q2));
+    const int o3 = sign(area(p2, q2, p1));
+    const int o4 = sign(area(p2, q2, q1));
+
+    return (o1 != o2 && o3 != o4) || (o1 == 0 && on_segment(p1, p2, q1)) || (o2 == 0 && on_segment(p1, q2, q1))
+        || (o3 == 0 && on_segment(p2, p1, q2)) || (o4 == 0 && on_segment(p2, q1, q2));
+  }
+
+  bool ear_clipper::intersects_polygon(const node* a, const node* b) {
+    const node* p = a;
+
+    do {
+      if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i
+          && intersects(p, p->next, a, b)) {
+        return true;
+      }
+
+      p = p->next;
+    } while (p != a);
+
+    return false;
+  }
+
+  bool ear_clipper::locally_inside(const node* a, const node* b) {
+    return area(a->prev, a, a->next) < 0 ? area(a, b, a->next) >= 0 && area(a, a->prev, b) >= 0
+                                         : area(a, b, a->prev) < 0 || area(a, a->next, b) < 0;
+  }
+
+  bool ear_clipper::middle_inside(const node* a, const node* b) {
+    const node* p = a;
+    bool inside = false;
+    const double px = (a->x + b->x) / 2;
+    const double py = (a->y + b->y) / 2;
+
+    do {
+      if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y
+          && (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x)) {
+        inside = !inside;
+      }
+
+      p = p->next;
+    } while (p != a);
+
+    return inside;
+  }
+
+  bool ear_clipper::is_valid_diagonal(const node* a, const node* b) {
+    return a->next->i != b->i && a->prev->i != b->i && !intersects_polygon(a, b)
+        && ((locally_inside(a, b) && locally_inside(b, a) && middle_inside(a, b)
+                && (area(a->prev, a, b->prev) != 0 || area(a, b->prev, b) != 0))
+            || (equals(a, b) && area(a->prev, a, a->next) > 0 && area(b->prev, b, b->next) > 0));
+  }
+
+  bool ear_clipper::sector_contains_sector(const node* m, const node* p) {
+    return area(m->prev, m, p->prev) < 0 && area(p->next, m, m->next) < 0;
+  }
+
+  // Links a to b with two new nodes, splitting the list in two. Returns the node
+  // starting the second list.
+  ear_clipper::node* ear_clipper::split_polygon(node* a, node* b) {
+    node* a2 = &_nodes.emplace_back(*a);
+    node* b2 = &_nodes.emplace_back(*b);
+    a2->prev_z = a2->next_z = nullptr;
+    b2->prev_z = b2->next_z = nullptr;
+    a2->z = b2->z = 0;
+    a2->steiner = b2->steiner = false;
+
+    node* an = a->next;
+    node* bp = b->prev;
+
+    a->next = b;
+    b->prev = a;
+
+    a2->next = an;
+    an->prev = a2;
+
+    b2->next = a2;
+    a2->prev = b2;
+
+    bp->next = b2;
+    b2->prev = bp;
+
+    return b2;
+  }
+
+  //
+  // MARK: - monotone_triangulator -
+  //
+
+  bool monotone_triangulator::above(std::uint32_t a, std::uint32_t b) const NANO_NOEXCEPT {
+    return _ys[a] > _ys[b] || (_ys[a] == _ys[b] && _xs[a] < _xs[b]);
+  }
+
+  double monotone_triangulator::cross(std::uint32_t o, std::uint32_t a, std::uint32_t b) const NANO_NOEXCEPT {
+    return (_xs[a] - _xs[o]) * (_ys[b] - _ys[o]) - (_ys[a] - _ys[o]) * (_xs[b] - _xs[o]);
+  }
+
+  // Edge `e` goes from vertex e to _next[e], the probe stands for the current vertex.
+  double monotone_triangulator::x_at(std::uint32_t e) const NANO_NOEXCEPT {
+    if (e == npos) {
+      return _probe_x;
+    }
+
+    const std::uint32_t b = _next[e];
+    if (_ys[e] == _ys[b]) {
+      return _xs[e];
+    }
+
+    return _xs[e] + (_sweep_y - _ys[e]) * (_xs[b] - _xs[e]) / (_ys[b] - _ys[e]);
+  }
+
+  bool monotone_triangulator::edge_less::operator()(std::uint32_t a, std::uint32_t b) const {
+    const double xa = self->x_at(a);
+    const double xb = self->x_at(b);
+
+    if (xa != xb) {
+      return xa < xb;
+    }
+
+    if (a == npos || b == npos) {
+      return a == npos && b != npos;
+    }
+
+    // Same position on the sweep line, order by the x of their lower end.
+    const double la = self->_xs[self->_next[a]];
+    const double lb = self->_xs[self->_next[b]];
+    return la != lb ? la < lb : a < b;
+  }
+
+  bool monotone_triangulator::is_merge(std::uint32_t v) const NANO_NOEXCEPT {
+    return above(_prev[v], v) && above(_next[v], v) && cross(_prev[v], v, _next[v]) < 0;
+  }
+
+  std::uint32_t monotone_triangulator::left_edge(status_type& status, std::uint32_t v) {
+    _probe_x = _xs[v];
+    status_type::iterator it = status.lower_bound(npos);
+    return it == status.begin() ? npos : *--it;
+  }
+
+  bool monotone_triangulator::run(const double* xs, const double* ys,
+      const triangulation_rings& rings, std::vector<std::uint32_t>& triangles) {
+    _xs = xs;
+    _ys = ys;
+
+    std::uint32_t vertex_count = 0;
+    for (const std::pair<std::uint32_t, std::uint32_t>& ring : rings) {
+      vertex_count = std::max(vertex_count, ring.second);
+    }
+
+    _next.assign(vertex_count, npos);
+    _prev.assign(vertex_count, npos);
+    _vertices.clear();
+    _diagonals.clear();
+
+    // Link the rings so that the interior is on the left of every edge, skipping
+    // repeated points.
+    std::size_t hole_count = 0;
+    for (std::size_t r = 0; r < rings.size(); r++) {
+      const std::uint32_t first = rings[r].first;
+      const std::uint32_t last = rings[r].second;
+      const std::size_t ring_start = _vertices.size();
+
+      double sum = 0;
+      for (std::uint32_t i = first, j = last - 1; i < last; j = i++) {
+        sum += xs[j] * ys[i] - xs[i] * ys[j];
+      }
+
+      const bool forward = (r == 0) == (sum > 0);
+      for (std::uint32_t k = 0; k < last - first; k++) {
+        const std::uint32_t i = forward ? first + k : last - 1 - k;
+        const std::size_t count = _vertices.size() - ring_start;
+
+        if (count && xs[i] == xs[_vertices.back()] && ys[i] == ys[_vertices.back()]) {
+          continue;
+        }
+
+        _vertices.push_back(i);
+      }
+
+      while (_vertices.size() - ring_start > 1 && xs[_vertices.back()] == xs[_vertices[ring_start]]
+          && ys[_vertices.back()] == ys[_vertices[ring_start]]) {
+        _vertices.pop_back();
+      }
+
+      const std::size_t count = _vertices.size() - ring_start;
+      if (count < 3) {
+        if (r == 0) {
+          return false;
+        }
+
+        _vertices.resize(ring_start);
+        continue;
+      }
+
+      hole_count += r != 0;
+      for (std::size_t k = 0; k < count; k++) {
+        const std::uint32_t v = _vertices[ring_start + k];
+        const std::uint32_t n = _vertices[ring_start + (k + 1) % count];
+        _next[v] = n;
+        _prev[n] = v;
+      }
+    }
+
+    std::sort(_vertices.begin(), _vertices.end(), [this](std::uint32_t a, std::uint32_t b) { return above(a, b); });
+
+    _helper.assign(vertex_count, npos);
+    status_type status(edge_less{ this });
+    _edge_its.assign(vertex_count, status.end());
+    _left_chain.assign(vertex_count, 0);
+
+    const auto insert_edge = [&](std::uint32_t e, std::uint32_t helper) {
+      _edge_its[e] = status.insert(e).first;
+      _helper[e] = helper;
+    };
+
+    const auto remove_edge = [&](std::uint32_t e, std::uint32_t v) {
+      if (_helper[e] != npos && is_merge(_helper[e])) {
+        _diagonals.emplace_back(v, _helper[e]);
+      }
+
+      if (_edge_its[e] != status.end()) {
+        status.erase(_edge_its[e]);
+        _edge_its[e] = status.end();
+      }
+    };
+
+    const auto connect_left = [&](std::uint32_t v, bool always) -> bool {
+      const std::uint32_t e = left_edge(status, v);
+      if (e == npos) {
+        return false;
+      }
+
+      if (always || is_merge(_helper[e])) {
+        _diagonals.emplace_back(v, _helper[e]);
+      }
+
+      _helper[e] = v;
+      return true;
+    };
+
+    for (const std::uint32_t v : _vertices) {
+      _sweep_y = ys[v];
+      const std::uint32_t p = _prev[v];
+      const std::uint32_t n = _next[v];
+      const bool prev_below = above(v, p);
+      const bool next_below = above(v, n);
+      const bool convex = cross(p, v, n) > 0;
+
+      if (prev_below && next_below) {
+        // Start or split vertex.
+        if (!convex && !connect_left(v, true)) {
+          return false;
+        }
+
+        insert_edge(v, v);
+      }
+      else if (!prev_below && !next_below) {
+        // End or merge vertex.
+        remove_edge(p, v);
+
+        if (!convex && !connect_left(v, false)) {
+          return false;
+        }
+      }
+      else if (!prev_below) {
+        // Regular vertex with the interior on its right.
+        remove_edge(p, v);
+        insert_edge(v, v);
+      }
+      else if (!connect_left(v, false)) {
+        return false;
+      }
+    }
+
+    const std::size_t first_triangle = triangles.size();
+    build_faces(triangles);
+
+    // A simple polygon of n vertices and h holes has exactly n + 2h - 2 triangles.
+    const std::size_t expected = _vertices.size() + 2 * hole_count - 2;
+    if ((triangles.size() - first_triangle) / 3 != expected) {
+      triangles.resize(first_triangle);
+      return false;
+    }
+
+    return true;
+  }
+
+  // Splits the polygon along the diagonals: every edge and both sides of every
+  // diagonal are walked once, turning as much as possible to the left.
+  void monotone_triangulator::build_faces(std::vector<std::uint32_t>& triangles) {
+    const std::size_t vertex_count = _next.size();
+    _adjacency_offsets.assign(vertex_count + 1, 0);
+
+    for (const std::uint32_t v : _vertices) {
+      _adjacency_offsets[v + 1] += 2;
+    }
+
+    for (const std::pair<std::uint32_t, std::uint32_t>& d : _diagonals) {
+      _adjacency_offsets[d.first + 1]++;
+      _adjacency_offsets[d.second + 1]++;
+    }
+
+    for (std::size_t i = 0; i < vertex_count; i++) {
+      _adjacency_offsets[i + 1] += _adjacency_offsets[i];
+    }
+
+    _adjacency.assign(_adjacency_offsets.back(), npos);
+    _adjacency_fill.assign(_adjacency_offsets.begin(), _adjacency_offsets.end() - 1);
+    std::uint32_t* fill = _adjacency_fill.data();
+
+    for (const std::uint32_t v : _vertices) {
+      _adjacency[fill[v]++] = _next[v];
+      _adjacency[fill[v]++] = _prev[v];
+    }
+
+    for (const std::pair<std::uint32_t, std::uint32_t>& d : _diagonals) {
+      _adjacency[fill[d.first]++] = d.second;
+      _adjacency[fill[d.second]++] = d.first;
+    }
+
+    // Sort the neighbors of every vertex by angle.
+    for (const std::uint32_t v : _vertices) {
+      std::sort(_adjacency.begin() + _adjacency_offsets[v], _adjacency.begin() + _adjacency_offsets[v + 1],
+          [&](std::uint32_t a, std::uint32_t b) {
+            return std::atan2(_ys[a] - _ys[v], _xs[a] - _xs[v]) < std::atan2(_ys[b] - _ys[v], _xs[b] - _xs[v]);
+          });
+    }
+
+    _visited.assign(_adjacency.size(), 0);
+
+    for (const std::uint32_t v : _vertices) {
+      for (std::uint32_t k = _adjacency_offsets[v]; k < _adjacency_offsets[v + 1]; k++) {
+        // Reversed polygon edges bound the exterior.
+        if (_visited[k] || _adjacency[k] == _prev[v]) {
+          continue;
+        }
+
+        _face.clear();
+        std::uint32_t from = v;
+        std::uint32_t slot = k;
+
+        while (!_visited[slot] && _face.size() <= _vertices.size()) {
+          _visited[slot] = 1;
+          _face.push_back(from);
+          const std::uint32_t to = _adjacency[slot];
+
+          // Next edge: the one preceding the way back in the angular order around `to`.
+          const std::uint32_t first = _adjacency_offsets[to];
+          const std::uint32_t last = _adjacency_offsets[to + 1];
+          std::uint32_t back = first;
+          while (back < last && _adjacency[back] != from) {
+            back++;
+          }
+
+          slot = back == first ? last - 1 : back - 1;
+          from = to;
+        }
+
+        triangulate_face(triangles);
+      }
+    }
+  }
+
+  void monotone_triangulator::emit(
+      std::uint32_t a, std::uint32_t b, std::uint32_t c, std::vector<std::uint32_t>& triangles) const {
+    if (cross(a, b, c) < 0) {
+      std::swap(b, c);
+    }
+
+    triangles.push_back(a);
+    triangles.push_back(b);
+    triangles.push_back(c);
+  }
+
+  // Linear time triangulation of a y-monotone face whose vertices are in
+  // counter-clockwise order.
+  void monotone_triangulator::triangulate_face(std::vector<std::uint32_t>& triangles) {
+    const std::size_t n = _face.size();
+    if (n < 3) {
+      return;
+    }
+
+    if (n == 3) {
+      emit(_face[0], _face[1], _face[2], triangles);
+      return;
+    }
+
+    std::size_t top = 0;
+    std::size_t bottom = 0;
+    for (std::size_t i = 1; i < n; i++) {
+      top = above(_face[i], _face[top]) ? i : top;
+      bottom = above(_face[bottom], _face[i]) ? i : bottom;
+    }
+
+    // Walking forward from the top goes down the left chain, backward down the right one.
+    // Merge both chains in sweep order.
+    _sorted.clear();
+    _sorted.push_back(_face[top]);
+    _left_chain[_face[top]] = 0;
+
+    std::size_t l = (top + 1) % n;
+    std::size_t r = (top + n - 1) % n;
+
+    while (l != bottom || r != bottom) {
+      if (r == bottom || (l != bottom && above(_face[l], _face[r]))) {
+        _left_chain[_face[l]] = 1;
+        _sorted.push_back(_face[l]);
+        l = (l + 1) % n;
+      }
+      else {
+        _left_chain[_face[r]] = 0;
+        _sorted.push_back(_face[r]);
+        r = (r + n - 1) % n;
+      }
+    }
+
+    _left_chain[_face[bottom]] = 0;
+    _sorted.push_back(_face[bottom]);
+
+    _stack.clear();
+    _stack.push_back(_sorted[0]);
+    _stack.push_back(_sorted[1]);
+
+    for (std::size_t j = 2; j + 1 < _sorted.size(); j++) {
+      const std::uint32_t u = _sorted[j];
+
+      if (_left_chain[u] != _left_chain[_stack.back()]) {
+        for (std::size_t k = 0; k + 1 < _stack.size(); k++) {
+          emit(u, _stack[k], _stack[k + 1], triangles);
+        }
+
+        const std::uint32_t previous = _sorted[j - 1];
+        _stack.clear();
+        _stack.push_back(previous);
+        _stack.push_back(u);
+      }
+      else {
+        std::uint32_t last = _stack.back();
+        _stack.pop_back();
+
+        while (!_stack.empty()) {
+          const double c = cross(u, last, _stack.back());
+          const bool inside = _left_chain[u] ? c < 0 : c > 0;
+
+          if (!inside) {
+            break;
+          }
+
+          emit(u, last, _stack.back(), triangles);
+          last = _stack.back();
+          _stack.pop_back();
+        }
+
+        _stack.push_back(last);
+        _stack.push_back(u);
+      }
+    }
+
+    const std::uint32_t u = _sorted.back();
+    for (std::size_t k = 0; k + 1 < _stack.size(); k++) {
+      emit(u, _stack[k], _stack[k + 1], triangles);
+    }
+  }
+} // namespace detail.
+
+//
+// MARK: - polygon_triangulator -
+//
+
+template <typename T>
+template <typename Index>
+bool polygon_triangulator<T>::triangulate(
+    const polygon_type& poly, std::vector<Index>& indices, triangulation_method method) {
+  NANO_GEOMETRY_TRACE_SCOPE("polygon_triangulator::triangulate", poly.size(), poly.size() * sizeof(nano::point<T>));
+  static_assert(std::is_same_v<Index, std::uint16_t> || std::is_same_v<Index, std::uint32_t>,
+      "nano::polygon_triangulator supports 16 and 32 bit indices");
+
+  const std::size_t size = poly.size();
+  if (size < 3 || size - 1 > std::numeric_limits<Index>::max()) {
+    return false;
+  }
+
+  _xs.resize(size);
+  _ys.resize(size);
+  for (std::size_t i = 0; i < size; i++) {
+    _xs[i] = static_cast<double>(poly.points()[i].x);
+    _ys[i] = static_cast<double>(poly.points()[i].y);
+  }
+
+  _rings.clear();
+  for (std::size_t i = 0; i < poly.ring_count(); i++) {
+    if (poly.ring_end(i) > poly.ring_begin(i)) {
+      _rings.emplace_back(static_cast<std::uint32_t>(poly.ring_begin(i)), static_cast<std::uint32_t>(poly.ring_end(i)));
+    }
+  }
+
+  if (method == triangulation_method::automatic) {
+    method = size >= monotone_threshold ? triangulation_method::monotone : triangulation_method::ear_clipping;
+  }
+
+  _triangles.clear();
+  if (method != triangulation_method::monotone || !_monotone.run(_xs.data(), _ys.data(), _rings, _triangles)) {
+    _triangles.clear();
+    _ear_clipper.run(_xs.data(), _ys.data(), _rings, _triangles);
+  }
+
+  // Wind every triangle like the outer ring.
+  const bool outer_positive = poly.ring_signed_area(0) > 0;
+  indices.reserve(indices.size() + _triangles.size());
+
+  for (std::size_t i = 0; i < _triangles.size(); i += 3) {
+    const std::uint32_t a = _triangles[i];
+    std::uint32_t b = _triangles[i + 1];
+    std::uint32_t c = _triangles[i + 2];
+    const double cross = (_xs[b] - _xs[a]) * (_ys[c] - _ys[a]) - (_ys[b] - _ys[a]) * (_xs[c] - _xs[a]);
+
+    if (cross != 0 && (cross > 0) != outer_positive) {
+      std::swap(b, c);
+    }
+
+    indices.push_back(static_cast<Index>(a));
+    indices.push_back(static_cast<Index>(b));
+    indices.push_back(static_cast<Index>(c));
+  }
+
+  return true;
+}
+
+template <typename T>
+std::size_t polygon_triangulator<T>::max_triangle_count(const polygon_type& poly) NANO_NOEXCEPT {
+  return poly.size() < 3 ? 0 : poly.size() + 2 * poly.hole_count() - 2;
+}
+
+template <typename T, typename Index>
+bool triangulate(const nano::polygon_view<T>& poly, std::vector<Index>& indices, triangulation_method method) {
+  polygon_triangulator<T> triangulator;
+  return triangulator.triangulate(poly, indices, method);
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
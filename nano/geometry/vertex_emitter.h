@@ -0,0 +1,382 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/vertex_emitter.h
+ * @brief     nano vertex and index buffer emission
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/trace.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// MSVC does not define __has_builtin, the builtins below are then never used.
+#ifndef NANO_GEOMETRY_HAS_BUILTIN
+  #if defined(__has_builtin)
+    #define NANO_GEOMETRY_HAS_BUILTIN(x) __has_builtin(x)
+  #else
+    #define NANO_GEOMETRY_HAS_BUILTIN(x) 0
+  #endif
+#endif
+
+// SSE2 non-temporal stores (movnti) and sfence, used when the compiler has no
+// __builtin_nontemporal_store (GCC, MSVC).
+#ifndef NANO_GEOMETRY_HAS_SSE2_STREAM
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define NANO_GEOMETRY_HAS_SSE2_STREAM 1
+  #else
+    #define NANO_GEOMETRY_HAS_SSE2_STREAM 0
+  #endif
+#endif
+
+#if NANO_GEOMETRY_HAS_SSE2_STREAM
+  #include <emmintrin.h>
+#endif
+
+// 1 when vertex_emit_options::streaming writes with non-temporal stores.
+#ifndef NANO_GEOMETRY_HAS_STREAMING_STORES
+  #if NANO_GEOMETRY_HAS_BUILTIN(__builtin_nontemporal_store) || NANO_GEOMETRY_HAS_SSE2_STREAM
+    #define NANO_GEOMETRY_HAS_STREAMING_STORES 1
+  #else
+    #define NANO_GEOMETRY_HAS_STREAMING_STORES 0
+  #endif
+#endif
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Interleaved vertex with a position and texture coordinates.
+template <typename T>
+struct textured_vertex {
+  T x, y;
+  T u, v;
+};
+
+static_assert(std::is_trivial<textured_vertex<float>>::value, "nano::textured_vertex must remain a trivial type");
+
+/// Options shared by the vertex emitters.
+template <typename T>
+struct vertex_emit_options {
+  /// Applied to every corner when not null.
+  const nano::transform<T>* transform = nullptr;
+
+  /// One uv rect per item when not null, the full [0, 1] square otherwise (see atlas_uvs()).
+  const nano::rect<T>* uvs = nullptr;
+
+  /// Writes with non-temporal stores, for buffers that are not read back by the CPU
+  /// (e.g. mapped GPU memory). They come from __builtin_nontemporal_store when the
+  /// compiler has it and from SSE2 otherwise. When NANO_GEOMETRY_HAS_STREAMING_STORES
+  /// is 0 (neither is available) the stores are plain ones followed by a release fence.
+  bool streaming = false;
+};
+
+/// Number of vertices emitted per rect or quad.
+inline constexpr std::size_t vertices_per_quad = 4;
+
+/// Number of indices emitted per rect or quad.
+inline constexpr std::size_t indices_per_quad = 6;
+
+/// Writes 4 interleaved vertices per rect, in top-left, top-right, bottom-right,
+/// bottom-left order (the order of nano::quad).
+template <typename T>
+inline void emit_vertices(const nano::rect<T>* rects, std::size_t count, textured_vertex<T>* vertices,
+    const vertex_emit_options<T>& opts = {}) NANO_NOEXCEPT;
+
+/// Writes 4 interleaved vertices per quad.
+template <typename T>
+inline void emit_vertices(const nano::quad<T>* quads, std::size_t count, textured_vertex<T>* vertices,
+    const vertex_emit_options<T>& opts = {}) NANO_NOEXCEPT;
+
+/// Writes 4 positions and, when `uvs` is not null, 4 texture coordinates per rect in
+/// separate arrays.
+template <typename T>
+inline void emit_vertices(const nano::rect<T>* rects, std::size_t count, nano::point<T>* positions,
+    nano::point<T>* uvs, const vertex_emit_options<T>& opts = {}) NANO_NOEXCEPT;
+
+/// Writes 4 positions and optionally 4 texture coordinates per quad in separate arrays.
+template <typename T>
+inline void emit_vertices(const nano::quad<T>* quads, std::size_t count, nano::point<T>* positions,
+    nano::point<T>* uvs, const vertex_emit_options<T>& opts = {}) NANO_NOEXCEPT;
+
+/// Writes the 6 indices (two triangles: 0 1 2, 0 2 3) of `count` quads whose vertices
+/// start at `base_vertex`.
+///
+/// Returns false without writing anything if the last vertex does not fit in `Index`.
+template <typename Index>
+inline bool emit_quad_indices(Index* indices, std::size_t count, std::size_t base_vertex = 0) NANO_NOEXCEPT;
+
+/// Converts a placement in an atlas of `atlas_size` pixels to normalized texture coordinates.
+template <typename T>
+NANO_NODC_INLINE_CXPR nano::rect<T> atlas_uv(
+    const nano::rect<T>& placement, const nano::size<T>& atlas_size) NANO_NOEXCEPT;
+
+/// Converts `count` atlas placements, see atlas_uv().
+template <typename T>
+inline void atlas_uvs(const nano::rect<T>* placements, std::size_t count, const nano::size<T>& atlas_size,
+    nano::rect<T>* uvs) NANO_NOEXCEPT;
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+  template <bool Streaming, typename T>
+  NANO_INLINE void emit_store(T* dst, T value) NANO_NOEXCEPT {
+    if constexpr (Streaming) {
+#if NANO_GEOMETRY_HAS_BUILTIN(__builtin_nontemporal_store)
+      __builtin_nontemporal_store(value, dst);
+      return;
+#elif NANO_GEOMETRY_HAS_SSE2_STREAM
+      // movnti stores a 32 or 64 bit integer, the write-combining buffers merge the
+      // consecutive stores of a vertex into full lines.
+      if constexpr (sizeof(T) == sizeof(int)) {
+        int bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        _mm_stream_si32(reinterpret_cast<int*>(dst), bits);
+        return;
+      }
+  #if defined(__x86_64__) || defined(_M_X64)
+      else if constexpr (sizeof(T) == sizeof(long long)) {
+        long long bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        _mm_stream_si64(reinterpret_cast<long long*>(dst), bits);
+        return;
+      }
+  #endif
+#endif
+    }
+
+    *dst = value;
+  }
+
+  /// Orders the non-temporal stores before any following store.
+  inline void emit_fence() NANO_NOEXCEPT {
+#if NANO_GEOMETRY_HAS_SSE2_STREAM
+    _mm_sfence();
+#else
+    std::atomic_thread_fence(std::memory_order_release);
+#endif
+  }
+
+  template <typename T>
+  struct emit_corners {
+    nano::point<T> p[4];
+  };
+
+  template <typename T>
+  NANO_INLINE emit_corners<T> corners_of(const nano::rect<T>& r) NANO_NOEXCEPT {
+    const T l = r.origin.x;
+    const T t = r.origin.y;
+    const T rr = r.origin.x + r.size.width;
+    const T b = r.origin.y + r.size.height;
+    return { { { l, t }, { rr, t }, { rr, b }, { l, b } } };
+  }
+
+  template <typename T>
+  NANO_INLINE emit_corners<T> corners_of(const nano::quad<T>& q) NANO_NOEXCEPT {
+    return { { q.top_left, q.top_right, q.bottom_right, q.bottom_left } };
+  }
+
+  /// Calls `write(vertex, position, uv)` for the 4 corners of every item.
+  template <bool Transformed, typename T, typename E, typename Write>
+  NANO_INLINE void emit_items(const E* items, std::size_t count, const vertex_emit_options<T>& opts, Write&& write) {
+    const nano::transform<T> t = Transformed ? *opts.transform : nano::transform<T>::identity();
+    const nano::rect<T> full_uv = { 0, 0, 1, 1 };
+
+    for (std::size_t i = 0; i < count; i++) {
+      emit_corners<T> c = corners_of(items[i]);
+      const emit_corners<T> uv = corners_of(opts.uvs ? opts.uvs[i] : full_uv);
+
+      if constexpr (Transformed) {
+        for (nano::point<T>& p : c.p) {
+          p = t.apply(p);
+        }
+      }
+
+      for (std::size_t k = 0; k < vertices_per_quad; k++) {
+        write(i * vertices_per_quad + k, c.p[k], uv.p[k]);
+      }
+    }
+  }
+
+  template <bool Streaming, typename T, typename E>
+  inline void emit_interleaved(
+      const E* items, std::size_t count, textured_vertex<T>* vertices, const vertex_emit_options<T>& opts) {
+    const auto write = [vertices](std::size_t v, const nano::point<T>& p, const nano::point<T>& uv) {
+      emit_store<Streaming>(&vertices[v].x, p.x);
+      emit_store<Streaming>(&vertices[v].y, p.y);
+      emit_store<Streaming>(&vertices[v].u, uv.x);
+      emit_store<Streaming>(&vertices[v].v, uv.y);
+    };
+
+    if (opts.transform) {
+      emit_items<true>(items, count, opts, write);
+    }
+    else {
+      emit_items<false>(items, count, opts, write);
+    }
+  }
+
+  template <bool Streaming, typename T, typename E>
+  inline void emit_planar(const E* items, std::size_t count, nano::point<T>* positions, nano::point<T>* uvs,
+      const vertex_emit_options<T>& opts) {
+    const auto write = [positions, uvs](std::size_t v, const nano::point<T>& p, const nano::point<T>& uv) {
+      emit_store<Streaming>(&positions[v].x, p.x);
+      emit_store<Streaming>(&positions[v].y, p.y);
+
+      if (uvs) {
+        emit_store<Streaming>(&uvs[v].x, uv.x);
+        emit_store<Streaming>(&uvs[v].y, uv.y);
+      }
+    };
+
+    if (opts.transform) {
+      emit_items<true>(items, count, opts, write);
+    }
+    else {
+      emit_items<false>(items, count, opts, write);
+    }
+  }
+
+  template <typename T, typename E>
+  inline void emit_vertices(
+      const E* items, std::size_t count, textured_vertex<T>* vertices, const vertex_emit_options<T>& opts) {
+    NANO_GEOMETRY_TRACE_SCOPE("emit_vertices", count, count * vertices_per_quad * sizeof(textured_vertex<T>));
+    if (opts.streaming) {
+      emit_interleaved<true>(items, count, vertices, opts);
+      emit_fence();
+    }
+    else {
+      emit_interleaved<false>(items, count, vertices, opts);
+    }
+  }
+
+  template <typename T, typename E>
+  inline void emit_vertices(const E* items, std::size_t count, nano::point<T>* positions, nano::point<T>* uvs,
+      const vertex_emit_options<T>& opts) {
+    NANO_GEOMETRY_TRACE_SCOPE("emit_vertices", count, count * vertices_per_quad * 2 * sizeof(nano::point<T>));
+    if (opts.streaming) {
+      emit_planar<true>(items, count, positions, uvs, opts);
+      emit_fence();
+    }
+    else {
+      emit_planar<false>(items, count, positions, uvs, opts);
+    }
+  }
+} // namespace detail.
+
+template <typename T>
+void emit_vertices(const nano::rect<T>* rects, std::size_t count, textured_vertex<T>* vertices,
+    const vertex_emit_options<T>& opts) NANO_NOEXCEPT {
+  detail::emit_vertices(rects, count, vertices, opts);
+}
+
+template <typename T>
+void emit_vertices(const nano::quad<T>* quads, std::size_t count, textured_vertex<T>* vertices,
+    const vertex_emit_options<T>& opts) NANO_NOEXCEPT {
+  detail::emit_vertices(quads, count, vertices, opts);
+}
+
+template <typename T>
+void emit_vertices(const nano::rect<T>* rects, std::size_t count, nano::point<T>* positions, nano::point<T>* uvs,
+    const vertex_emit_options<T>& opts) NANO_NOEXCEPT {
+  detail::emit_vertices(rects, count, positions, uvs, opts);
+}
+
+template <typename T>
+void emit_vertices(const nano::quad<T>* quads, std::size_t count, nano::point<T>* positions, nano::point<T>* uvs,
+    const vertex_emit_options<T>& opts) NANO_NOEXCEPT {
+  detail::emit_vertices(quads, count, positions, uvs, opts);
+}
+
+template <typename Index>
+bool emit_quad_indices(Index* indices, std::size_t count, std::size_t base_vertex) NANO_NOEXCEPT {
+  static_assert(std::is_same_v<Index, std::uint16_t> || std::is_same_v<Index, std::uint32_t>,
+      "nano::emit_quad_indices supports 16 and 32 bit indices");
+
+  if (count == 0) {
+    return true;
+  }
+
+  const std::size_t last_vertex = base_vertex + count * vertices_per_quad - 1;
+  if (last_vertex > std::numeric_limits<Index>::max()) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < count; i++) {
+    const Index v = static_cast<Index>(base_vertex + i * vertices_per_quad);
+    Index* dst = indices + i * indices_per_quad;
+    dst[0] = v;
+    dst[1] = static_cast<Index>(v + 1);
+    dst[2] = static_cast<Index>(v + 2);
+    dst[3] = v;
+    dst[4] = static_cast<Index>(v + 2);
+    dst[5] = static_cast<Index>(v + 3);
+  }
+
+  return true;
+}
+
+namespace detail {
+  /// Placement times the reciprocals of the atlas size. Both atlas_uv() and atlas_uvs() use it
+  /// so that they give the same bits, the batch only computes the reciprocals once.
+  template <typename T>
+  NANO_NODC_INLINE_CXPR nano::rect<T> atlas_uv(const nano::rect<T>& placement, T sx, T sy) NANO_NOEXCEPT {
+    return nano::rect<T>(
+        placement.origin.x * sx, placement.origin.y * sy, placement.size.width * sx, placement.size.height * sy);
+  }
+} // namespace detail.
+
+template <typename T>
+NANO_INLINE_CXPR nano::rect<T> atlas_uv(
+    const nano::rect<T>& placement, const nano::size<T>& atlas_size) NANO_NOEXCEPT {
+  return detail::atlas_uv(placement, T(1) / atlas_size.width, T(1) / atlas_size.height);
+}
+
+template <typename T>
+void atlas_uvs(const nano::rect<T>* placements, std::size_t count, const nano::size<T>& atlas_size,
+    nano::rect<T>* uvs) NANO_NOEXCEPT {
+  const T sx = T(1) / atlas_size.width;
+  const T sy = T(1) / atlas_size.height;
+
+  for (std::size_t i = 0; i < count; i++) {
+    uvs[i] = detail::atlas_uv(placements[i], sx, sy);
+  }
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
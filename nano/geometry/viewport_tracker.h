@@ -0,0 +1,183 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/viewport_tracker.h
+ * @brief     nano incremental viewport visibility
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/rect_index.h>
+#include <array>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Decomposes `a - b` into at most four disjoint rects and returns how many were written.
+///
+/// The top and bottom strips span the full width of `a`, the left and right ones
+/// only the band shared with `b`.
+template <typename T>
+inline std::size_t rect_difference(const nano::rect<T>& a, const nano::rect<T>& b, std::array<nano::rect<T>, 4>& out);
+
+/// Keeps track of the items of a rect_index visible through a moving viewport.
+///
+/// Instead of querying the whole viewport and diffing the results, only the strips
+/// between the previous and the new viewport are queried, so the cost of an update
+/// is proportional to the number of items crossing the viewport edges.
+///
+/// The tracker keeps a pointer to the index, which must outlive it and must not be
+/// rebuilt between two updates.
+template <typename T>
+class viewport_tracker {
+public:
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using index_type = nano::rect_index<value_type>;
+  using id_type = typename index_type::id_type;
+
+  inline viewport_tracker(const index_type& index) NANO_NOEXCEPT;
+
+  inline viewport_tracker(const index_type& index, const rect_type& viewport) NANO_NOEXCEPT;
+
+  /// Sets the viewport without computing any difference.
+  inline void reset(const rect_type& viewport) NANO_NOEXCEPT;
+
+  /// Moves the viewport and appends the ids of the items that became visible to
+  /// `entered` and the ones that are no longer visible to `exited`.
+  ///
+  /// Visibility is defined by rect::intersects.
+  inline void update(const rect_type& viewport, std::vector<id_type>& entered, std::vector<id_type>& exited);
+
+  NANO_NODC_INLINE const rect_type& viewport() const NANO_NOEXCEPT;
+
+private:
+  const index_type* _index;
+  rect_type _viewport;
+
+  /// Appends the items intersecting `to` but not `from`, visiting only `to - from`.
+  inline void collect(const rect_type& from, const rect_type& to, std::vector<id_type>& ids) const;
+};
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+template <typename T>
+std::size_t rect_difference(const nano::rect<T>& a, const nano::rect<T>& b, std::array<nano::rect<T>, 4>& out) {
+  if (a.width <= 0 || a.height <= 0) {
+    return 0;
+  }
+
+  if (!a.intersects(b)) {
+    out[0] = a;
+    return 1;
+  }
+
+  std::size_t count = 0;
+
+  if (b.top() > a.top()) {
+    out[count++] = nano::rect<T>(a.x, a.y, a.width, b.top() - a.top());
+  }
+
+  if (b.bottom() < a.bottom()) {
+    out[count++] = nano::rect<T>(a.x, b.bottom(), a.width, a.bottom() - b.bottom());
+  }
+
+  const T band_top = std::max(a.top(), b.top());
+  const T band_height = std::min(a.bottom(), b.bottom()) - band_top;
+
+  if (b.left() > a.left()) {
+    out[count++] = nano::rect<T>(a.x, band_top, b.left() - a.left(), band_height);
+  }
+
+  if (b.right() < a.right()) {
+    out[count++] = nano::rect<T>(b.right(), band_top, a.right() - b.right(), band_height);
+  }
+
+  return count;
+}
+
+template <typename T>
+viewport_tracker<T>::viewport_tracker(const index_type& index) NANO_NOEXCEPT : _index(&index),
+                                                                                _viewport{ 0, 0, 0, 0 } {}
+
+template <typename T>
+viewport_tracker<T>::viewport_tracker(const index_type& index, const rect_type& viewport) NANO_NOEXCEPT
+    : _index(&index),
+      _viewport(viewport) {}
+
+template <typename T>
+void viewport_tracker<T>::reset(const rect_type& viewport) NANO_NOEXCEPT {
+  _viewport = viewport;
+}
+
+template <typename T>
+void viewport_tracker<T>::update(
+    const rect_type& viewport, std::vector<id_type>& entered, std::vector<id_type>& exited) {
+  collect(_viewport, viewport, entered);
+  collect(viewport, _viewport, exited);
+  _viewport = viewport;
+}
+
+template <typename T>
+const typename viewport_tracker<T>::rect_type& viewport_tracker<T>::viewport() const NANO_NOEXCEPT {
+  return _viewport;
+}
+
+template <typename T>
+void viewport_tracker<T>::collect(const rect_type& from, const rect_type& to, std::vector<id_type>& ids) const {
+  std::array<rect_type, 4> strips;
+  const std::size_t count = rect_difference(to, from, strips);
+
+  for (std::size_t i = 0; i < count; i++) {
+    _index->query(strips[i], [&](id_type id, const rect_type& r) {
+      if (r.intersects(from)) {
+        return;
+      }
+
+      // An item spanning several strips is only reported by the first one it touches.
+      for (std::size_t k = 0; k < i; k++) {
+        if (r.intersects(strips[k])) {
+          return;
+        }
+      }
+
+      ids.push_back(id);
+    });
+  }
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,440 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/views.h
+ * @brief     nano lazy geometry views
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/transform_cull.h>
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+namespace detail {
+  template <typename T>
+  struct view_transform;
+
+  template <typename T>
+  struct view_offset;
+
+  template <typename T>
+  struct view_clip;
+
+  template <typename T>
+  struct view_filter;
+
+  template <typename E>
+  struct view_element_traits;
+} // namespace detail.
+
+/// Lazy pipeline over a contiguous range of points, rects or quads.
+///
+/// Adaptors only record a stage, nothing is evaluated until a terminal operation
+/// (for_each(), count(), bounds(), copy_to()) is called. The pipeline is then run in a
+/// single pass over the input, `chunk_size` elements at a time: each chunk is copied to
+/// a stack buffer, every stage runs over the whole buffer as a straight loop (filters
+/// only clear a mask), and the terminal operation consumes the survivors. No memory is
+/// allocated and the stage loops have no branches the compiler cannot vectorize.
+///
+/// - transformed_by(t): applies `t`. A rect becomes the bounding rect of its transformed
+///   quad.
+/// - offset_by(p): moves every element by `p`.
+/// - clipped_to(r): rects are replaced by their intersection with `r` and dropped when
+///   they do not intersect it, points outside of `r` are dropped. Quads are dropped when
+///   their bounding rect does not intersect `r` and are otherwise kept unchanged.
+/// - filtered_intersecting(r): keeps the rects and the quad bounding rects intersecting
+///   `r` and the points contained in `r`, unchanged.
+///
+/// A view keeps a pointer to the input, which must outlive it.
+template <typename E, typename... Stages>
+class geometry_view {
+public:
+  using element_type = E;
+  using value_type = typename detail::view_element_traits<E>::value_type;
+  using rect_type = nano::rect<value_type>;
+  using point_type = nano::point<value_type>;
+  using transform_type = nano::transform<value_type>;
+
+  /// Number of elements processed by each stage at once.
+  static constexpr std::size_t chunk_size = 256;
+
+  NANO_INLINE_CXPR geometry_view(const E* data, std::size_t size, std::tuple<Stages...> stages) NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE geometry_view<E, Stages..., detail::view_transform<value_type>> transformed_by(
+      const transform_type& t) const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE geometry_view<E, Stages..., detail::view_offset<value_type>> offset_by(
+      const point_type& p) const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE geometry_view<E, Stages..., detail::view_clip<value_type>> clipped_to(
+      const rect_type& r) const NANO_NOEXCEPT;
+
+  NANO_NODC_INLINE geometry_view<E, Stages..., detail::view_filter<value_type>> filtered_intersecting(
+      const rect_type& r) const NANO_NOEXCEPT;
+
+  /// Calls `fct(element)` for every element surviving the pipeline, in input order.
+  template <typename Fct>
+  inline void for_each(Fct&& fct) const;
+
+  /// Number of elements surviving the pipeline.
+  NANO_NODC_INLINE std::size_t count() const;
+
+  /// Bounding rect of the elements surviving the pipeline, {0, 0, 0, 0} if there are none.
+  NANO_NODC_INLINE rect_type bounds() const;
+
+  /// Writes the surviving elements to `out` and returns the end of the written range.
+  template <typename OutputIt>
+  inline OutputIt copy_to(OutputIt out) const;
+
+  /// Size of the input.
+  NANO_NODC_INLINE_CXPR std::size_t input_size() const NANO_NOEXCEPT;
+
+private:
+  const E* _data;
+  std::size_t _size;
+  std::tuple<Stages...> _stages;
+
+  template <typename Stage>
+  NANO_NODC_INLINE geometry_view<E, Stages..., Stage> then(const Stage& stage) const NANO_NOEXCEPT;
+
+  /// Runs the stages chunk by chunk and calls `fct(buffer, mask, count)` for each chunk.
+  template <typename Fct>
+  inline void evaluate(Fct&& fct) const;
+};
+
+/// Starts a pipeline over `size` elements.
+template <typename E>
+NANO_NODC_INLINE_CXPR geometry_view<E> make_view(const E* data, std::size_t size) NANO_NOEXCEPT;
+
+template <typename E>
+NANO_NODC_INLINE geometry_view<E> make_view(const std::vector<E>& data) NANO_NOEXCEPT;
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+namespace detail {
+  template <typename T>
+  struct view_element_traits<nano::point<T>> {
+    using value_type = T;
+  };
+
+  template <typename T>
+  struct view_element_traits<nano::rect<T>> {
+    using value_type = T;
+  };
+
+  template <typename T>
+  struct view_element_traits<nano::quad<T>> {
+    using value_type = T;
+  };
+
+  /// Bounding rect of a quad, used where a quad cannot be processed exactly.
+  template <typename T>
+  NANO_NODC_INLINE nano::rect<T> view_quad_bounds(const nano::quad<T>& q) NANO_NOEXCEPT {
+    const T l = std::min(std::min(q.top_left.x, q.top_right.x), std::min(q.bottom_right.x, q.bottom_left.x));
+    const T t = std::min(std::min(q.top_left.y, q.top_right.y), std::min(q.bottom_right.y, q.bottom_left.y));
+    const T r = std::max(std::max(q.top_left.x, q.top_right.x), std::max(q.bottom_right.x, q.bottom_left.x));
+    const T b = std::max(std::max(q.top_left.y, q.top_right.y), std::max(q.bottom_right.y, q.bottom_left.y));
+    return nano::rect<T>::create_from_point({ l, t }, { r, b });
+  }
+
+  template <typename T>
+  struct view_transform {
+    nano::transform<T> t;
+
+    inline void apply(nano::point<T>* p, unsigned char*, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        p[i] = t.apply(p[i]);
+      }
+    }
+
+    inline void apply(nano::rect<T>* r, unsigned char*, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        r[i] = transformed_bounds(t, r[i]);
+      }
+    }
+
+    inline void apply(nano::quad<T>* q, unsigned char*, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        q[i] = t.apply(q[i]);
+      }
+    }
+  };
+
+  template <typename T>
+  struct view_offset {
+    nano::point<T> offset;
+
+    inline void apply(nano::point<T>* p, unsigned char*, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        p[i].x += offset.x;
+        p[i].y += offset.y;
+      }
+    }
+
+    inline void apply(nano::rect<T>* r, unsigned char*, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        r[i].origin.x += offset.x;
+        r[i].origin.y += offset.y;
+      }
+    }
+
+    inline void apply(nano::quad<T>* q, unsigned char*, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        q[i].top_left += offset;
+        q[i].top_right += offset;
+        q[i].bottom_right += offset;
+        q[i].bottom_left += offset;
+      }
+    }
+  };
+
+  template <typename T>
+  struct view_clip {
+    nano::rect<T> clip;
+
+    inline void apply(nano::point<T>* p, unsigned char* mask, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        mask[i] &= static_cast<unsigned char>(clip.contains(p[i]));
+      }
+    }
+
+    inline void apply(nano::rect<T>* r, unsigned char* mask, std::size_t n) const NANO_NOEXCEPT {
+      const T cl = clip.origin.x;
+      const T ct = clip.origin.y;
+      const T cr = clip.origin.x + clip.size.width;
+      const T cb = clip.origin.y + clip.size.height;
+
+      for (std::size_t i = 0; i < n; i++) {
+        const T l = std::max(r[i].origin.x, cl);
+        const T t = std::max(r[i].origin.y, ct);
+        const T w = std::min(r[i].origin.x + r[i].size.width, cr) - l;
+        const T h = std::min(r[i].origin.y + r[i].size.height, cb) - t;
+        mask[i] &= static_cast<unsigned char>(w > 0 && h > 0);
+        r[i].origin.x = l;
+        r[i].origin.y = t;
+        r[i].size.width = w;
+        r[i].size.height = h;
+      }
+    }
+
+    // A quad cut by a rect is no longer a quad, quads are only dropped by their bounds.
+    inline void apply(nano::quad<T>* q, unsigned char* mask, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        mask[i] &= static_cast<unsigned char>(clip.intersects(view_quad_bounds(q[i])));
+      }
+    }
+  };
+
+  template <typename T>
+  struct view_filter {
+    nano::rect<T> area;
+
+    inline void apply(nano::point<T>* p, unsigned char* mask, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        mask[i] &= static_cast<unsigned char>(area.contains(p[i]));
+      }
+    }
+
+    inline void apply(nano::rect<T>* r, unsigned char* mask, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        mask[i] &= static_cast<unsigned char>(area.intersects(r[i]));
+      }
+    }
+
+    inline void apply(nano::quad<T>* q, unsigned char* mask, std::size_t n) const NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        mask[i] &= static_cast<unsigned char>(area.intersects(view_quad_bounds(q[i])));
+      }
+    }
+  };
+
+  /// Running min/max of the elements of a chunk whose mask is set.
+  template <typename T>
+  struct view_bounds {
+    T left = std::numeric_limits<T>::max();
+    T top = std::numeric_limits<T>::max();
+    T right = std::numeric_limits<T>::lowest();
+    T bottom = std::numeric_limits<T>::lowest();
+
+    inline void add(T l, T t, T r, T b, bool keep) NANO_NOEXCEPT {
+      left = std::min(left, keep ? l : std::numeric_limits<T>::max());
+      top = std::min(top, keep ? t : std::numeric_limits<T>::max());
+      right = std::max(right, keep ? r : std::numeric_limits<T>::lowest());
+      bottom = std::max(bottom, keep ? b : std::numeric_limits<T>::lowest());
+    }
+
+    inline void add(const nano::point<T>* p, const unsigned char* mask, std::size_t n) NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        add(p[i].x, p[i].y, p[i].x, p[i].y, mask[i]);
+      }
+    }
+
+    inline void add(const nano::rect<T>* r, const unsigned char* mask, std::size_t n) NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        add(r[i].origin.x, r[i].origin.y, r[i].origin.x + r[i].size.width, r[i].origin.y + r[i].size.height,
+            mask[i]);
+      }
+    }
+
+    inline void add(const nano::quad<T>* q, const unsigned char* mask, std::size_t n) NANO_NOEXCEPT {
+      for (std::size_t i = 0; i < n; i++) {
+        const nano::rect<T> r = view_quad_bounds(q[i]);
+        add(r.origin.x, r.origin.y, r.origin.x + r.size.width, r.origin.y + r.size.height, mask[i]);
+      }
+    }
+
+    NANO_NODC_INLINE nano::rect<T> get() const NANO_NOEXCEPT {
+      if (left > right) {
+        return { 0, 0, 0, 0 };
+      }
+
+      return nano::rect<T>::create_from_point({ left, top }, { right, bottom });
+    }
+  };
+} // namespace detail.
+
+template <typename E, typename... Stages>
+NANO_INLINE_CXPR geometry_view<E, Stages...>::geometry_view(
+    const E* data, std::size_t size, std::tuple<Stages...> stages) NANO_NOEXCEPT : _data(data),
+                                                                                    _size(size),
+                                                                                    _stages(stages) {}
+
+template <typename E, typename... Stages>
+template <typename Stage>
+geometry_view<E, Stages..., Stage> geometry_view<E, Stages...>::then(const Stage& stage) const NANO_NOEXCEPT {
+  return geometry_view<E, Stages..., Stage>(_data, _size, std::tuple_cat(_stages, std::make_tuple(stage)));
+}
+
+template <typename E, typename... Stages>
+geometry_view<E, Stages..., detail::view_transform<typename geometry_view<E, Stages...>::value_type>>
+geometry_view<E, Stages...>::transformed_by(const transform_type& t) const NANO_NOEXCEPT {
+  return then(detail::view_transform<value_type>{ t });
+}
+
+template <typename E, typename... Stages>
+geometry_view<E, Stages..., detail::view_offset<typename geometry_view<E, Stages...>::value_type>>
+geometry_view<E, Stages...>::offset_by(const point_type& p) const NANO_NOEXCEPT {
+  return then(detail::view_offset<value_type>{ p });
+}
+
+template <typename E, typename... Stages>
+geometry_view<E, Stages..., detail::view_clip<typename geometry_view<E, Stages...>::value_type>>
+geometry_view<E, Stages...>::clipped_to(const rect_type& r) const NANO_NOEXCEPT {
+  return then(detail::view_clip<value_type>{ r });
+}
+
+template <typename E, typename... Stages>
+geometry_view<E, Stages..., detail::view_filter<typename geometry_view<E, Stages...>::value_type>>
+geometry_view<E, Stages...>::filtered_intersecting(const rect_type& r) const NANO_NOEXCEPT {
+  return then(detail::view_filter<value_type>{ r });
+}
+
+template <typename E, typename... Stages>
+template <typename Fct>
+void geometry_view<E, Stages...>::evaluate(Fct&& fct) const {
+  E buffer[chunk_size];
+  unsigned char mask[chunk_size];
+
+  for (std::size_t first = 0; first < _size; first += chunk_size) {
+    const std::size_t n = std::min(chunk_size, _size - first);
+    std::copy(_data + first, _data + first + n, buffer);
+    std::fill(mask, mask + n, static_cast<unsigned char>(1));
+
+    std::apply([&](const auto&... stages) { (stages.apply(buffer, mask, n), ...); }, _stages);
+    fct(static_cast<const E*>(buffer), static_cast<const unsigned char*>(mask), n);
+  }
+}
+
+template <typename E, typename... Stages>
+template <typename Fct>
+void geometry_view<E, Stages...>::for_each(Fct&& fct) const {
+  evaluate([&](const E* buffer, const unsigned char* mask, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+      if (mask[i]) {
+        fct(buffer[i]);
+      }
+    }
+  });
+}
+
+template <typename E, typename... Stages>
+std::size_t geometry_view<E, Stages...>::count() const {
+  std::size_t total = 0;
+  evaluate([&](const E*, const unsigned char* mask, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+      total += mask[i];
+    }
+  });
+
+  return total;
+}
+
+template <typename E, typename... Stages>
+typename geometry_view<E, Stages...>::rect_type geometry_view<E, Stages...>::bounds() const {
+  detail::view_bounds<value_type> b;
+  evaluate([&](const E* buffer, const unsigned char* mask, std::size_t n) { b.add(buffer, mask, n); });
+  return b.get();
+}
+
+template <typename E, typename... Stages>
+template <typename OutputIt>
+OutputIt geometry_view<E, Stages...>::copy_to(OutputIt out) const {
+  for_each([&](const E& e) { *out++ = e; });
+  return out;
+}
+
+template <typename E, typename... Stages>
+NANO_INLINE_CXPR std::size_t geometry_view<E, Stages...>::input_size() const NANO_NOEXCEPT {
+  return _size;
+}
+
+template <typename E>
+NANO_INLINE_CXPR geometry_view<E> make_view(const E* data, std::size_t size) NANO_NOEXCEPT {
+  return geometry_view<E>(data, size, std::tuple<>());
+}
+
+template <typename E>
+geometry_view<E> make_view(const std::vector<E>& data) NANO_NOEXCEPT {
+  return geometry_view<E>(data.data(), data.size(), std::tuple<>());
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
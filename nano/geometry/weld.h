@@ -0,0 +1,214 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/weld.h
+ * @brief     nano point welding
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <nano/geometry/hash.h>
+#include <nano/geometry/trace.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Merges duplicated and nearly duplicated points, with reusable working memory.
+///
+/// The points are quantized into a hash grid whose cells are `tolerance` wide, so each
+/// point only looks at the kept points of the 3x3 neighboring cells: O(n) instead of the
+/// quadratic pairwise comparison. Points are visited in order and each one is merged into
+/// the closest point kept before it within `tolerance` (euclidean distance), otherwise it
+/// is kept. The kept points are thus all more than `tolerance` apart.
+///
+/// A tolerance of zero only merges points with the exact same coordinates (+0 and -0 are
+/// the same), using std::hash<nano::point<T>> and nano::exact_equal.
+template <typename T>
+class point_welder {
+public:
+  using value_type = T;
+  using point_type = nano::point<value_type>;
+
+  /// Writes the kept points to `out` in their original order and, for every point, the
+  /// index in `out` of the point replacing it to `remap`. Returns the number of kept points.
+  ///
+  /// `out` can be `points` to compact in place, it needs room for `count` points.
+  template <typename Index>
+  inline std::size_t weld(
+      const point_type* points, std::size_t count, value_type tolerance, Index* remap, point_type* out);
+
+private:
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  struct cell {
+    std::int64_t x;
+    std::int64_t y;
+  };
+
+  std::vector<std::size_t> _buckets;
+  std::vector<std::size_t> _next;
+  std::vector<cell> _cells;
+  std::vector<point_type> _kept;
+
+  inline cell cell_of(const point_type& p, double scale) const NANO_NOEXCEPT;
+  inline std::size_t bucket_of(const cell& c) const NANO_NOEXCEPT;
+  inline std::size_t find(const point_type& p, const cell& c, value_type tolerance) const NANO_NOEXCEPT;
+  inline std::size_t find_exact(const point_type& p, std::size_t bucket) const NANO_NOEXCEPT;
+};
+
+/// Welds `points` with a temporary point_welder, returns the number of kept points.
+template <typename T, typename Index>
+inline std::size_t weld_points(
+    const nano::point<T>* points, std::size_t count, T tolerance, Index* remap, nano::point<T>* out);
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+template <typename T>
+typename point_welder<T>::cell point_welder<T>::cell_of(const point_type& p, double scale) const NANO_NOEXCEPT {
+  // Clamped so that the cast is defined for huge or non finite coordinates, those land in the
+  // border cells and the distance test keeps them apart.
+  constexpr double limit = 4611686018427387904.0; // 2^62.
+  const auto quantize = [&](value_type v) {
+    const double c = std::floor(static_cast<double>(v) * scale);
+    return static_cast<std::int64_t>(!(c > -limit) ? -limit : c > limit ? limit : c);
+  };
+
+  return { quantize(p.x), quantize(p.y) };
+}
+
+template <typename T>
+std::size_t point_welder<T>::bucket_of(const cell& c) const NANO_NOEXCEPT {
+  std::uint64_t h = static_cast<std::uint64_t>(c.x) * 0x9e3779b97f4a7c15ULL;
+  h ^= static_cast<std::uint64_t>(c.y) * 0xc2b2ae3d27d4eb4fULL;
+  h ^= h >> 29;
+  return static_cast<std::size_t>(h) & (_buckets.size() - 1);
+}
+
+template <typename T>
+std::size_t point_welder<T>::find(const point_type& p, const cell& c, value_type tolerance) const NANO_NOEXCEPT {
+  const double max_distance = static_cast<double>(tolerance) * static_cast<double>(tolerance);
+  double best_distance = max_distance;
+  std::size_t best = npos;
+
+  for (std::int64_t dy = -1; dy <= 1; dy++) {
+    for (std::int64_t dx = -1; dx <= 1; dx++) {
+      const cell n = { c.x + dx, c.y + dy };
+
+      for (std::size_t i = _buckets[bucket_of(n)]; i != npos; i = _next[i]) {
+        if (_cells[i].x != n.x || _cells[i].y != n.y) {
+          continue;
+        }
+
+        const double x = static_cast<double>(_kept[i].x) - static_cast<double>(p.x);
+        const double y = static_cast<double>(_kept[i].y) - static_cast<double>(p.y);
+        const double d = x * x + y * y;
+
+        // Earlier points win ties, the chains are visited from the most recent one.
+        if (d < best_distance || (d <= best_distance && (best == npos || i < best))) {
+          best_distance = d;
+          best = i;
+        }
+      }
+    }
+  }
+
+  return best;
+}
+
+template <typename T>
+std::size_t point_welder<T>::find_exact(const point_type& p, std::size_t bucket) const NANO_NOEXCEPT {
+  for (std::size_t i = _buckets[bucket]; i != npos; i = _next[i]) {
+    if (exact_equal{}(_kept[i], p)) {
+      return i;
+    }
+  }
+
+  return npos;
+}
+
+template <typename T>
+template <typename Index>
+std::size_t point_welder<T>::weld(
+    const point_type* points, std::size_t count, value_type tolerance, Index* remap, point_type* out) {
+  NANO_GEOMETRY_TRACE_SCOPE("point_welder::weld", count, count * sizeof(point_type));
+  std::size_t bucket_count = 16;
+  while (bucket_count < 2 * count) {
+    bucket_count *= 2;
+  }
+
+  _buckets.assign(bucket_count, npos);
+  _next.clear();
+  _cells.clear();
+  _kept.clear();
+
+  const bool exact = !(tolerance > value_type(0));
+  const double scale = exact ? 0.0 : 1.0 / static_cast<double>(tolerance);
+  const std::hash<point_type> hasher;
+
+  for (std::size_t i = 0; i < count; i++) {
+    // Copied first, `out` can alias `points`.
+    const point_type p = points[i];
+    const cell c = exact ? cell{ 0, 0 } : cell_of(p, scale);
+    const std::size_t bucket = exact ? hasher(p) & (bucket_count - 1) : bucket_of(c);
+    std::size_t index = exact ? find_exact(p, bucket) : find(p, c, tolerance);
+
+    if (index == npos) {
+      index = _kept.size();
+      _kept.push_back(p);
+      _cells.push_back(c);
+      _next.push_back(_buckets[bucket]);
+      _buckets[bucket] = index;
+      out[index] = p;
+    }
+
+    remap[i] = static_cast<Index>(index);
+  }
+
+  return _kept.size();
+}
+
+template <typename T, typename Index>
+std::size_t weld_points(
+    const nano::point<T>* points, std::size_t count, T tolerance, Index* remap, nano::point<T>* out) {
+  point_welder<T> welder;
+  return welder.weld(points, count, tolerance, remap, out);
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
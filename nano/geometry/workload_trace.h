@@ -0,0 +1,366 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+#pragma once
+
+/*!
+ * @file      nano/geometry/workload_trace.h
+ * @brief     nano geometry workload recording
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+#include <nano/geometry.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+NANO_CLANG_DIAGNOSTIC_PUSH()
+NANO_CLANG_DIAGNOSTIC(warning, "-Weverything")
+NANO_CLANG_DIAGNOSTIC(ignored, "-Wc++98-compat")
+
+namespace nano {
+
+/// Operations of a workload trace.
+enum class workload_op : std::uint8_t {
+  /// Replaces the current rect set.
+  rects = 1,
+
+  /// Replaces the current transform (identity at the start of a trace).
+  transform = 2,
+
+  /// Finds the rects of the current set intersecting a region.
+  query = 3,
+
+  /// Finds the rects of the current set whose transformed bounds intersect a viewport.
+  cull = 4
+};
+
+/// Layout of a workload trace file.
+///
+/// A header followed by records. Each record is a workload_op byte followed by its
+/// payload: a 64-bit count and `count` rects (x, y, width, height) for rects, the six
+/// values a, b, c, d, tx, ty for transform and one rect for query and cull. Values are
+/// stored as `value_size` byte floating points, everything in native byte order.
+namespace workload_format {
+  inline constexpr char magic[4] = { 'N', 'G', 'W', 'T' };
+  inline constexpr std::uint32_t version = 1;
+
+  struct header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t value_size;
+    std::uint32_t reserved;
+  };
+} // namespace workload_format.
+
+/// Records the geometry operations of an application to replay them later (e.g. in the
+/// benchmarks) on the production distribution of rects, transforms and queries.
+template <typename T>
+class workload_recorder {
+public:
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using transform_type = nano::transform<value_type>;
+
+  workload_recorder() = default;
+
+  workload_recorder(const workload_recorder&) = delete;
+  workload_recorder& operator=(const workload_recorder&) = delete;
+
+  inline ~workload_recorder();
+
+  /// Creates the trace file and writes its header, returns false if it could not be written.
+  inline bool open(const std::string& path);
+
+  /// Flushes and closes the file, returns false if any write failed since open().
+  inline bool close();
+
+  NANO_NODC_INLINE bool is_open() const NANO_NOEXCEPT;
+
+  inline void record_rects(const rect_type* rects, std::size_t count);
+  inline void record_transform(const transform_type& t);
+  inline void record_query(const rect_type& region);
+  inline void record_cull(const rect_type& viewport);
+
+private:
+  std::FILE* _file = nullptr;
+  bool _failed = false;
+
+  inline void write(const void* data, std::size_t size);
+  inline void write_rect(const rect_type& r);
+};
+
+/// A trace loaded in memory.
+template <typename T>
+struct workload {
+  using value_type = T;
+  using rect_type = nano::rect<value_type>;
+  using transform_type = nano::transform<value_type>;
+
+  /// `index` refers to `rect_sets` for rects, to `transforms` for transform and to
+  /// `regions` for query and cull.
+  struct operation {
+    workload_op op;
+    std::uint32_t index;
+  };
+
+  std::vector<operation> operations;
+  std::vector<std::vector<rect_type>> rect_sets;
+  std::vector<transform_type> transforms;
+  std::vector<rect_type> regions;
+
+  inline void clear() NANO_NOEXCEPT;
+};
+
+/// Loads a trace recorded by workload_recorder<T>, returns false if the file can not be
+/// read, was recorded with another value type or is truncated.
+template <typename T>
+inline bool read_workload(const std::string& path, workload<T>& w);
+} // namespace nano.
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+//
+//
+//
+//
+// MARK: - IMPLEMENTATION -
+//
+//
+//
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+namespace nano {
+
+//
+// MARK: - workload_recorder -
+//
+
+template <typename T>
+workload_recorder<T>::~workload_recorder() {
+  close();
+}
+
+template <typename T>
+bool workload_recorder<T>::open(const std::string& path) {
+  static_assert(std::is_floating_point_v<T>, "nano::workload_recorder requires a floating point type");
+
+  close();
+
+  _file = std::fopen(path.c_str(), "wb");
+  _failed = !_file;
+
+  if (_file) {
+    workload_format::header h;
+    std::memcpy(h.magic, workload_format::magic, sizeof(h.magic));
+    h.version = workload_format::version;
+    h.value_size = sizeof(T);
+    h.reserved = 0;
+    write(&h, sizeof(h));
+  }
+
+  return !_failed;
+}
+
+template <typename T>
+bool workload_recorder<T>::close() {
+  if (_file) {
+    _failed = std::fclose(_file) != 0 || _failed;
+    _file = nullptr;
+  }
+
+  return !_failed;
+}
+
+template <typename T>
+bool workload_recorder<T>::is_open() const NANO_NOEXCEPT {
+  return _file != nullptr;
+}
+
+template <typename T>
+void workload_recorder<T>::record_rects(const rect_type* rects, std::size_t count) {
+  const workload_op op = workload_op::rects;
+  const std::uint64_t n = count;
+  write(&op, sizeof(op));
+  write(&n, sizeof(n));
+
+  for (std::size_t i = 0; i < count; i++) {
+    write_rect(rects[i]);
+  }
+}
+
+template <typename T>
+void workload_recorder<T>::record_transform(const transform_type& t) {
+  const workload_op op = workload_op::transform;
+  const T values[6] = { t.a, t.b, t.c, t.d, t.tx, t.ty };
+  write(&op, sizeof(op));
+  write(values, sizeof(values));
+}
+
+template <typename T>
+void workload_recorder<T>::record_query(const rect_type& region) {
+  const workload_op op = workload_op::query;
+  write(&op, sizeof(op));
+  write_rect(region);
+}
+
+template <typename T>
+void workload_recorder<T>::record_cull(const rect_type& viewport) {
+  const workload_op op = workload_op::cull;
+  write(&op, sizeof(op));
+  write_rect(viewport);
+}
+
+template <typename T>
+void workload_recorder<T>::write(const void* data, std::size_t size) {
+  _failed = !_file || std::fwrite(data, 1, size, _file) != size || _failed;
+}
+
+template <typename T>
+void workload_recorder<T>::write_rect(const rect_type& r) {
+  const T values[4] = { r.x, r.y, r.width, r.height };
+  write(values, sizeof(values));
+}
+
+//
+// MARK: - workload -
+//
+
+template <typename T>
+void workload<T>::clear() NANO_NOEXCEPT {
+  operations.clear();
+  rect_sets.clear();
+  transforms.clear();
+  regions.clear();
+}
+
+namespace detail {
+  /// Sequential reads from a loaded file, every read fails once past the end.
+  struct workload_stream {
+    const unsigned char* data;
+    std::size_t size;
+    std::size_t offset = 0;
+
+    inline bool read(void* out, std::size_t n) NANO_NOEXCEPT {
+      if (size - offset < n) {
+        return false;
+      }
+
+      std::memcpy(out, data + offset, n);
+      offset += n;
+      return true;
+    }
+
+    template <typename T>
+    inline bool read_rect(nano::rect<T>& r) NANO_NOEXCEPT {
+      T values[4];
+      if (!read(values, sizeof(values))) {
+        return false;
+      }
+
+      r = { values[0], values[1], values[2], values[3] };
+      return true;
+    }
+  };
+} // namespace detail.
+
+template <typename T>
+bool read_workload(const std::string& path, workload<T>& w) {
+  static_assert(std::is_floating_point_v<T>, "nano::read_workload requires a floating point type");
+  using rect_type = nano::rect<T>;
+
+  w.clear();
+
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+
+  std::vector<unsigned char> data;
+  unsigned char chunk[65536];
+  for (std::size_t n; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;) {
+    data.insert(data.end(), chunk, chunk + n);
+  }
+
+  const bool read_error = std::ferror(file) != 0;
+  std::fclose(file);
+
+  detail::workload_stream stream = { data.data(), data.size() };
+  workload_format::header h;
+  if (read_error || !stream.read(&h, sizeof(h)) || std::memcmp(h.magic, workload_format::magic, sizeof(h.magic)) != 0
+      || h.version != workload_format::version || h.value_size != sizeof(T)) {
+    return false;
+  }
+
+  while (stream.offset < stream.size) {
+    workload_op op;
+    if (!stream.read(&op, sizeof(op))) {
+      return false;
+    }
+
+    switch (op) {
+    case workload_op::rects: {
+      std::uint64_t count;
+      if (!stream.read(&count, sizeof(count)) || count > (stream.size - stream.offset) / (4 * sizeof(T))) {
+        return false;
+      }
+
+      std::vector<rect_type> rects(static_cast<std::size_t>(count));
+      for (rect_type& r : rects) {
+        stream.read_rect(r);
+      }
+
+      w.operations.push_back({ op, static_cast<std::uint32_t>(w.rect_sets.size()) });
+      w.rect_sets.push_back(std::move(rects));
+      break;
+    }
+
+    case workload_op::transform: {
+      T values[6];
+      if (!stream.read(values, sizeof(values))) {
+        return false;
+      }
+
+      w.operations.push_back({ op, static_cast<std::uint32_t>(w.transforms.size()) });
+      w.transforms.push_back({ values[0], values[1], values[2], values[3], values[4], values[5] });
+      break;
+    }
+
+    case workload_op::query:
+    case workload_op::cull: {
+      rect_type r;
+      if (!stream.read_rect(r)) {
+        return false;
+      }
+
+      w.operations.push_back({ op, static_cast<std::uint32_t>(w.regions.size()) });
+      w.regions.push_back(r);
+      break;
+    }
+
+    default:
+      return false;
+    }
+  }
+
+  return true;
+}
+} // namespace nano.
+
+NANO_CLANG_DIAGNOSTIC_POP()
@@ -0,0 +1,58 @@
+/*
+ * nano library
+ *
+ * Copyright (C) 2022, Meta-Sonic
+ * All rights reserved.
+ *
+ * Proprietary and confidential.
+ * Any unauthorized copying, alteration, distribution, transmission, performance,
+ * display or other use of this material is strictly prohibited.
+ *
+ * Written by Alexandre Arsenault <alx.arsenault@gmail.com>
+ */
+
+/*!
+ * @file      src/geometry.cpp
+ * @brief     nano geometry explicit instantiations (nano-geometry-lib)
+ * @copyright Copyright (C) 2022, Meta-Sonic
+ * @author    Alexandre Arsenault alx.arsenault@gmail.com
+ * @date      Created 18/10/2026
+ */
+
+// Translation units using nano-geometry-lib see the extern template declarations of
+// nano/geometry.h (NANO_GEOMETRY_EXTERN_TEMPLATES=1) and rely on these definitions.
+
+#include <nano/geometry.h>
+
+#if !NANO_GEOMETRY_EXTERN_TEMPLATES
+  #error "src/geometry.cpp must be compiled with NANO_GEOMETRY_EXTERN_TEMPLATES=1"
+#endif
+
+namespace nano {
+template struct range<int>;
+template struct range<float>;
+template struct range<double>;
+
+template struct padding<int>;
+template struct padding<float>;
+template struct padding<double>;
+
+template struct point<int>;
+template struct point<float>;
+template struct point<double>;
+
+template struct size<int>;
+template struct size<float>;
+template struct size<double>;
+
+template struct rect<int>;
+template struct rect<float>;
+template struct rect<double>;
+
+template class quad<int>;
+template class quad<float>;
+template class quad<double>;
+
+template class transform<float>;
+template class transform<double>;
+} // namespace nano.
@@ -0,0 +1,101 @@
+#include <nano/test.h>
+#include <nano/geometry/arrow.h>
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+struct rect_buffers {
+  std::vector<double> x = { 0, 10, 20 };
+  std::vector<double> y = { 1, 11, 21 };
+  std::vector<double> width = { 2, 12, 22 };
+  std::vector<double> height = { 3, 13, 23 };
+
+  nano::rect_columns<double> columns() const {
+    return { x.data(), y.data(), width.data(), height.data(), x.size() };
+  }
+};
+
+TEST_CASE("nano.geometry", ArrowExport, "Arrow export") {
+  auto buffers = std::make_shared<rect_buffers>();
+  const nano::rect_columns<double> columns = buffers->columns();
+
+  ArrowArray array;
+  ArrowSchema schema;
+  nano::export_arrow(columns, buffers, &array, &schema);
+
+  EXPECT_EQ(std::strcmp(schema.format, "+s"), 0);
+  EXPECT_EQ(schema.n_children, 4);
+  EXPECT_EQ(std::strcmp(schema.children[2]->name, "width"), 0);
+  EXPECT_EQ(std::strcmp(schema.children[2]->format, "g"), 0);
+  EXPECT_EQ(array.length, 3);
+  EXPECT_EQ(array.n_children, 4);
+  EXPECT_EQ(array.children[3]->n_buffers, 2);
+  EXPECT_TRUE(array.children[3]->buffers[1] == buffers->height.data());
+
+  // Zero copy both ways.
+  nano::rect_columns<double> imported;
+  EXPECT_TRUE(nano::import_arrow(&array, &schema, imported));
+  EXPECT_EQ(imported.size, 3u);
+  EXPECT_TRUE(imported.x == buffers->x.data());
+  EXPECT_EQ(imported[1], nano::rect<double>(10, 11, 12, 13));
+
+  nano::rect_columns<float> wrong_type;
+  EXPECT_FALSE(nano::import_arrow(&array, &schema, wrong_type));
+
+  nano::point_columns<double> wrong_shape;
+  EXPECT_FALSE(nano::import_arrow(&array, &schema, wrong_shape));
+
+  // A slice of the parent.
+  array.offset = 1;
+  array.length = 2;
+  EXPECT_TRUE(nano::import_arrow(&array, &schema, imported));
+  EXPECT_EQ(imported.size, 2u);
+  EXPECT_EQ(imported[0], nano::rect<double>(10, 11, 12, 13));
+
+  // Moving a child out keeps the buffers alive after the parent is released.
+  ArrowArray moved = *array.children[1];
+  array.children[1]->release = nullptr;
+
+  const std::weak_ptr<rect_buffers> weak = buffers;
+  buffers.reset();
+
+  array.release(&array);
+  schema.release(&schema);
+  EXPECT_TRUE(array.release == nullptr);
+  EXPECT_FALSE(weak.expired());
+  EXPECT_EQ(static_cast<const double*>(moved.buffers[1])[2], 21.0);
+
+  moved.release(&moved);
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST_CASE("nano.geometry", ArrowImport, "Arrow import") {
+  std::vector<float> x = { 1, 2 };
+  std::vector<float> y = { 3, 4 };
+
+  ArrowArray array;
+  ArrowSchema schema;
+  nano::export_arrow(nano::point_columns<float>{ x.data(), y.data(), x.size() }, nullptr, &array, &schema);
+
+  // Children found by name when the producer orders them differently.
+  std::swap(schema.children[0], schema.children[1]);
+  std::swap(array.children[0], array.children[1]);
+
+  nano::point_columns<float> points;
+  EXPECT_TRUE(nano::import_arrow(&array, &schema, points));
+  EXPECT_EQ(points[1], nano::point<float>(2, 4));
+
+  // Nulls are not supported.
+  array.children[0]->null_count = 1;
+  EXPECT_FALSE(nano::import_arrow(&array, &schema, points));
+  array.children[0]->null_count = 0;
+
+  array.release(&array);
+  schema.release(&schema);
+
+  EXPECT_FALSE(nano::import_arrow(&array, &schema, points));
+}
+} // namespace.
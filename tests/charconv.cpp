@@ -0,0 +1,147 @@
+#include <nano/test.h>
+#include <nano/geometry/charconv.h>
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+template <typename V>
+std::string format(const V& v) {
+  char buffer[512];
+  const std::to_chars_result res = nano::to_chars(buffer, buffer + sizeof(buffer), v);
+  return res.ec == std::errc() ? std::string(buffer, res.ptr) : std::string("error");
+}
+
+template <typename V>
+bool round_trip(const V& v) {
+  char buffer[512];
+  const std::to_chars_result res = nano::to_chars(buffer, buffer + sizeof(buffer), v);
+  V parsed {};
+  const std::from_chars_result parse_res = nano::from_chars(buffer, res.ptr, parsed);
+  return res.ec == std::errc() && parse_res.ec == std::errc() && parse_res.ptr == res.ptr && parsed == v;
+}
+
+TEST_CASE("nano.geometry", CharconvFormat, "to_chars output of every type") {
+  EXPECT_EQ(format(nano::point<float>{ 0.1f, -2.5f }), "{0.1,-2.5}");
+  EXPECT_EQ(format(nano::size<int>{ 800, 600 }), "{800,600}");
+  EXPECT_EQ(format(nano::rect<double>{ 1, 2.25, 0.1, 1e20 }), "{1,2.25,0.1,1e+20}");
+  EXPECT_EQ(format(nano::range<int>{ -3, 7 }), "{-3,7}");
+  EXPECT_EQ(format(nano::padding<float>(1, 2, 3, 4)), "{1,2,3,4}");
+  EXPECT_EQ(format(nano::quad<int>(nano::rect<int>{ 0, 0, 2, 3 })), "{{0,0},{2,0},{2,3},{0,3}}");
+  EXPECT_EQ(format(nano::transform<double>(2, 0, 0, 0.5, 10, -1)), "{2,0,0,0.5,10,-1}");
+}
+
+TEST_CASE("nano.geometry", CharconvRoundTrip, "from_chars of to_chars gives back the same value") {
+  const float f = std::numeric_limits<float>::max();
+  const double d = std::numeric_limits<double>::denorm_min();
+
+  EXPECT_TRUE(round_trip(nano::point<float>{ 1.0f / 3.0f, f }));
+  EXPECT_TRUE(round_trip(nano::point<double>{ 0.1 + 0.2, d }));
+  EXPECT_TRUE(round_trip(nano::size<float>{ 1e-7f, 12345.678f }));
+  EXPECT_TRUE(round_trip(nano::rect<double>{ -1.0 / 7.0, 1e300, 2.0 / 3.0, 42 }));
+  EXPECT_TRUE(round_trip(nano::rect<int>{ std::numeric_limits<int>::min(), 2, 3, std::numeric_limits<int>::max() }));
+  EXPECT_TRUE(round_trip(nano::range<double>{ 0.3, 1e-300 }));
+  EXPECT_TRUE(round_trip(nano::padding<double>(0.1, 0.2, 0.3, 0.4)));
+
+  const nano::quad<double> q = nano::transform<double>::rotation(1.1).apply(nano::rect<double>{ 0.5, 0.25, 3, 4 });
+  EXPECT_TRUE(round_trip(q));
+
+  const nano::transform<float> t = nano::transform<float>::rotation(0.3f, { 5, 7 });
+  nano::transform<float> parsed = nano::transform<float>::identity();
+  const std::string text = format(t);
+  EXPECT_TRUE(nano::from_chars(text.data(), text.data() + text.size(), parsed).ec == std::errc());
+  EXPECT_TRUE(std::memcmp(&parsed, &t, sizeof(t)) == 0);
+}
+
+TEST_CASE("nano.geometry", CharconvParse, "from_chars white spaces and errors") {
+  const char text[] = " { 1.5 ,\t-2 }\n tail";
+  nano::point<double> p = { 0, 0 };
+  std::from_chars_result res = nano::from_chars(text, text + std::strlen(text), p);
+  EXPECT_TRUE(res.ec == std::errc());
+  EXPECT_EQ(p.x, 1.5);
+  EXPECT_EQ(p.y, -2.0);
+  EXPECT_EQ(std::string(res.ptr), "\n tail");
+
+  const nano::point<double> before = p;
+  const char* invalid[] = { "", "{1}", "{1,2", "1,2}", "{1;2}", "{1,2,3}", "{a,2}", "{+1,2}" };
+  for (const char* s : invalid) {
+    res = nano::from_chars(s, s + std::strlen(s), p);
+    EXPECT_TRUE(res.ec == std::errc::invalid_argument);
+    EXPECT_TRUE(p == before);
+  }
+
+  nano::size<int> s = { 0, 0 };
+  const char overflow[] = "{1,99999999999}";
+  res = nano::from_chars(overflow, overflow + std::strlen(overflow), s);
+  EXPECT_TRUE(res.ec == std::errc::result_out_of_range);
+  EXPECT_TRUE(s == nano::size<int>{ 0, 0 });
+
+  nano::quad<int> q {};
+  const char quad_text[] = "{ {0,0}, {2,0} ,{2,3},{0,3} }";
+  res = nano::from_chars(quad_text, quad_text + std::strlen(quad_text), q);
+  EXPECT_TRUE(res.ec == std::errc());
+  EXPECT_TRUE(q == nano::quad<int>(nano::rect<int>{ 0, 0, 2, 3 }));
+}
+
+TEST_CASE("nano.geometry", CharconvBufferTooSmall, "to_chars value_too_large") {
+  const nano::rect<float> r = { 0.1f, 0.2f, 0.3f, 0.4f };
+  char buffer[32];
+  const std::size_t length = format(r).size();
+
+  for (std::size_t n = 0; n < length; n++) {
+    const std::to_chars_result res = nano::to_chars(buffer, buffer + n, r);
+    EXPECT_TRUE(res.ec == std::errc::value_too_large);
+    EXPECT_TRUE(res.ptr == buffer + n);
+  }
+
+  const std::to_chars_result res = nano::to_chars(buffer, buffer + length, r);
+  EXPECT_TRUE(res.ec == std::errc());
+  EXPECT_TRUE(res.ptr == buffer + length);
+}
+
+TEST_CASE("nano.geometry", CharconvBulk, "Bulk to_chars and from_chars") {
+  std::vector<nano::rect<float>> rects;
+  for (int i = 0; i < 100; i++) {
+    rects.push_back({ static_cast<float>(i) * 0.1f, -static_cast<float>(i) / 3.0f, 1.5f, static_cast<float>(i) });
+  }
+
+  std::vector<char> buffer(8192);
+  char* first = buffer.data();
+  char* last = first + buffer.size();
+
+  const nano::bulk_to_chars_result res = nano::to_chars(first, last, rects.data(), rects.size());
+  EXPECT_TRUE(res.ec == std::errc());
+  EXPECT_EQ(res.count, rects.size());
+  EXPECT_EQ(res.ptr[-1], '\n');
+
+  std::vector<nano::rect<float>> parsed(rects.size());
+  const nano::bulk_from_chars_result parse_res = nano::from_chars(first, res.ptr, parsed.data(), parsed.size());
+  EXPECT_TRUE(parse_res.ec == std::errc());
+  EXPECT_EQ(parse_res.count, rects.size());
+  EXPECT_TRUE(parse_res.ptr == res.ptr);
+  EXPECT_EQ(parsed, rects);
+
+  // Too small for everything: only complete values with their separator are counted.
+  const nano::bulk_to_chars_result partial = nano::to_chars(first, first + 100, rects.data(), rects.size(), ',');
+  EXPECT_TRUE(partial.ec == std::errc::value_too_large);
+  EXPECT_TRUE(partial.count > 0 && partial.count < rects.size());
+  EXPECT_EQ(partial.ptr[-1], ',');
+
+  nano::rect<float> two[2];
+  nano::bulk_from_chars_result limited = nano::from_chars(first, res.ptr, two, 2);
+  EXPECT_TRUE(limited.ec == std::errc::value_too_large);
+  EXPECT_EQ(limited.count, 2u);
+  EXPECT_TRUE(two[1] == rects[1]);
+
+  const char text[] = "{1,2}, {3,4}\n{5,x}";
+  nano::point<int> points[4];
+  limited = nano::from_chars(text, text + std::strlen(text), points, 4);
+  EXPECT_TRUE(limited.ec == std::errc::invalid_argument);
+  EXPECT_EQ(limited.count, 2u);
+  EXPECT_EQ(std::string(limited.ptr), "{5,x}");
+  EXPECT_TRUE(points[1] == nano::point<int>{ 3, 4 });
+}
+} // namespace.
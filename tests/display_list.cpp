@@ -0,0 +1,153 @@
+#include <nano/test.h>
+#include <nano/geometry/display_list.h>
+
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+struct draw_op {
+  int kind;
+  std::uint32_t color;
+};
+
+using list_type = nano::display_list<float, draw_op>;
+
+TEST_CASE("nano.geometry", DisplayListRecord, "Display list recording state and bounds") {
+  list_type list;
+  EXPECT_TRUE(list.empty());
+
+  EXPECT_EQ(list.record({ 0, 1 }, { 10, 10, 20, 20 }), 0u);
+
+  list.save();
+  list.set_transform(nano::transform<float>::scale({ 2, 2 }) + nano::point<float>{ 5, 0 });
+  EXPECT_EQ(list.record({ 1, 2 }, { 0, 0, 10, 10 }), 1u);
+
+  // The clip is in device space once set, the second op is clipped.
+  list.clip({ 0, 0, 10, 10 });
+  EXPECT_EQ(list.current_state().clip, nano::rect<float>(10, 0, 20, 20));
+  list.record({ 2, 3 }, { 5, 5, 10, 10 });
+  list.record({ 3, 4 }, { 100, 100, 10, 10 });
+  list.restore();
+
+  list.record({ 4, 5 }, { 0, 0, 5, 5 });
+  list.restore();
+
+  EXPECT_EQ(list.size(), 5u);
+  EXPECT_EQ(list.op_bounds(0), nano::rect<float>(10, 10, 20, 20));
+  EXPECT_EQ(list.op_bounds(1), nano::rect<float>(10, 0, 20, 20));
+  EXPECT_EQ(list.op_bounds(2), nano::rect<float>(20, 10, 10, 10));
+  EXPECT_EQ(list.op_bounds(3), nano::rect<float>(0, 0, 0, 0));
+  EXPECT_EQ(list.op_bounds(4), nano::rect<float>(0, 0, 5, 5));
+  EXPECT_EQ(list.bounds(), nano::rect<float>(0, 0, 30, 30));
+
+  // States are shared by the ops recorded between two changes.
+  EXPECT_EQ(&list.op_state(2), &list.op_state(3));
+  EXPECT_TRUE(list.op_state(2).clipped);
+  EXPECT_FALSE(list.op_state(1).clipped);
+  EXPECT_FALSE(list.op_state(4).clipped);
+  EXPECT_EQ(list.op_state(4).transform.a, 1.0f);
+  EXPECT_EQ(list.op_state(1).transform.tx, 10.0f);
+
+  std::vector<int> kinds;
+  list.replay([&](const draw_op& op, const list_type::state&) { kinds.push_back(op.kind); });
+  EXPECT_EQ(kinds, std::vector<int>({ 0, 1, 2, 4 }));
+
+  kinds.clear();
+  list.replay({ 12, 0, 10, 9 }, [&](const draw_op& op, const list_type::state&) { kinds.push_back(op.kind); });
+  EXPECT_EQ(kinds, std::vector<int>({ 1 }));
+
+  list.clear();
+  EXPECT_TRUE(list.empty());
+  EXPECT_FALSE(list.current_state().clipped);
+}
+
+TEST_CASE("nano.geometry", DisplayListReplay, "Culled replay matches a brute force scan") {
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<float> pos(-500.0f, 3000.0f);
+  std::uniform_real_distribution<float> len(1.0f, 80.0f);
+  std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+
+  list_type list;
+  for (std::uint32_t i = 0; i < 3000; i++) {
+    if (i % 100 == 0) {
+      list.restore();
+      list.save();
+      list.set_transform(nano::transform<float>::rotation(angle(gen)) + nano::point<float>{ pos(gen), pos(gen) });
+      if (i % 300 == 0) {
+        list.clip({ -200, -200, 800, 800 });
+      }
+    }
+
+    list.record({ 0, i }, { pos(gen) * 0.1f, pos(gen) * 0.1f, len(gen), len(gen) });
+  }
+
+  std::vector<nano::rect<float>> regions = { { 0, 0, 1920, 1080 }, { 100, 100, 10, 10 }, { -1000, -1000, 5000, 5000 } };
+  for (int i = 0; i < 20; i++) {
+    regions.push_back({ pos(gen), pos(gen), len(gen) * 5, len(gen) * 5 });
+  }
+
+  bool match = true;
+  for (const nano::rect<float>& region : regions) {
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t i = 0; i < list.size(); i++) {
+      if (list.op_bounds(i).intersects(region)) {
+        expected.push_back(i);
+      }
+    }
+
+    std::vector<std::uint32_t> visited;
+    list.replay(region, [&](const draw_op& op, const list_type::state&) { visited.push_back(op.color); });
+    match = match && visited == expected;
+  }
+
+  EXPECT_TRUE(match);
+
+  // Nested replays and concurrent replays of a built list.
+  const nano::rect<float> everything = { -1e6f, -1e6f, 2e6f, 2e6f };
+  std::vector<std::uint32_t> all;
+  list.query(everything, all);
+
+  std::size_t nested = 0;
+  std::vector<std::uint32_t> outer;
+  list.replay(everything, [&](const draw_op& op, const list_type::state&) {
+    outer.push_back(op.color);
+    if (outer.size() <= 3) {
+      list.replay(regions[1], [&](const draw_op&, const list_type::state&) { nested++; });
+    }
+  });
+
+  std::vector<std::uint32_t> small;
+  list.query(regions[1], small);
+  EXPECT_TRUE(outer == all);
+  EXPECT_EQ(nested, 3 * small.size());
+
+  list.build_index();
+  bool thread_match[2] = { true, true };
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 2; t++) {
+    threads.emplace_back([&, t] {
+      for (int k = 0; k < 20; k++) {
+        std::vector<std::uint32_t> visited;
+        list.replay(everything, [&](const draw_op& op, const list_type::state&) { visited.push_back(op.color); });
+        thread_match[t] = thread_match[t] && visited == all;
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(thread_match[0] && thread_match[1]);
+
+  // Recording after a replay invalidates the index.
+  list.set_transform(nano::transform<float>::identity());
+  list.record({ 1, 3000 }, { 100, 100, 10, 10 });
+
+  std::vector<std::uint32_t> ids;
+  list.query({ 104, 104, 1, 1 }, ids);
+  EXPECT_FALSE(ids.empty());
+  EXPECT_EQ(ids.back(), 3000u);
+}
+} // namespace.
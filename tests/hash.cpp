@@ -0,0 +1,36 @@
+#include <nano/test.h>
+#include <nano/geometry/hash.h>
+
+#include <limits>
+#include <unordered_set>
+
+namespace {
+template <typename T>
+using exact_set = std::unordered_set<T, std::hash<T>, nano::exact_equal>;
+
+TEST_CASE("nano.geometry", Hash, "std::hash specializations") {
+  exact_set<nano::point<float>> points;
+  points.insert({ 1.0f, 2.0f });
+  points.insert({ 1.0f, 2.0f });
+  points.insert({ 0.0f, -0.0f });
+  points.insert({ -0.0f, 0.0f });
+  EXPECT_EQ(points.size(), 2u);
+  EXPECT_EQ(std::hash<nano::point<float>>{}({ 0.0f, 0.0f }), std::hash<nano::point<float>>{}({ -0.0f, -0.0f }));
+  EXPECT_TRUE(std::hash<nano::point<int>>{}({ 1, 2 }) != std::hash<nano::point<int>>{}({ 2, 1 }));
+
+  exact_set<nano::size<double>> sizes = { { 1.0, 2.0 }, { 2.0, 1.0 }, { 1.0, 2.0 } };
+  EXPECT_EQ(sizes.size(), 2u);
+
+  exact_set<nano::rect<int>> rects = { { 0, 0, 10, 10 }, { 0, 0, 10, 11 }, { 0, 0, 10, 10 } };
+  EXPECT_EQ(rects.size(), 2u);
+  EXPECT_TRUE(rects.count({ 0, 0, 10, 11 }) == 1);
+
+  // Points within the tolerance of operator== are distinct keys.
+  const nano::point<double> a = { 1.0, 1.0 };
+  const nano::point<double> b = { 1.0 + std::numeric_limits<double>::epsilon(), 1.0 };
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(nano::exact_equal{}(a, b));
+  EXPECT_TRUE(nano::exact_equal{}(nano::point<double>(0.0, 1.0), nano::point<double>(-0.0, 1.0)));
+  EXPECT_EQ(exact_set<nano::point<double>>({ a, b, a }).size(), 2u);
+}
+} // namespace.
@@ -0,0 +1,111 @@
+#include <nano/test.h>
+#include <nano/geometry/histogram.h>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+TEST_CASE("nano.geometry", Histogram, "2d histogram") {
+  nano::point_histogram<float> histogram({ 0, 0, 4, 2 }, 4, 2);
+  EXPECT_EQ(histogram.columns(), 4u);
+  EXPECT_EQ(histogram.rows(), 2u);
+
+  const std::vector<nano::point<float>> points = { { 0.5f, 0.5f }, { 0.0f, 0.0f }, { 3.9f, 1.9f }, { 4.0f, 1.0f },
+    { -0.1f, 1.0f }, { 2.5f, 1.5f }, { std::numeric_limits<float>::quiet_NaN(), 1.0f }, { 1e30f, -1e30f } };
+  histogram.add(points.data(), points.size());
+
+  const float* bins = histogram.bins();
+  const float expected[8] = { 2, 0, 0, 0, 0, 0, 1, 1 };
+  for (std::size_t i = 0; i < 8; i++) {
+    EXPECT_EQ(bins[i], expected[i]);
+  }
+
+  // Streaming with weights.
+  const std::vector<float> weights = { 0.5f, 0.25f };
+  histogram.add(points.data(), weights.data(), 2);
+  EXPECT_EQ(histogram.bins()[0], 2.75f);
+
+  histogram.clear();
+  EXPECT_EQ(histogram.bins()[0], 0.0f);
+
+  // Empty bounds keep nothing.
+  nano::point_histogram<float> empty({ 0, 0, 0, 10 }, 4, 4);
+  empty.add(points.data(), points.size());
+  EXPECT_EQ(empty.columns(), 0u);
+
+  // So do grids whose bin indices would not fit in 32 bits.
+  nano::point_histogram<float> huge({ 0, 0, 10, 10 }, 65536, 65536);
+  huge.add(points.data(), points.size());
+  EXPECT_EQ(huge.columns(), 0u);
+  EXPECT_EQ(huge.rows(), 0u);
+
+  const std::size_t half = (std::numeric_limits<std::size_t>::max() >> 1) + 1;
+  EXPECT_EQ(nano::point_histogram<float>({ 0, 0, 10, 10 }, half, 2).columns(), 0u);
+
+  // Threads and chunks, the result does not depend on the thread count.
+  std::mt19937 gen(1);
+  std::normal_distribution<double> coord(50.0, 20.0);
+  std::vector<nano::point<double>> cloud(100000);
+  for (nano::point<double>& p : cloud) {
+    p = { coord(gen), coord(gen) };
+  }
+
+  nano::point_histogram<double, double> single({ 0, 0, 100, 100 }, 64, 32);
+  nano::point_histogram<double, double> threaded({ 0, 0, 100, 100 }, 64, 32, 4);
+  single.add(cloud.data(), cloud.size());
+  for (std::size_t first = 0; first < cloud.size(); first += 40000) {
+    threaded.add(cloud.data() + first, std::min<std::size_t>(40000, cloud.size() - first));
+  }
+
+  const double* a = single.bins();
+  const double* b = threaded.bins();
+  bool same = true;
+  std::size_t inside = 0;
+  for (std::size_t i = 0; i < 64 * 32; i++) {
+    same = same && a[i] == b[i];
+    inside += static_cast<std::size_t>(a[i]);
+  }
+
+  EXPECT_TRUE(same);
+  EXPECT_TRUE(inside > 95000u && inside < 100000u);
+
+  std::size_t expected_inside = 0;
+  for (const nano::point<double>& p : cloud) {
+    expected_inside += p.x >= 0 && p.x < 100 && p.y >= 0 && p.y < 100;
+  }
+
+  EXPECT_EQ(inside, expected_inside);
+}
+
+TEST_CASE("nano.geometry", HistogramSplat, "2d histogram gaussian splat") {
+  nano::point_histogram<double, double> histogram({ 0, 0, 20, 20 }, 20, 20);
+  const nano::point<double> center = { 10.5, 10.5 };
+  const double weight = 2;
+  histogram.splat(&center, &weight, 1, 1.5);
+
+  const double* bins = histogram.bins();
+  const double total = std::accumulate(bins, bins + 400, 0.0);
+  EXPECT_TRUE(std::abs(total - 2.0) < 1e-9);
+  EXPECT_TRUE(bins[10 * 20 + 10] > bins[10 * 20 + 11]);
+  EXPECT_TRUE(std::abs(bins[10 * 20 + 11] - bins[10 * 20 + 9]) < 1e-12);
+  EXPECT_TRUE(std::abs(bins[11 * 20 + 10] - bins[10 * 20 + 11]) < 1e-12);
+  EXPECT_EQ(bins[10 * 20 + 16], 0.0);
+
+  // A point outside the bounds still reaches the edge bins, part of its weight is lost.
+  histogram.clear();
+  const nano::point<double> outside = { -0.5, 10.5 };
+  histogram.splat(&outside, nullptr, 1, 1.0);
+  bins = histogram.bins();
+  const double partial = std::accumulate(bins, bins + 400, 0.0);
+  EXPECT_TRUE(partial > 0.1 && partial < 0.5);
+  EXPECT_TRUE(bins[10 * 20] > 0);
+
+  // Zero sigma is plain binning.
+  histogram.clear();
+  histogram.splat(&center, nullptr, 1, 0.0);
+  EXPECT_EQ(histogram.bins()[10 * 20 + 10], 1.0);
+}
+} // namespace.
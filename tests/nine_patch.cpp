@@ -0,0 +1,92 @@
+#include <nano/test.h>
+#include <nano/geometry/nine_patch.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+TEST_CASE("nano.geometry", NinePatchSlice, "Nine-patch slicing") {
+  const std::vector<nano::nine_patch<float>> patches = {
+    { { 10, 20, 100, 50 }, { 0, 0, 32, 32 }, nano::padding<float>(4, 6, 8, 10) },
+    // Collapsed horizontally: the 6 + 10 borders are scaled to fit in 8.
+    { { 0, 0, 8, 50 }, { 0, 0, 32, 32 }, nano::padding<float>(4, 6, 8, 10) },
+  };
+
+  std::vector<nano::rect<float>> dst(patches.size() * nano::nine_patch_cells);
+  std::vector<nano::rect<float>> src(dst.size());
+  nano::slice_nine_patches(patches.data(), patches.size(), dst.data(), src.data());
+
+  EXPECT_EQ(dst[0], nano::rect<float>(10, 20, 6, 4));
+  EXPECT_EQ(dst[4], nano::rect<float>(16, 24, 84, 38));
+  EXPECT_EQ(dst[8], nano::rect<float>(100, 62, 10, 8));
+  EXPECT_EQ(src[4], nano::rect<float>(6, 4, 16, 20));
+  EXPECT_EQ(src[8], nano::rect<float>(22, 24, 10, 8));
+
+  // The center is the inside rect of the padding.
+  EXPECT_EQ(dst[4], patches[0].insets.inside_rect(patches[0].destination));
+
+  // The cells cover the destination.
+  float area = 0;
+  for (std::size_t i = 0; i < nano::nine_patch_cells; i++) {
+    area += dst[i].area();
+  }
+  EXPECT_EQ(area, patches[0].destination.area());
+
+  const nano::rect<float>* collapsed = dst.data() + nano::nine_patch_cells;
+  EXPECT_EQ(collapsed[3], nano::rect<float>(0, 4, 3, 38));
+  EXPECT_EQ(collapsed[4].width, 0.0f);
+  EXPECT_EQ(collapsed[5], nano::rect<float>(3, 4, 5, 38));
+  EXPECT_EQ(src[nano::nine_patch_cells + 4], src[4]);
+}
+
+TEST_CASE("nano.geometry", NinePatchEmit, "Nine-patch vertex emission") {
+  const std::vector<nano::nine_patch<float>> patches = {
+    { { 10, 20, 100, 50 }, { 0, 0, 32, 32 }, nano::padding<float>(4, 6, 8, 10) },
+    { { 0, 0, 8, 50 }, { 32, 0, 32, 32 }, nano::padding<float>(4, 6, 8, 10) },
+    { { 0, 0, 40, 40 }, { 0, 32, 32, 32 }, nano::padding<float>(0, 0, 0, 0) },
+  };
+
+  const nano::size<float> atlas_size = { 64, 64 };
+  std::vector<nano::textured_vertex<float>> vertices(
+      patches.size() * nano::nine_patch_cells * nano::vertices_per_quad);
+
+  // 9 cells, 6 without the collapsed center column and 1 without borders.
+  const std::size_t n_quads = nano::emit_nine_patches(patches.data(), patches.size(), atlas_size, vertices.data());
+  EXPECT_EQ(n_quads, 16u);
+
+  // Same as emitting the non empty sliced cells with their atlas uvs.
+  std::vector<nano::rect<float>> dst(patches.size() * nano::nine_patch_cells);
+  std::vector<nano::rect<float>> src(dst.size());
+  nano::slice_nine_patches(patches.data(), patches.size(), dst.data(), src.data());
+
+  std::vector<nano::rect<float>> cells;
+  std::vector<nano::rect<float>> uvs;
+  for (std::size_t i = 0; i < dst.size(); i++) {
+    if (dst[i].width > 0 && dst[i].height > 0) {
+      cells.push_back(dst[i]);
+      uvs.push_back(nano::atlas_uv(src[i], atlas_size));
+    }
+  }
+
+  EXPECT_EQ(cells.size(), n_quads);
+
+  const nano::transform<float> t = nano::transform<float>::rotation(0.5f) + nano::point<float>{ 3, 4 };
+  nano::vertex_emit_options<float> opts;
+  opts.transform = &t;
+  opts.streaming = true;
+  nano::emit_nine_patches(patches.data(), patches.size(), atlas_size, vertices.data(), opts);
+
+  std::vector<nano::textured_vertex<float>> expected(cells.size() * nano::vertices_per_quad);
+  opts.uvs = uvs.data();
+  opts.streaming = false;
+  nano::emit_vertices(cells.data(), cells.size(), expected.data(), opts);
+
+  bool match = true;
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    match = match && std::abs(vertices[i].x - expected[i].x) < 1e-4f && std::abs(vertices[i].y - expected[i].y) < 1e-4f
+        && std::abs(vertices[i].u - expected[i].u) < 1e-6f && std::abs(vertices[i].v - expected[i].v) < 1e-6f;
+  }
+
+  EXPECT_TRUE(match);
+}
+} // namespace.
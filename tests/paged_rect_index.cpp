@@ -0,0 +1,210 @@
+#include <nano/test.h>
+#include <nano/geometry/paged_rect_index.h>
+
+#if NANO_GEOMETRY_HAS_PAGED_RECT_INDEX
+  #include <algorithm>
+  #include <cstdio>
+  #include <cstring>
+  #include <random>
+  #include <string>
+  #include <vector>
+
+namespace {
+TEST_CASE("nano.geometry", PagedRectIndex, "Paged rect index") {
+  const std::string path = "nano-geometry-paged-test.idx";
+  std::mt19937 gen(9);
+  std::uniform_real_distribution<double> pos(-180.0, 180.0);
+  std::uniform_real_distribution<double> len(0.01, 2.0);
+  std::vector<nano::rect<double>> rects(20000);
+
+  nano::paged_rect_index_builder::options build_options;
+  build_options.page_size = 512;
+  build_options.memory_budget = 64 * 1024;
+
+  {
+    nano::paged_rect_index_builder builder(path, build_options);
+    for (std::size_t i = 0; i < rects.size(); i++) {
+      rects[i] = { pos(gen), pos(gen) * 0.5, len(gen), len(gen) };
+      EXPECT_TRUE(builder.add(rects[i], i + 100));
+    }
+
+    EXPECT_TRUE(builder.finish());
+
+    // The builder is done.
+    EXPECT_FALSE(builder.finish());
+    EXPECT_FALSE(builder.add(rects[0], 0));
+  }
+
+  nano::paged_rect_index::options mmap_options;
+  nano::paged_rect_index::options cached_options;
+  cached_options.use_mmap = false;
+  cached_options.cache_pages = 4;
+
+  for (const nano::paged_rect_index::options& opts : { mmap_options, cached_options }) {
+    nano::paged_rect_index index;
+    EXPECT_TRUE(index.open(path, opts));
+    EXPECT_EQ(index.size(), rects.size());
+    EXPECT_EQ(index.page_size(), 512u);
+
+    std::uniform_real_distribution<double> qpos(-180.0, 180.0);
+    for (int k = 0; k < 50; k++) {
+      const nano::rect<double> q = { qpos(gen), qpos(gen) * 0.5, 20.0, 10.0 };
+      std::vector<std::uint64_t> ids;
+      index.query(q, [&](std::uint64_t id, const nano::rect<double>& r) {
+        EXPECT_TRUE(r == rects[id - 100]);
+        ids.push_back(id);
+      });
+
+      std::vector<std::uint64_t> expected;
+      for (std::size_t i = 0; i < rects.size(); i++) {
+        if (rects[i].intersects(q)) {
+          expected.push_back(i + 100);
+        }
+      }
+
+      std::sort(ids.begin(), ids.end());
+      EXPECT_TRUE(ids == expected);
+    }
+
+    EXPECT_TRUE(opts.use_mmap ? index.page_reads() == 0 : index.page_reads() > 0);
+  }
+
+  std::remove(path.c_str());
+
+  nano::paged_rect_index missing;
+  EXPECT_FALSE(missing.open(path));
+}
+
+TEST_CASE("nano.geometry", PagedRectIndexCorrupt, "Paged rect index with corrupt pages") {
+  const std::string path = "nano-geometry-paged-corrupt-test.idx";
+  std::vector<nano::rect<double>> rects;
+  for (int i = 0; i < 2000; i++) {
+    rects.push_back({ static_cast<double>(i % 50), static_cast<double>(i / 50), 0.5, 0.5 });
+  }
+
+  nano::paged_rect_index_builder::options build_options;
+  build_options.page_size = 512;
+
+  {
+    nano::paged_rect_index_builder builder(path, build_options);
+    for (std::size_t i = 0; i < rects.size(); i++) {
+      builder.add(rects[i], i);
+    }
+    EXPECT_TRUE(builder.finish());
+  }
+
+  std::vector<unsigned char> file;
+  {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    unsigned char buffer[4096];
+    for (std::size_t n; (n = std::fread(buffer, 1, sizeof(buffer), f)) > 0;) {
+      file.insert(file.end(), buffer, buffer + n);
+    }
+    std::fclose(f);
+  }
+
+  nano::paged_format::header header;
+  std::memcpy(&header, file.data(), sizeof(header));
+
+  // A child of the root pointing past the end of the file and a leaf with a huge count.
+  const std::uint64_t bad_page = std::uint64_t(1) << 40;
+  const std::uint32_t bad_count = 0xFFFFFFFF;
+  std::memcpy(file.data() + header.root_page * 512 + nano::paged_format::page_header_size + 32, &bad_page, 8);
+  std::memcpy(file.data() + 512, &bad_count, 4);
+
+  const auto write = [&](std::size_t size) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(file.data(), 1, size, f);
+    std::fclose(f);
+  };
+
+  write(file.size());
+
+  nano::paged_rect_index::options cached_options;
+  cached_options.use_mmap = false;
+  cached_options.cache_pages = 2;
+
+  for (const nano::paged_rect_index::options& opts : { nano::paged_rect_index::options(), cached_options }) {
+    nano::paged_rect_index index;
+    EXPECT_TRUE(index.open(path, opts));
+
+    std::size_t found = 0;
+    bool valid = true;
+    index.query({ -1, -1, 100, 100 }, [&](std::uint64_t id, const nano::rect<double>& r) {
+      valid = valid && id < rects.size() && rects[id] == r;
+      found++;
+    });
+
+    EXPECT_TRUE(valid);
+    EXPECT_TRUE(found > 0 && found < rects.size());
+  }
+
+  // Truncated: the header announces more pages than the file holds.
+  write(file.size() - 512);
+  nano::paged_rect_index truncated;
+  EXPECT_FALSE(truncated.open(path));
+
+  // Root page out of range.
+  header.root_page = header.page_count;
+  std::memcpy(file.data(), &header, sizeof(header));
+  write(file.size());
+  EXPECT_FALSE(truncated.open(path));
+
+  std::remove(path.c_str());
+}
+TEST_CASE("nano.geometry", PagedRectIndexNested, "Paged rect index queried from a query callback") {
+  const std::string path = "nano-geometry-paged-nested-test.idx";
+  std::vector<nano::rect<double>> rects;
+  for (int i = 0; i < 2000; i++) {
+    rects.push_back({ static_cast<double>(i % 50) * 2, static_cast<double>(i / 50) * 2, 1.5, 1.5 });
+  }
+
+  nano::paged_rect_index_builder::options build_options;
+  build_options.page_size = 256;
+
+  {
+    nano::paged_rect_index_builder builder(path, build_options);
+    for (std::size_t i = 0; i < rects.size(); i++) {
+      builder.add(rects[i], i);
+    }
+    EXPECT_TRUE(builder.finish());
+  }
+
+  // A single cached page: every inner query evicts the leaf the outer one is visiting.
+  nano::paged_rect_index::options opts;
+  opts.use_mmap = false;
+  opts.cache_pages = 1;
+
+  nano::paged_rect_index index;
+  EXPECT_TRUE(index.open(path, opts));
+
+  const nano::rect<double> outer = { 0, 0, 20, 20 };
+  const nano::rect<double> inner = { 80, 60, 4, 4 };
+  std::vector<std::uint64_t> ids;
+  std::size_t inner_count = 0;
+
+  index.query(outer, [&](std::uint64_t id, const nano::rect<double>&) {
+    ids.push_back(id);
+    index.query(inner, [&](std::uint64_t, const nano::rect<double>&) { inner_count++; });
+  });
+
+  std::vector<std::uint64_t> expected;
+  std::size_t expected_inner = 0;
+  for (std::size_t i = 0; i < rects.size(); i++) {
+    if (rects[i].intersects(outer)) {
+      expected.push_back(i);
+    }
+
+    expected_inner += rects[i].intersects(inner);
+  }
+
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(ids.size(), 100u);
+  EXPECT_TRUE(ids == expected);
+  EXPECT_EQ(inner_count, expected.size() * expected_inner);
+
+  index.close();
+  std::remove(path.c_str());
+}
+} // namespace.
+#endif // NANO_GEOMETRY_HAS_PAGED_RECT_INDEX
@@ -0,0 +1,103 @@
+#include <nano/test.h>
+#include <nano/geometry/persistent_rect_tree.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+using tree_type = nano::persistent_rect_tree<float>;
+using model_type = std::map<std::uint32_t, nano::rect<float>>;
+
+bool matches(const tree_type& tree, const model_type& model, const nano::rect<float>& q) {
+  std::vector<std::uint32_t> ids;
+  tree.query(q, ids);
+  std::sort(ids.begin(), ids.end());
+
+  std::vector<std::uint32_t> expected;
+  for (const auto& item : model) {
+    if (item.second.intersects(q)) {
+      expected.push_back(item.first);
+    }
+  }
+
+  return ids == expected && tree.size() == model.size();
+}
+
+TEST_CASE("nano.geometry", PersistentRectTree, "Persistent rect tree") {
+  std::mt19937 gen(21);
+  std::uniform_real_distribution<float> pos(0.0f, 500.0f);
+  std::uniform_real_distribution<float> len(1.0f, 20.0f);
+  const nano::rect<float> queries[] = { { 0, 0, 500, 500 }, { 100, 100, 50, 50 }, { 250, 0, 10, 500 } };
+
+  tree_type tree;
+  model_type model;
+  std::vector<tree_type> versions;
+  std::vector<model_type> models;
+
+  for (std::uint32_t i = 0; i < 2000; i++) {
+    const nano::rect<float> r = { pos(gen), pos(gen), len(gen), len(gen) };
+    tree.insert(r, i);
+    model[i] = r;
+
+    if (i % 500 == 0) {
+      versions.push_back(tree.snapshot());
+      models.push_back(model);
+      EXPECT_TRUE(versions.back().shares_root(tree));
+    }
+  }
+
+  for (std::uint32_t i = 0; i < 2000; i += 3) {
+    if (i % 2) {
+      EXPECT_TRUE(tree.remove(model[i], i));
+      model.erase(i);
+    }
+    else {
+      const nano::rect<float> r = { pos(gen), pos(gen), len(gen), len(gen) };
+      EXPECT_TRUE(tree.update(model[i], r, i));
+      model[i] = r;
+    }
+
+    if (i % 300 == 0) {
+      versions.push_back(tree.snapshot());
+      models.push_back(model);
+    }
+  }
+
+  EXPECT_FALSE(tree.remove({ 0, 0, 1, 1 }, 99999));
+
+  for (const nano::rect<float>& q : queries) {
+    EXPECT_TRUE(matches(tree, model, q));
+
+    // Old versions are left untouched by the edits.
+    for (std::size_t v = 0; v < versions.size(); v++) {
+      EXPECT_TRUE(matches(versions[v], models[v], q));
+    }
+  }
+
+  // Nodes are recycled once no version refers to them anymore.
+  const std::size_t shared_nodes = tree.allocated_nodes();
+  versions.clear();
+  EXPECT_TRUE(tree.allocated_nodes() < shared_nodes);
+
+  tree_type copy = tree;
+  copy.insert({ 1, 1, 1, 1 }, 5000);
+  EXPECT_EQ(copy.size(), tree.size() + 1);
+  EXPECT_FALSE(copy.shares_root(tree));
+
+  for (const auto& item : model) {
+    EXPECT_TRUE(tree.remove(item.second, item.first));
+  }
+
+  EXPECT_TRUE(tree.empty());
+  EXPECT_TRUE(matches(copy, [&] {
+    model_type m = model;
+    m[5000] = { 1, 1, 1, 1 };
+    return m;
+  }(), { 0, 0, 500, 500 }));
+
+  copy.clear();
+  EXPECT_EQ(tree.allocated_nodes(), 0u);
+}
+} // namespace.
@@ -0,0 +1,203 @@
+#include <nano/test.h>
+#include <nano/geometry/polygon_boolean.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+using polygon_set = nano::polygon_set<double>;
+
+polygon_set make_rect(double x, double y, double w, double h) {
+  const nano::point<double> points[4] = { { x, y }, { x + w, y }, { x + w, y + h }, { x, y + h } };
+  polygon_set s;
+  s.begin_polygon();
+  s.add_ring(points, 4);
+  return s;
+}
+
+// Star shaped polygon with a random radius per vertex.
+std::vector<nano::point<double>> make_radial(
+    std::size_t count, nano::point<double> center, double radius, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> scale(0.5, 1.0);
+  std::vector<nano::point<double>> points(count);
+
+  for (std::size_t i = 0; i < count; i++) {
+    const double angle = 6.283185307179586 * static_cast<double>(i) / static_cast<double>(count);
+    const double r = radius * scale(gen);
+    points[i] = { center.x + r * std::cos(angle), center.y + r * std::sin(angle) };
+  }
+
+  return points;
+}
+
+double compute_area(const polygon_set& a, const polygon_set& b, nano::boolean_operation op) {
+  polygon_set result;
+  nano::polygon_boolean(a, b, op, result);
+  return result.area();
+}
+
+bool well_oriented(const polygon_set& s) {
+  for (std::size_t i = 0; i < s.size(); i++) {
+    for (std::size_t r = 0; r < s[i].ring_count(); r++) {
+      if ((r == 0) != (s[i].ring_signed_area(r) > 0)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool near(double a, double b) { return std::abs(a - b) < 1e-6 * std::max(1.0, std::abs(b)); }
+
+TEST_CASE("nano.geometry", PolygonBoolean, "Polygon boolean operations") {
+  const polygon_set a = make_rect(0, 0, 10, 10);
+  const polygon_set b = make_rect(5, 5, 10, 10);
+  polygon_set result;
+
+  nano::polygon_boolean(a, b, nano::boolean_operation::intersection, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_TRUE(near(result.area(), 25));
+  EXPECT_TRUE(well_oriented(result));
+
+  nano::polygon_boolean(a, b, nano::boolean_operation::unite, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].ring_count(), 1u);
+  EXPECT_TRUE(near(result.area(), 175));
+  EXPECT_TRUE(well_oriented(result));
+
+  nano::polygon_boolean(a, b, nano::boolean_operation::difference, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_TRUE(near(result.area(), 75));
+
+  nano::polygon_boolean(a, b, nano::boolean_operation::exclusive_or, result);
+  EXPECT_EQ(result.size(), 2u);
+  EXPECT_TRUE(near(result.area(), 150));
+  EXPECT_TRUE(well_oriented(result));
+
+  // A polygon inside the other one becomes a hole.
+  const polygon_set inner = make_rect(3, 3, 4, 4);
+  nano::polygon_boolean(a, inner, nano::boolean_operation::difference, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].hole_count(), 1u);
+  EXPECT_TRUE(near(result.area(), 84));
+  EXPECT_TRUE(well_oriented(result));
+
+  nano::polygon_boolean(a, inner, nano::boolean_operation::unite, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].hole_count(), 0u);
+  EXPECT_TRUE(near(result.area(), 100));
+
+  // Operand with a hole, the orientation of the input rings does not matter.
+  polygon_set donut = make_rect(0, 0, 10, 10);
+  const nano::point<double> hole[4] = { { 2, 2 }, { 8, 2 }, { 8, 8 }, { 2, 8 } };
+  donut.add_ring(hole, 4);
+  EXPECT_TRUE(near(compute_area(donut, b, nano::boolean_operation::intersection), 25 - 9));
+  EXPECT_TRUE(near(compute_area(donut, inner, nano::boolean_operation::unite), 64 + 16));
+
+  nano::polygon_boolean(donut, make_rect(-5, 4, 20, 2), nano::boolean_operation::difference, result);
+  EXPECT_EQ(result.size(), 2u);
+  EXPECT_TRUE(near(result.area(), 64 - 8));
+  EXPECT_TRUE(well_oriented(result));
+
+  // Disjoint operands skip the sweep.
+  const polygon_set far = make_rect(100, 100, 5, 5);
+  nano::polygon_boolean(a, far, nano::boolean_operation::intersection, result);
+  EXPECT_TRUE(result.empty());
+  nano::polygon_boolean(a, far, nano::boolean_operation::unite, result);
+  EXPECT_EQ(result.size(), 2u);
+  nano::polygon_boolean(a, far, nano::boolean_operation::difference, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_TRUE(near(result.area(), 100));
+
+  nano::polygon_boolean(a, polygon_set(), nano::boolean_operation::unite, result);
+  EXPECT_TRUE(near(result.area(), 100));
+
+  // Random star polygons, the areas of the four operations must agree.
+  for (unsigned seed = 0; seed < 50; seed++) {
+    const std::vector<nano::point<double>> pa = make_radial(5 + seed % 40, { 0, 0 }, 100, seed);
+    const std::vector<nano::point<double>> pb = make_radial(5 + (seed * 7) % 50, { 30, 20 }, 90, seed + 1000);
+    polygon_set sa;
+    polygon_set sb;
+    sa.begin_polygon();
+    sa.add_ring(pa.data(), pa.size());
+    sb.begin_polygon();
+    sb.add_ring(pb.data(), pb.size());
+
+    const double i = compute_area(sa, sb, nano::boolean_operation::intersection);
+    const double u = compute_area(sa, sb, nano::boolean_operation::unite);
+    EXPECT_TRUE(near(u, sa.area() + sb.area() - i));
+    EXPECT_TRUE(near(compute_area(sa, sb, nano::boolean_operation::difference), sa.area() - i));
+    EXPECT_TRUE(near(compute_area(sa, sb, nano::boolean_operation::exclusive_or), u - i));
+  }
+}
+
+TEST_CASE("nano.geometry", PolygonBooleanTiny, "Polygon boolean operations on tiny coordinates") {
+  // Vertices closer than the tolerance of point::operator== are still distinct points.
+  const double k = 1e-17;
+  const polygon_set a = make_rect(0, 0, 2 * k, 2 * k);
+  const polygon_set b = make_rect(k, k, 2 * k, 2 * k);
+
+  const double i = compute_area(a, b, nano::boolean_operation::intersection);
+  EXPECT_TRUE(std::abs(i - k * k) < 1e-6 * k * k);
+  EXPECT_TRUE(std::abs(compute_area(a, b, nano::boolean_operation::unite) - 7 * k * k) < 1e-6 * k * k);
+  EXPECT_TRUE(std::abs(compute_area(a, b, nano::boolean_operation::exclusive_or) - 6 * k * k) < 1e-6 * k * k);
+}
+
+TEST_CASE("nano.geometry", PolygonBooleanRect, "Rect boolean operations") {
+  using rect = nano::rect<float>;
+  nano::polygon_set<float> result;
+
+  nano::polygon_boolean(rect(0, 0, 10, 10), rect(5, 5, 10, 10), nano::boolean_operation::intersection, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].bounds(), rect(5, 5, 5, 5));
+
+  nano::polygon_boolean(rect(0, 0, 10, 10), rect(5, 5, 10, 10), nano::boolean_operation::unite, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_TRUE(std::abs(result.area() - 175) < 1e-3);
+
+  // Containment.
+  nano::polygon_boolean(rect(0, 0, 10, 10), rect(2, 2, 3, 3), nano::boolean_operation::unite, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].bounds(), rect(0, 0, 10, 10));
+
+  nano::polygon_boolean(rect(0, 0, 10, 10), rect(2, 2, 3, 3), nano::boolean_operation::difference, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].hole_count(), 1u);
+  EXPECT_TRUE(std::abs(result.area() - 91) < 1e-3);
+  EXPECT_TRUE(result[0].ring_signed_area(0) > 0 && result[0].ring_signed_area(1) < 0);
+
+  nano::polygon_boolean(rect(2, 2, 3, 3), rect(0, 0, 10, 10), nano::boolean_operation::difference, result);
+  EXPECT_TRUE(result.empty());
+
+  nano::polygon_boolean(rect(2, 2, 3, 3), rect(0, 0, 10, 10), nano::boolean_operation::exclusive_or, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_TRUE(std::abs(result.area() - 91) < 1e-3);
+
+  // Touching rects merge into one polygon.
+  nano::polygon_boolean(rect(0, 0, 10, 10), rect(10, 0, 10, 10), nano::boolean_operation::unite, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].bounds(), rect(0, 0, 20, 10));
+  EXPECT_TRUE(std::abs(result.area() - 200) < 1e-3);
+
+  nano::polygon_boolean(rect(0, 0, 10, 10), rect(10, 0, 10, 10), nano::boolean_operation::intersection, result);
+  EXPECT_TRUE(result.empty());
+
+  // Disjoint and empty rects.
+  nano::polygon_boolean(rect(0, 0, 10, 10), rect(20, 0, 10, 10), nano::boolean_operation::unite, result);
+  EXPECT_EQ(result.size(), 2u);
+  nano::polygon_boolean(rect(0, 0, 10, 10), rect(5, 5, 0, 10), nano::boolean_operation::difference, result);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].bounds(), rect(0, 0, 10, 10));
+
+  // The clipper can be reused.
+  nano::polygon_clipper<float> clipper;
+  for (int i = 0; i < 4; i++) {
+    clipper.compute(rect(0, 0, 10, 10), rect(static_cast<float>(i), 3, 10, 4), nano::boolean_operation::difference,
+        result);
+    EXPECT_TRUE(std::abs(result.area() - (100 - static_cast<float>(10 - i) * 4)) < 1e-3);
+  }
+}
+} // namespace.
@@ -0,0 +1,128 @@
+#include <nano/test.h>
+#include <nano/geometry/projection.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+template <typename T>
+void check_web_mercator(double max_error, double max_latitude_error) {
+  constexpr double pi = 3.14159265358979323846;
+  constexpr double radius = 6378137.0;
+
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> longitude(-180, 180);
+  std::uniform_real_distribution<double> latitude(-85, 85);
+  std::vector<nano::point<T>> points(10000);
+  for (nano::point<T>& p : points) {
+    p = { static_cast<T>(longitude(gen)), static_cast<T>(latitude(gen)) };
+  }
+
+  std::vector<nano::point<T>> projected(points.size());
+  nano::project(nano::map_projection::web_mercator, points.data(), points.size(), projected.data());
+
+  double error = 0;
+  double latitude_error = 0;
+  for (std::size_t i = 0; i < points.size(); i++) {
+    const double phi = static_cast<double>(points[i].y) * pi / 180;
+    const double x = radius * static_cast<double>(points[i].x) * pi / 180;
+    const double y = radius * std::log(std::tan(pi / 4 + phi / 2));
+    error = std::max(error, std::abs(static_cast<double>(projected[i].x) - x));
+    error = std::max(error, std::abs(static_cast<double>(projected[i].y) - y));
+
+    const double expected = (2 * std::atan(std::exp(static_cast<double>(projected[i].y) / radius)) - pi / 2) * 180 / pi;
+    nano::point<T> back;
+    nano::unproject(nano::map_projection::web_mercator, &projected[i], 1, &back);
+    latitude_error = std::max(latitude_error, std::abs(static_cast<double>(back.y) - expected));
+  }
+
+  EXPECT_TRUE(error < max_error);
+  EXPECT_TRUE(latitude_error < max_latitude_error);
+}
+
+TEST_CASE("nano.geometry", Projection, "Map projections") {
+  check_web_mercator<double>(1e-6, 1e-12);
+  check_web_mercator<float>(4.0, 3e-5);
+
+  // Clamped latitudes and the square world.
+  const nano::point<double> corners[2] = { { -180, 90 }, { 180, -89 } };
+  nano::point<double> projected[2];
+  nano::project(nano::map_projection::web_mercator, corners, 2, projected);
+  EXPECT_TRUE(std::abs(projected[0].x + 20037508.342789244) < 1e-6);
+  EXPECT_TRUE(std::abs(projected[0].y - 20037508.342789244) < 1e-6);
+  EXPECT_TRUE(std::abs(projected[1].y + 20037508.342789244) < 1e-6);
+
+  nano::point<double> origin = { 0, 0 };
+  nano::project(nano::map_projection::web_mercator, &origin, 1, &origin);
+  EXPECT_TRUE(std::abs(origin.y) < 1e-8);
+
+  // In place round trip.
+  std::vector<nano::point<double>> points = { { 2.35, 48.85 }, { -73.56, 45.5 }, { 151.2, -33.86 } };
+  const std::vector<nano::point<double>> original = points;
+  nano::project(nano::map_projection::equirectangular, points.data(), points.size(), points.data());
+  EXPECT_TRUE(std::abs(points[0].y - 48.85 * 6378137.0 * 3.14159265358979323846 / 180) < 1e-6);
+  nano::unproject(nano::map_projection::equirectangular, points.data(), points.size(), points.data());
+  nano::project(nano::map_projection::web_mercator, points.data(), points.size(), points.data());
+  nano::unproject(nano::map_projection::web_mercator, points.data(), points.size(), points.data());
+  for (std::size_t i = 0; i < points.size(); i++) {
+    EXPECT_TRUE(std::abs(points[i].x - original[i].x) < 1e-10);
+    EXPECT_TRUE(std::abs(points[i].y - original[i].y) < 1e-10);
+  }
+}
+
+TEST_CASE("nano.geometry", ProjectionNaN, "Map projections keep NaN") {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const nano::point<double> points[3] = { { 10, nan }, { nan, 45 }, { 10, -nan } };
+  nano::point<double> projected[3];
+  nano::project(nano::map_projection::web_mercator, points, 3, projected);
+  EXPECT_TRUE(std::isnan(projected[0].y) && !std::isnan(projected[0].x));
+  EXPECT_TRUE(std::isnan(projected[1].x) && !std::isnan(projected[1].y));
+  EXPECT_TRUE(std::isnan(projected[2].y));
+
+  nano::point<double> back[3];
+  nano::unproject(nano::map_projection::web_mercator, points, 3, back);
+  EXPECT_TRUE(std::isnan(back[0].y) && std::isnan(back[1].x) && std::isnan(back[2].y));
+
+  // Infinite latitudes are still clamped.
+  const nano::point<float> infinite = { 0, std::numeric_limits<float>::infinity() };
+  nano::point<float> pole;
+  nano::project(nano::map_projection::web_mercator, &infinite, 1, &pole);
+  EXPECT_TRUE(std::abs(pole.y - 20037508.0f) < 8.0f);
+
+  const nano::point<float> float_nan = { 0, std::numeric_limits<float>::quiet_NaN() };
+  nano::project(nano::map_projection::web_mercator, &float_nan, 1, &pole);
+  EXPECT_TRUE(std::isnan(pole.y));
+  nano::unproject(nano::map_projection::web_mercator, &float_nan, 1, &pole);
+  EXPECT_TRUE(std::isnan(pole.y));
+}
+
+TEST_CASE("nano.geometry", ProjectionTransform, "Map projections with a transform") {
+  // World to a 512 pixels image, y down.
+  const double scale = 512 / (2 * 20037508.342789244);
+  const nano::transform<double> t = { scale, 0, 0, -scale, 256, 256 };
+  const nano::transform<double> inverse = { 1 / scale, 0, 0, -1 / scale, -256 / scale, 256 / scale };
+
+  const nano::point<double> points[3] = { { 0, 0 }, { -180, 85.0511287798066 }, { 90, -45 } };
+  nano::point<double> fused[3];
+  nano::point<double> separate[3];
+  nano::project(nano::map_projection::web_mercator, points, 3, t, fused);
+  nano::project(nano::map_projection::web_mercator, points, 3, separate);
+
+  for (std::size_t i = 0; i < 3; i++) {
+    EXPECT_TRUE(fused[i] == t.apply(separate[i]));
+  }
+
+  EXPECT_TRUE(std::abs(fused[0].x - 256) < 1e-9 && std::abs(fused[0].y - 256) < 1e-9);
+  EXPECT_TRUE(std::abs(fused[1].x) < 1e-9 && std::abs(fused[1].y) < 1e-9);
+  EXPECT_TRUE(std::abs(fused[2].x - 384) < 1e-9);
+
+  nano::point<double> back[3];
+  nano::unproject(nano::map_projection::web_mercator, fused, 3, inverse, back);
+  for (std::size_t i = 0; i < 3; i++) {
+    EXPECT_TRUE(std::abs(back[i].x - points[i].x) < 1e-9);
+    EXPECT_TRUE(std::abs(back[i].y - points[i].y) < 1e-9);
+  }
+}
+} // namespace.
@@ -0,0 +1,153 @@
+#include <nano/test.h>
+#include <nano/geometry/rect_index.h>
+#include <nano/geometry/rect_index_builder.h>
+#include <nano/geometry/viewport_tracker.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+std::vector<nano::rect<float>> make_random_rects(std::size_t count, unsigned int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> pos(0.0f, 1000.0f);
+  std::uniform_real_distribution<float> len(1.0f, 40.0f);
+
+  std::vector<nano::rect<float>> rects(count);
+  for (nano::rect<float>& r : rects) {
+    r = { pos(gen), pos(gen), len(gen), len(gen) };
+  }
+
+  return rects;
+}
+
+std::vector<std::uint32_t> brute_force_query(const std::vector<nano::rect<float>>& rects, const nano::rect<float>& q) {
+  std::vector<std::uint32_t> ids;
+  for (std::size_t i = 0; i < rects.size(); i++) {
+    if (rects[i].intersects(q)) {
+      ids.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  return ids;
+}
+
+TEST_CASE("nano.geometry", RectIndexQuery, "Rect index query") {
+  const std::vector<nano::rect<float>> rects = make_random_rects(5000, 12);
+  nano::rect_index<float> index(rects);
+
+  EXPECT_EQ(index.size(), rects.size());
+  EXPECT_TRUE(index.levels() > 1);
+
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<float> pos(-50.0f, 1000.0f);
+
+  for (int i = 0; i < 100; i++) {
+    const nano::rect<float> q = { pos(gen), pos(gen), 120.0f, 80.0f };
+    std::vector<std::uint32_t> ids;
+    index.query(q, ids);
+    std::sort(ids.begin(), ids.end());
+    EXPECT_TRUE(ids == brute_force_query(rects, q));
+  }
+
+  // Touching edges do not intersect.
+  nano::rect_index<int> int_index(std::vector<nano::rect<int>>{ { 0, 0, 10, 10 }, { 10, 0, 10, 10 } });
+  std::vector<std::uint32_t> ids;
+  int_index.query({ 10, 0, 5, 5 }, ids);
+  EXPECT_EQ(ids.size(), 1u);
+  EXPECT_EQ(ids[0], 1u);
+
+  nano::rect_index<float> empty_index;
+  ids.clear();
+  empty_index.query({ 0, 0, 10, 10 }, ids);
+  EXPECT_TRUE(ids.empty());
+}
+
+TEST_CASE("nano.geometry", ViewportTracker, "Viewport tracker") {
+  const std::vector<nano::rect<float>> rects = make_random_rects(5000, 7);
+  nano::rect_index<float> index(rects);
+
+  nano::rect<float> viewport = { 100, 100, 300, 200 };
+  nano::viewport_tracker<float> tracker(index);
+
+  std::vector<std::uint32_t> entered;
+  std::vector<std::uint32_t> exited;
+  tracker.update(viewport, entered, exited);
+  std::sort(entered.begin(), entered.end());
+  EXPECT_TRUE(entered == brute_force_query(rects, viewport));
+  EXPECT_TRUE(exited.empty());
+
+  const nano::point<float> moves[] = { { 5, 0 }, { 0, -7 }, { 13, 21 }, { -40, 3 }, { 600, 600 }, { 0, 0 } };
+
+  for (const nano::point<float>& dt : moves) {
+    const nano::rect<float> next = viewport + dt;
+    entered.clear();
+    exited.clear();
+    tracker.update(next, entered, exited);
+
+    std::vector<std::uint32_t> expected_entered;
+    std::vector<std::uint32_t> expected_exited;
+    for (std::size_t i = 0; i < rects.size(); i++) {
+      const bool was_visible = rects[i].intersects(viewport);
+      const bool is_visible = rects[i].intersects(next);
+      if (is_visible && !was_visible) {
+        expected_entered.push_back(static_cast<std::uint32_t>(i));
+      }
+      else if (was_visible && !is_visible) {
+        expected_exited.push_back(static_cast<std::uint32_t>(i));
+      }
+    }
+
+    std::sort(entered.begin(), entered.end());
+    std::sort(exited.begin(), exited.end());
+    EXPECT_TRUE(entered == expected_entered);
+    EXPECT_TRUE(exited == expected_exited);
+    viewport = next;
+  }
+
+  std::array<nano::rect<float>, 4> strips;
+  EXPECT_EQ(nano::rect_difference<float>({ 0, 0, 10, 10 }, { 2, 2, 4, 4 }, strips), 4u);
+  EXPECT_EQ(nano::rect_difference<float>({ 0, 0, 10, 10 }, { -1, -1, 20, 20 }, strips), 0u);
+  EXPECT_EQ(nano::rect_difference<float>({ 0, 0, 10, 10 }, { 5, 0, 10, 10 }, strips), 1u);
+  EXPECT_EQ(strips[0], nano::rect<float>(0, 0, 5, 10));
+}
+
+TEST_CASE("nano.geometry", RectIndexBuilder, "Time-sliced rect index builder") {
+  const std::vector<nano::rect<float>> rects = make_random_rects(20000, 5);
+  const nano::rect<float> q = { 200, 300, 150, 150 };
+  const std::vector<std::uint32_t> expected = brute_force_query(rects, q);
+
+  nano::rect_index_builder<float> builder(rects);
+  EXPECT_FALSE(builder.done());
+
+  std::size_t steps = 0;
+  float progress = 0.0f;
+  while (!builder.step(std::chrono::microseconds(0))) {
+    EXPECT_TRUE(builder.progress() >= progress);
+    progress = builder.progress();
+
+    std::vector<std::uint32_t> ids;
+    builder.query(q, ids);
+    std::sort(ids.begin(), ids.end());
+    EXPECT_TRUE(ids == expected);
+    steps++;
+  }
+
+  EXPECT_TRUE(steps > 1);
+  EXPECT_TRUE(builder.done());
+  EXPECT_EQ(builder.index().size(), rects.size());
+
+  std::vector<std::uint32_t> ids;
+  builder.query(q, ids);
+  std::sort(ids.begin(), ids.end());
+  EXPECT_TRUE(ids == expected);
+
+  // Same layout as a one-shot build.
+  nano::rect_index<float> index(rects);
+  std::vector<std::uint32_t> built_ids;
+  std::vector<std::uint32_t> index_ids;
+  builder.index().query({ 0, 0, 1000, 1000 }, built_ids);
+  index.query({ 0, 0, 1000, 1000 }, index_ids);
+  EXPECT_TRUE(built_ids == index_ids);
+  EXPECT_EQ(builder.index().levels(), index.levels());
+}
+} // namespace.
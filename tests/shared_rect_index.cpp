@@ -0,0 +1,164 @@
+#include <nano/test.h>
+#include <nano/geometry/shared_rect_index.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+struct alignas(nano::shared_format::alignment) aligned_block {
+  unsigned char data[nano::shared_format::alignment];
+};
+
+std::vector<nano::rect<float>> make_rects(std::size_t count, unsigned int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> pos(0.0f, 1000.0f);
+  std::uniform_real_distribution<float> len(1.0f, 40.0f);
+
+  std::vector<nano::rect<float>> rects(count);
+  for (nano::rect<float>& r : rects) {
+    r = { pos(gen), pos(gen), len(gen), len(gen) };
+  }
+
+  return rects;
+}
+
+std::vector<std::uint32_t> sorted_query(const nano::shared_rect_index<float>& index, const nano::rect<float>& q) {
+  std::vector<std::uint32_t> ids;
+  index.query(q, ids);
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+TEST_CASE("nano.geometry", SharedRectIndex, "Relocatable rect index") {
+  const std::vector<nano::rect<float>> rects = make_rects(5000, 21);
+  const nano::rect_index<float> reference(rects);
+  const std::size_t size = nano::shared_rect_index<float>::required_size(rects.size());
+
+  std::vector<aligned_block> buffer(size / sizeof(aligned_block) + 1);
+  EXPECT_FALSE(nano::shared_rect_index<float>::build(buffer.data(), size - 1, rects, 3));
+  EXPECT_TRUE(nano::shared_rect_index<float>::build(buffer.data(), size, rects, 3));
+
+  nano::shared_rect_index<float> index;
+  EXPECT_TRUE(index.attach(buffer.data(), size));
+  EXPECT_EQ(index.size(), rects.size());
+  EXPECT_EQ(index.levels(), reference.levels());
+  EXPECT_EQ(index.generation(), 3u);
+  EXPECT_EQ(index.bounds(), reference.bounds());
+
+  // The image is position independent.
+  std::vector<aligned_block> moved(buffer);
+  nano::shared_rect_index<float> moved_index;
+  EXPECT_TRUE(moved_index.attach(moved.data(), size));
+
+  std::mt19937 gen(4);
+  std::uniform_real_distribution<float> pos(-50.0f, 1000.0f);
+
+  for (int i = 0; i < 50; i++) {
+    const nano::rect<float> q = { pos(gen), pos(gen), 100.0f, 60.0f };
+    std::vector<std::uint32_t> expected;
+    reference.query(q, expected);
+    std::sort(expected.begin(), expected.end());
+
+    EXPECT_TRUE(sorted_query(index, q) == expected);
+    EXPECT_TRUE(sorted_query(moved_index, q) == expected);
+  }
+
+  // Invalid images are rejected.
+  nano::shared_rect_index<double> double_index;
+  EXPECT_FALSE(double_index.attach(buffer.data(), size));
+  EXPECT_FALSE(index.attach(buffer.data(), size - 1));
+  EXPECT_FALSE(index.is_attached());
+
+  moved[0].data[0] = 0;
+  EXPECT_FALSE(index.attach(moved.data(), size));
+
+  // An empty level would make the root read out of the nodes.
+  std::vector<aligned_block> bad_levels(buffer);
+  nano::shared_format::header header;
+  std::memcpy(&header, bad_levels.data(), sizeof(header));
+  unsigned char* level_offsets = reinterpret_cast<unsigned char*>(bad_levels.data()) + header.level_offsets_offset;
+  std::memcpy(level_offsets + (header.levels - 1) * sizeof(std::uint64_t),
+      level_offsets + header.levels * sizeof(std::uint64_t), sizeof(std::uint64_t));
+  EXPECT_FALSE(index.attach(bad_levels.data(), size));
+
+  bad_levels = buffer;
+  level_offsets = reinterpret_cast<unsigned char*>(bad_levels.data()) + header.level_offsets_offset;
+  std::memcpy(level_offsets + 2 * sizeof(std::uint64_t), level_offsets + sizeof(std::uint64_t), sizeof(std::uint64_t));
+  EXPECT_FALSE(index.attach(bad_levels.data(), size));
+
+  // Empty index.
+  std::vector<aligned_block> empty_buffer(nano::shared_rect_index<float>::required_size(0) / sizeof(aligned_block) + 1);
+  EXPECT_TRUE(nano::shared_rect_index<float>::build(
+      empty_buffer.data(), nano::shared_rect_index<float>::required_size(0), nullptr, 0));
+  EXPECT_TRUE(index.attach(empty_buffer.data(), nano::shared_rect_index<float>::required_size(0)));
+  EXPECT_TRUE(index.empty());
+  EXPECT_TRUE(sorted_query(index, { 0, 0, 1000, 1000 }).empty());
+}
+
+#if NANO_GEOMETRY_HAS_SHARED_MEMORY
+TEST_CASE("nano.geometry", SharedRectIndexFile, "Relocatable rect index in a mapped file") {
+  const std::string path = "nano-geometry-shared-test.idx";
+  const std::vector<nano::rect<float>> rects = make_rects(2000, 8);
+  const std::size_t size = nano::shared_rect_index<float>::required_size(rects.size());
+
+  {
+    nano::mapped_memory file;
+    EXPECT_TRUE(file.create_file(path, size));
+    EXPECT_TRUE(nano::shared_rect_index<float>::build(file.data(), file.size(), rects));
+  }
+
+  nano::mapped_memory file;
+  EXPECT_TRUE(file.open_file(path));
+
+  nano::shared_rect_index<float> index;
+  EXPECT_TRUE(index.attach(file.data(), file.size()));
+  EXPECT_EQ(index.size(), rects.size());
+
+  const nano::rect<float> q = { 300, 300, 200, 200 };
+  std::vector<std::uint32_t> expected;
+  for (std::size_t i = 0; i < rects.size(); i++) {
+    if (rects[i].intersects(q)) {
+      expected.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+
+  EXPECT_TRUE(sorted_query(index, q) == expected);
+  file.close();
+  std::remove(path.c_str());
+}
+
+TEST_CASE("nano.geometry", SharedRectIndexPublish, "Shared rect index generations") {
+  const std::string name = "/nano-geometry-test-" + std::to_string(::getpid());
+  const std::vector<nano::rect<float>> first = make_rects(1000, 1);
+  const std::vector<nano::rect<float>> second = make_rects(3000, 2);
+
+  nano::shared_rect_index_publisher<float> publisher(name);
+  nano::shared_rect_index_reader<float> reader(name);
+  EXPECT_FALSE(reader.refresh());
+
+  EXPECT_TRUE(publisher.publish(first));
+  EXPECT_EQ(publisher.generation(), 1u);
+  EXPECT_TRUE(reader.refresh());
+  EXPECT_FALSE(reader.refresh());
+  EXPECT_EQ(reader.generation(), 1u);
+  EXPECT_EQ(reader.index().size(), first.size());
+
+  // A reader keeps its generation until it refreshes, even once the segment is unlinked.
+  EXPECT_TRUE(publisher.publish(second));
+  EXPECT_TRUE(publisher.publish(second));
+  EXPECT_EQ(reader.index().size(), first.size());
+  EXPECT_EQ(sorted_query(reader.index(), { 0, 0, 1000, 1000 }).size(), first.size());
+
+  EXPECT_TRUE(reader.refresh());
+  EXPECT_EQ(reader.generation(), 3u);
+  EXPECT_EQ(reader.index().size(), second.size());
+  EXPECT_EQ(sorted_query(reader.index(), { 0, 0, 1000, 1000 }).size(), second.size());
+
+  publisher.unlink();
+}
+#endif // NANO_GEOMETRY_HAS_SHARED_MEMORY
+} // namespace.
@@ -0,0 +1,101 @@
+#include <nano/test.h>
+#include <nano/geometry/simplify.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+std::vector<nano::point<double>> random_walk(std::size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::normal_distribution<double> step(0.0, 1.0);
+  std::vector<nano::point<double>> points(count);
+
+  for (std::size_t i = 1; i < count; i++) {
+    points[i] = { points[i - 1].x + 1.0 + step(gen), points[i - 1].y + step(gen) };
+  }
+
+  return points;
+}
+
+TEST_CASE("nano.geometry", Simplify, "Polyline simplification") {
+  // A noisy straight line collapses to its endpoints.
+  std::vector<nano::point<double>> line;
+  for (std::size_t i = 0; i <= 100; i++) {
+    line.push_back({ static_cast<double>(i), i % 2 ? 0.1 : -0.1 });
+  }
+
+  std::vector<nano::point<double>> copy = line;
+  EXPECT_EQ(nano::simplify(copy.data(), copy.size(), 0.5), 2u);
+  EXPECT_EQ(copy[0], line.front());
+  EXPECT_EQ(copy[1], line.back());
+
+  copy = line;
+  EXPECT_EQ(nano::simplify(copy.data(), copy.size(), 20.0, nano::simplify_method::visvalingam), 2u);
+  EXPECT_EQ(copy[1], line.back());
+
+  // A corner survives.
+  std::vector<nano::point<double>> corner = { { 0, 0 }, { 5, 0.01 }, { 10, 0 }, { 10, 5 }, { 10, 10 } };
+  EXPECT_EQ(nano::simplify(corner.data(), corner.size(), 0.1), 3u);
+  EXPECT_EQ(corner[1], nano::point<double>(10, 0));
+
+  // Short polylines are left untouched.
+  std::vector<nano::point<double>> two = { { 0, 0 }, { 1, 1 } };
+  EXPECT_EQ(nano::simplify(two.data(), two.size(), 10.0), 2u);
+
+  // Filtering by importance gives the same result as simplifying at any tolerance.
+  const std::vector<nano::point<double>> walk = random_walk(2000, 3);
+  const nano::simplify_method methods[]
+      = { nano::simplify_method::douglas_peucker, nano::simplify_method::visvalingam };
+  nano::polyline_simplifier<double> simplifier;
+
+  for (nano::simplify_method method : methods) {
+    std::vector<double> importance(walk.size());
+    simplifier.compute_importance(walk.data(), walk.size(), importance.data(), method);
+
+    bool same = true;
+    std::size_t previous = walk.size() + 1;
+    bool decreasing = true;
+
+    for (double tolerance : { 0.0, 0.25, 1.0, 3.0, 10.0, 50.0 }) {
+      std::vector<nano::point<double>> direct = walk;
+      direct.resize(simplifier.simplify(direct.data(), direct.size(), tolerance, method));
+
+      std::vector<nano::point<double>> filtered(walk.size());
+      filtered.resize(
+          nano::simplify_by_importance(walk.data(), importance.data(), walk.size(), tolerance, filtered.data()));
+
+      same = same && direct == filtered;
+      decreasing = decreasing && direct.size() <= previous;
+      previous = direct.size();
+    }
+
+    EXPECT_TRUE(same);
+    EXPECT_TRUE(decreasing);
+    EXPECT_TRUE(previous < walk.size() / 10);
+  }
+
+  // Batch mode matches the sequential one.
+  std::vector<std::size_t> offsets = { 0 };
+  std::vector<nano::point<double>> all;
+  for (unsigned i = 0; i < 300; i++) {
+    const std::vector<nano::point<double>> w = random_walk(10 + (i * 37) % 500, i);
+    all.insert(all.end(), w.begin(), w.end());
+    offsets.push_back(all.size());
+  }
+
+  std::vector<nano::point<double>> batch = all;
+  std::vector<std::size_t> sizes(offsets.size() - 1);
+  nano::simplify_batch(batch.data(), offsets.data(), sizes.size(), 2.0, sizes.data(),
+      nano::simplify_method::douglas_peucker, 4);
+
+  bool batch_same = true;
+  for (std::size_t i = 0; i < sizes.size(); i++) {
+    std::vector<nano::point<double>> one(all.begin() + offsets[i], all.begin() + offsets[i + 1]);
+    one.resize(nano::simplify(one.data(), one.size(), 2.0));
+    batch_same = batch_same && one.size() == sizes[i]
+        && std::equal(one.begin(), one.end(), batch.begin() + offsets[i]);
+  }
+
+  EXPECT_TRUE(batch_same);
+}
+} // namespace.
@@ -0,0 +1,66 @@
+#include <nano/test.h>
+#include <nano/geometry/static_rect_index.h>
+
+#include <array>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr std::array<nano::rect<float>, 5> layout = { {
+    { 0, 0, 320, 240 },
+    { 0, 0, 320, 24 },
+    { 8, 4, 60, 16 },
+    { 80, 4, 60, 16 },
+    { 10, 40, 300, 190 },
+} };
+
+constexpr nano::static_rect_index index(layout);
+
+static_assert(index.size() == 5);
+static_assert(index.hit_test({ 20, 10 }) == 2);
+static_assert(index.hit_test({ 75, 10 }) == 1);
+static_assert(index.hit_test({ 400, 10 }) == decltype(index)::no_id);
+static_assert(index.count({ 0, 0, 100, 20 }) == 4);
+static_assert(index.count({ 10, 232, 5, 5 }) == 1);
+static_assert(index.bounds().size.width == 320 && index.bounds().size.height == 240);
+
+constexpr nano::static_rect_index<float, 0> empty_index(std::array<nano::rect<float>, 0>{});
+static_assert(empty_index.empty() && empty_index.count({ 0, 0, 10, 10 }) == 0);
+
+TEST_CASE("nano.geometry", StaticRectIndex, "Static rect index") {
+  constexpr std::size_t count = 300;
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> pos(0.0, 1000.0);
+  std::uniform_real_distribution<double> len(1.0, 80.0);
+
+  std::array<nano::rect<double>, count> rects;
+  for (nano::rect<double>& r : rects) {
+    r = { pos(gen), pos(gen), len(gen), len(gen) };
+  }
+
+  // Five levels with 4 children per node.
+  const nano::static_rect_index<double, count, 4> idx(rects);
+  EXPECT_EQ(idx.level_count, 5u);
+
+  for (int q = 0; q < 100; q++) {
+    const nano::rect<double> region = { pos(gen), pos(gen), len(gen) * 2, len(gen) * 2 };
+    const nano::point<double> p = { pos(gen), pos(gen) };
+
+    std::vector<bool> found(count, false);
+    idx.query(region, [&](std::uint32_t id, const nano::rect<double>& r) {
+      EXPECT_TRUE(r == rects[id]);
+      found[id] = true;
+    });
+
+    std::size_t expected_top = idx.no_id;
+    for (std::size_t i = 0; i < count; i++) {
+      EXPECT_EQ(found[i], rects[i].intersects(region));
+      if (rects[i].contains(p)) {
+        expected_top = i;
+      }
+    }
+
+    EXPECT_EQ(static_cast<std::size_t>(idx.hit_test(p)), expected_top);
+  }
+}
+} // namespace.
@@ -0,0 +1,128 @@
+#include <nano/test.h>
+#include <nano/geometry/stroke.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+bool near(const nano::rect<double>& a, const nano::rect<double>& b) {
+  return std::abs(a.x - b.x) < 1e-9 && std::abs(a.y - b.y) < 1e-9 && std::abs(a.width - b.width) < 1e-9
+      && std::abs(a.height - b.height) < 1e-9;
+}
+
+using point_list = std::vector<nano::point<double>>;
+
+point_list emit(const point_list& points, const nano::stroke_style<double>& style, nano::rect<double>& bounds) {
+  nano::rect<double> count_bounds;
+  point_list vertices(nano::stroke_vertex_count(points.data(), points.size(), style, &count_bounds));
+  vertices.resize(nano::stroke(points.data(), points.size(), style, vertices.data(), &bounds));
+  return near(bounds, count_bounds) ? vertices : point_list();
+}
+
+// Sum of the areas of the triangles of a strip.
+double strip_area(const point_list& v) {
+  double area = 0;
+  for (std::size_t i = 2; i < v.size(); i++) {
+    const nano::point<double> a = v[i - 1] - v[i - 2];
+    const nano::point<double> b = v[i] - v[i - 2];
+    area += std::abs(a.x * b.y - a.y * b.x);
+  }
+
+  return area * 0.5;
+}
+
+TEST_CASE("nano.geometry", Stroke, "Polyline stroking") {
+  nano::stroke_style<double> style;
+  style.width = 2;
+  nano::rect<double> bounds;
+
+  // Single segment with the three caps.
+  const std::vector<nano::point<double>> line = { { 0, 0 }, { 10, 0 } };
+  std::vector<nano::point<double>> v = emit(line, style, bounds);
+  EXPECT_EQ(v.size(), 4u);
+  EXPECT_TRUE(near(bounds, { 0, -1, 10, 2 }));
+  EXPECT_TRUE(std::abs(strip_area(v) - 20.0) < 1e-9);
+
+  style.cap = nano::line_cap::square;
+  v = emit(line, style, bounds);
+  EXPECT_EQ(v.size(), 4u);
+  EXPECT_TRUE(near(bounds, { -1, -1, 12, 2 }));
+
+  style.cap = nano::line_cap::round;
+  v = emit(line, style, bounds);
+  EXPECT_TRUE(v.size() > 4u);
+  EXPECT_TRUE(near(bounds, { -1, -1, 12, 2 }));
+  EXPECT_TRUE(strip_area(v) < 20.0 + 3.14159265358979);
+  EXPECT_TRUE(strip_area(v) > 20.0 + 2.5);
+
+  // Right angle turn with the three joins.
+  const std::vector<nano::point<double>> corner = { { 0, 0 }, { 10, 0 }, { 10, 10 } };
+  style.cap = nano::line_cap::butt;
+  style.join = nano::line_join::miter;
+  const std::vector<nano::point<double>> miter = emit(corner, style, bounds);
+  EXPECT_TRUE(near(bounds, { 0, -1, 11, 11 }));
+  EXPECT_EQ(miter[miter.size() / 2], nano::point<double>(11, -1));
+
+  style.join = nano::line_join::bevel;
+  const std::vector<nano::point<double>> bevel = emit(corner, style, bounds);
+  EXPECT_EQ(bevel.size() + 2, miter.size());
+  EXPECT_TRUE(near(bounds, { 0, -1, 11, 11 }));
+
+  style.join = nano::line_join::round;
+  style.tolerance = 0.01;
+  const std::vector<nano::point<double>> round = emit(corner, style, bounds);
+  EXPECT_TRUE(round.size() > miter.size());
+  EXPECT_TRUE(near(bounds, { 0, -1, 11, 11 }));
+
+  // Sharp turn above the miter limit becomes a bevel.
+  const std::vector<nano::point<double>> spike = { { 0, 0 }, { 10, 0 }, { 0, 1 } };
+  style.join = nano::line_join::miter;
+  const std::size_t spike_miter = emit(spike, style, bounds).size();
+  style.join = nano::line_join::bevel;
+  EXPECT_EQ(emit(spike, style, bounds).size(), spike_miter);
+
+  // Duplicate and collinear points do not add joins.
+  style.join = nano::line_join::miter;
+  const std::vector<nano::point<double>> straight = { { 0, 0 }, { 0, 0 }, { 5, 0 }, { 10, 0 }, { 10, 0 } };
+  v = emit(straight, style, bounds);
+  EXPECT_EQ(v.size(), 6u);
+  EXPECT_TRUE(near(bounds, { 0, -1, 10, 2 }));
+  EXPECT_TRUE(std::abs(strip_area(v) - 20.0) < 1e-9);
+
+  // Closed square, the miters reach the outer corners.
+  const std::vector<nano::point<double>> square = { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 } };
+  style.closed = true;
+  v = emit(square, style, bounds);
+  EXPECT_TRUE(near(bounds, { -1, -1, 12, 12 }));
+  EXPECT_EQ(v.front(), v[v.size() - 2]);
+
+  // The transform scales the stroke and its bounds.
+  const nano::transform<double> scale = nano::transform<double>::scale({ 2.0, 2.0 });
+  style.transform = &scale;
+  emit(square, style, bounds);
+  EXPECT_TRUE(near(bounds, { -2, -2, 24, 24 }));
+
+  // Nothing to stroke.
+  EXPECT_EQ(nano::stroke_vertex_count(square.data(), 1, style), 0u);
+  const std::vector<nano::point<double>> dot = { { 3, 3 }, { 3, 3 } };
+  EXPECT_EQ(nano::stroke_vertex_count(dot.data(), dot.size(), style, &bounds), 0u);
+  EXPECT_EQ(bounds, nano::rect<double>(0, 0, 0, 0));
+
+  // Long polyline spanning several chunks, float.
+  std::vector<nano::point<float>> wave(1000);
+  for (std::size_t i = 0; i < wave.size(); i++) {
+    wave[i] = { static_cast<float>(i), 10.0f * std::sin(static_cast<float>(i) * 0.1f) };
+  }
+
+  nano::stroke_style<float> wave_style;
+  wave_style.width = 3;
+  wave_style.join = nano::line_join::round;
+  wave_style.cap = nano::line_cap::round;
+  nano::rect<float> wave_bounds;
+  std::vector<nano::point<float>> wave_vertices(nano::stroke_vertex_count(wave.data(), wave.size(), wave_style));
+  EXPECT_EQ(nano::stroke(wave.data(), wave.size(), wave_style, wave_vertices.data(), &wave_bounds),
+      wave_vertices.size());
+  EXPECT_TRUE(wave_bounds.x < -1.4f && wave_bounds.x > -1.6f);
+  EXPECT_TRUE(wave_bounds.height > 21.0f && wave_bounds.height < 23.1f);
+}
+} // namespace.
@@ -0,0 +1,144 @@
+#include <nano/test.h>
+#include <nano/geometry/tile_pyramid.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+TEST_CASE("nano.geometry", TileKey, "Slippy map tile keys") {
+  const nano::tile_key k = { 3, 5, 2 };
+  EXPECT_TRUE(k.parent() == nano::tile_key({ 2, 2, 1 }));
+  EXPECT_TRUE(k.child(0) == nano::tile_key({ 4, 10, 4 }));
+  EXPECT_TRUE(k.child(3) == nano::tile_key({ 4, 11, 5 }));
+  for (std::uint32_t i = 0; i < 4; i++) {
+    EXPECT_TRUE(k.child(i).parent() == k);
+  }
+
+  EXPECT_TRUE(nano::tile_key({ 0, 0, 0 }).parent() == nano::tile_key({ 0, 0, 0 }));
+  EXPECT_TRUE(nano::tile_key({ 1, 1, 1 }) < nano::tile_key({ 2, 0, 0 }));
+
+  std::unordered_set<nano::tile_key> keys = { k, k.parent(), k };
+  EXPECT_EQ(keys.size(), 2u);
+
+  const nano::tile_range range = { 4, 2, 3, 5, 4 };
+  EXPECT_EQ(range.size(), 3u);
+  EXPECT_TRUE(range.contains({ 4, 4, 3 }));
+  EXPECT_FALSE(range.contains({ 4, 5, 3 }));
+  EXPECT_FALSE(range.contains({ 3, 4, 3 }));
+}
+
+TEST_CASE("nano.geometry", TilePyramid, "Slippy map tile pyramid") {
+  const nano::tile_pyramid<double> pyramid({ -100, -100, 200, 200 });
+
+  EXPECT_EQ(pyramid.tile_size(2), nano::size<double>(50, 50));
+  EXPECT_EQ(pyramid.tile_bounds({ 2, 1, 3 }), nano::rect<double>(-50, 50, 50, 50));
+  EXPECT_TRUE(pyramid.tile_at({ 0, 0 }, 1) == nano::tile_key({ 1, 1, 1 }));
+  EXPECT_TRUE(pyramid.tile_at({ -500, 500 }, 3) == nano::tile_key({ 3, 0, 7 }));
+
+  // Tiles only touching the viewport are not covering it.
+  nano::tile_range r = pyramid.range({ -50, -50, 100, 100 }, 2);
+  EXPECT_EQ(r.left, 1u);
+  EXPECT_EQ(r.right, 3u);
+  EXPECT_EQ(r.top, 1u);
+  EXPECT_EQ(r.bottom, 3u);
+
+  r = pyramid.range({ -49, -49, 100, 100 }, 2);
+  EXPECT_EQ(r.size(), 9u);
+
+  // Clamped to the world.
+  r = pyramid.range({ -1000, -1000, 2000, 2000 }, 3);
+  EXPECT_EQ(r.size(), 64u);
+  EXPECT_TRUE(pyramid.range({ 200, 0, 10, 10 }, 3).empty());
+  EXPECT_TRUE(pyramid.range({ 0, 0, 0, 10 }, 3).empty());
+
+  // Closest to the middle first, every tile intersects the viewport.
+  const nano::rect<double> viewport = { -30, -10, 40, 20 };
+  std::vector<nano::tile_key> tiles;
+  pyramid.covering_tiles(viewport, 4, tiles);
+  EXPECT_EQ(tiles.size(), 4u * 2u);
+
+  const nano::point<double> middle = viewport.middle();
+  double previous = 0;
+  bool ordered = true;
+  bool covering = true;
+  for (const nano::tile_key& k : tiles) {
+    const nano::rect<double> b = pyramid.tile_bounds(k);
+    const nano::point<double> d = b.middle() - middle;
+    const double distance = d.x * d.x + d.y * d.y;
+    ordered = ordered && distance >= previous;
+    covering = covering && b.intersects(viewport);
+    previous = distance;
+  }
+
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(covering);
+  EXPECT_TRUE(pyramid.tile_bounds(tiles.front()).contains(middle));
+}
+
+TEST_CASE("nano.geometry", TileTracker, "Slippy map viewport diffs") {
+  const nano::tile_pyramid<float> pyramid({ 0, 0, 256, 256 });
+  nano::tile_tracker<float> tracker(pyramid);
+  std::vector<nano::tile_key> entered;
+  std::vector<nano::tile_key> exited;
+
+  tracker.update({ 10, 10, 40, 40 }, 3, entered, exited);
+  EXPECT_EQ(entered.size(), 4u);
+  EXPECT_TRUE(exited.empty());
+
+  // Moving right by one tile.
+  entered.clear();
+  tracker.update({ 42, 10, 40, 40 }, 3, entered, exited);
+  EXPECT_EQ(entered.size(), 2u);
+  EXPECT_EQ(exited.size(), 2u);
+  EXPECT_TRUE(entered[0].x == 2 && entered[1].x == 2);
+  EXPECT_TRUE(exited[0].x == 0 && exited[1].x == 0);
+
+  // Same tiles.
+  entered.clear();
+  exited.clear();
+  tracker.update({ 40, 12, 41, 40 }, 3, entered, exited);
+  EXPECT_TRUE(entered.empty() && exited.empty());
+
+  // Zooming replaces every tile.
+  tracker.update({ 40, 12, 41, 40 }, 4, entered, exited);
+  EXPECT_EQ(exited.size(), 4u);
+  EXPECT_EQ(entered.size(), tracker.range().size());
+  EXPECT_TRUE(std::all_of(entered.begin(), entered.end(), [](const nano::tile_key& k) { return k.z == 4; }));
+
+  tracker.reset();
+  entered.clear();
+  exited.clear();
+  tracker.update({ 40, 12, 41, 40 }, 4, entered, exited);
+  EXPECT_EQ(entered.size(), tracker.range().size());
+  EXPECT_TRUE(exited.empty());
+}
+TEST_CASE("nano.geometry", TilePyramidLimits, "Slippy map zoom limit and invalid input") {
+  const nano::tile_pyramid<double> pyramid({ 0, 0, 1, 1 });
+  const std::uint32_t max_zoom = nano::tile_key::max_zoom;
+
+  const nano::tile_key deepest = pyramid.tile_at({ 1, 1 }, max_zoom);
+  EXPECT_EQ(deepest.x, (1u << max_zoom) - 1);
+  EXPECT_TRUE(deepest.child(3) == deepest);
+  EXPECT_TRUE(nano::tile_key({ max_zoom - 1, 0, 0 }).child(3).z == max_zoom);
+
+  // Zoom levels above max_zoom are clamped, ids stay unique and ordered.
+  EXPECT_TRUE(pyramid.tile_at({ 1, 1 }, 40) == deepest);
+  EXPECT_TRUE(pyramid.tile_at({ 1, 1 }, 32) == deepest);
+  EXPECT_EQ(pyramid.range({ 0, 0, 1, 1 }, 35).z, max_zoom);
+  EXPECT_EQ(pyramid.range({ 0.5, 0.5, 1e-9, 1e-9 }, 32).right - pyramid.range({ 0.5, 0.5, 1e-9, 1e-9 }, 32).left, 1u);
+  EXPECT_EQ(pyramid.tile_size(64), pyramid.tile_size(max_zoom));
+  EXPECT_TRUE(nano::tile_key({ max_zoom, 1, 0 }).id() != nano::tile_key({ max_zoom, 0, 1u << 28 }).id());
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_TRUE(pyramid.range({ nan, 0, 0.5, 0.5 }, 3).empty());
+  EXPECT_TRUE(pyramid.range({ 0, 0, nan, 0.5 }, 3).empty());
+  EXPECT_TRUE(pyramid.tile_at({ nan, nan }, 3) == nano::tile_key({ 3, 0, 0 }));
+
+  std::vector<nano::tile_key> tiles;
+  pyramid.covering_tiles({ 0.25, 0.25, 1e-9, 1e-9 }, 50, tiles);
+  EXPECT_EQ(tiles.size(), 1u);
+  EXPECT_EQ(tiles[0].z, max_zoom);
+}
+} // namespace.
@@ -0,0 +1,111 @@
+#ifndef NANO_GEOMETRY_TRACE
+  #define NANO_GEOMETRY_TRACE 1
+#endif
+
+#include <nano/test.h>
+#include <nano/geometry/trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::vector<nano::trace::event> events_named(const char* name) {
+  std::vector<nano::trace::event> events;
+  nano::trace::collect(events);
+  events.erase(std::remove_if(events.begin(), events.end(),
+                   [name](const nano::trace::event& e) { return std::strcmp(e.name, name) != 0; }),
+      events.end());
+  return events;
+}
+
+TEST_CASE("nano.geometry", TraceScope, "Trace scopes") {
+  nano::trace::clear();
+
+  {
+    NANO_GEOMETRY_TRACE_SCOPE("test.outer", 10, 80);
+    nano::trace::scope inner("test.inner");
+    inner.set_items(3);
+    inner.set_bytes(24);
+  }
+
+  const std::vector<nano::trace::event> outer = events_named("test.outer");
+  const std::vector<nano::trace::event> inner = events_named("test.inner");
+  EXPECT_EQ(outer.size(), 1u);
+  EXPECT_EQ(inner.size(), 1u);
+  EXPECT_EQ(outer[0].items, 10u);
+  EXPECT_EQ(outer[0].bytes, 80u);
+  EXPECT_EQ(inner[0].items, 3u);
+  EXPECT_EQ(inner[0].bytes, 24u);
+  EXPECT_EQ(outer[0].thread, inner[0].thread);
+
+  // The inner span is nested in the outer one.
+  EXPECT_TRUE(inner[0].begin >= outer[0].begin);
+  EXPECT_TRUE(inner[0].begin + inner[0].duration <= outer[0].begin + outer[0].duration);
+
+  nano::trace::clear();
+  EXPECT_TRUE(events_named("test.outer").empty());
+
+  // Only the last buffer_capacity events of a thread are kept.
+  for (std::size_t i = 0; i < nano::trace::buffer_capacity + 10; i++) {
+    nano::trace::scope s("test.ring", i);
+  }
+
+  const std::vector<nano::trace::event> ring = events_named("test.ring");
+  EXPECT_EQ(ring.size(), nano::trace::buffer_capacity);
+  EXPECT_EQ(ring.front().items, 10u);
+  EXPECT_EQ(ring.back().items, nano::trace::buffer_capacity + 9);
+  nano::trace::clear();
+}
+
+TEST_CASE("nano.geometry", TraceThreads, "Trace per thread buffers") {
+  nano::trace::clear();
+
+  std::atomic<bool> running = true;
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 3; t++) {
+    threads.emplace_back([t, &running]() {
+      nano::trace::set_thread_name("worker \"" + std::to_string(t) + "\"");
+      for (std::size_t i = 0; i < 20000 || running; i++) {
+        NANO_GEOMETRY_TRACE_SCOPE("test.thread", t, i);
+      }
+    });
+  }
+
+  // Reading while the threads are writing only returns complete events.
+  bool consistent = true;
+  for (std::size_t i = 0; i < 20; i++) {
+    for (const nano::trace::event& e : events_named("test.thread")) {
+      consistent = consistent && e.items < 3;
+    }
+  }
+
+  running = false;
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  EXPECT_TRUE(consistent);
+
+  const std::vector<nano::trace::event> events = events_named("test.thread");
+  EXPECT_EQ(events.size(), 3 * nano::trace::buffer_capacity);
+
+  std::vector<std::uint32_t> ids;
+  for (const nano::trace::event& e : events) {
+    ids.push_back(e.thread);
+  }
+
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(static_cast<std::size_t>(std::unique(ids.begin(), ids.end()) - ids.begin()), 3u);
+
+  const std::string json = nano::trace::to_chrome_json();
+  EXPECT_TRUE(json.find("{\"traceEvents\":[") == 0);
+  EXPECT_TRUE(json.find("\"name\":\"test.thread\",\"cat\":\"nano.geometry\",\"ph\":\"X\"") != std::string::npos);
+  EXPECT_TRUE(json.find("\"args\":{\"name\":\"worker \\\"1\\\"\"}") != std::string::npos);
+  EXPECT_TRUE(json.find("\"args\":{\"items\":2,\"bytes\":") != std::string::npos);
+  nano::trace::clear();
+}
+} // namespace.
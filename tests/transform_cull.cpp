@@ -0,0 +1,87 @@
+#include <nano/test.h>
+#include <nano/geometry/transform_cull.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+nano::rect<float> quad_bounds(const nano::quad<float>& q) {
+  const float l = std::min({ q.top_left.x, q.top_right.x, q.bottom_right.x, q.bottom_left.x });
+  const float t = std::min({ q.top_left.y, q.top_right.y, q.bottom_right.y, q.bottom_left.y });
+  const float r = std::max({ q.top_left.x, q.top_right.x, q.bottom_right.x, q.bottom_left.x });
+  const float b = std::max({ q.top_left.y, q.top_right.y, q.bottom_right.y, q.bottom_left.y });
+  return nano::rect<float>::create_from_point({ l, t }, { r, b });
+}
+
+bool near(const nano::rect<float>& a, const nano::rect<float>& b) {
+  return std::abs(a.x - b.x) < 1e-3f && std::abs(a.y - b.y) < 1e-3f && std::abs(a.width - b.width) < 1e-3f
+      && std::abs(a.height - b.height) < 1e-3f;
+}
+
+TEST_CASE("nano.geometry", TransformCull, "Fused transform cull bounds") {
+  std::mt19937 gen(6);
+  std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+  std::uniform_real_distribution<float> len(1.0f, 10.0f);
+  std::uniform_real_distribution<float> angle(0.0f, 6.0f);
+  std::uniform_real_distribution<float> offset(-300.0f, 800.0f);
+
+  const std::size_t count = 1500;
+  std::vector<nano::rect<float>> local(count);
+  std::vector<nano::transform<float>> transforms(count);
+  std::vector<std::uint32_t> transform_ids(count);
+
+  for (std::size_t i = 0; i < count; i++) {
+    local[i] = { pos(gen), pos(gen), len(gen), len(gen) };
+    transforms[i] = nano::transform<float>::rotation(angle(gen)) + nano::point<float>{ offset(gen), offset(gen) };
+    transform_ids[i] = static_cast<std::uint32_t>((i * 7) % count);
+  }
+
+  const nano::rect<float> viewport = { 0, 0, 640, 480 };
+  std::vector<nano::rect<float>> world(count);
+  std::vector<std::uint32_t> visible(count);
+
+  // Per-item transforms.
+  std::size_t n
+      = nano::transform_cull(local.data(), transforms.data(), count, viewport, world.data(), visible.data());
+  std::vector<std::uint32_t> expected;
+  bool bounds_match = true;
+
+  for (std::size_t i = 0; i < count; i++) {
+    const nano::rect<float> b = quad_bounds(transforms[i].apply(local[i]));
+    bounds_match = bounds_match && near(world[i], b);
+    if (world[i].intersects(viewport)) {
+      expected.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+
+  EXPECT_TRUE(bounds_match);
+  EXPECT_TRUE(n > 0 && n < count);
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), visible.begin()) && n == expected.size());
+
+  // Shared transform, without world bounds.
+  const nano::transform<float> shared = transforms[3];
+  nano::rect<float>* no_bounds = nullptr;
+  n = nano::transform_cull(local.data(), count, shared, viewport, no_bounds, visible.data());
+  expected.clear();
+  for (std::size_t i = 0; i < count; i++) {
+    if (nano::detail::transformed_bounds(shared, local[i]).intersects(viewport)) {
+      expected.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), visible.begin()) && n == expected.size());
+
+  // Indexed transforms.
+  n = nano::transform_cull(
+      local.data(), transform_ids.data(), transforms.data(), count, viewport, world.data(), visible.data());
+  std::size_t expected_count = 0;
+  for (std::size_t i = 0; i < count; i++) {
+    expected_count += quad_bounds(transforms[transform_ids[i]].apply(local[i])).intersects(viewport);
+  }
+
+  EXPECT_EQ(n, expected_count);
+  EXPECT_EQ(nano::transform_cull(local.data(), 0, shared, viewport, no_bounds, visible.data()), 0u);
+}
+} // namespace.
@@ -0,0 +1,97 @@
+#include <nano/test.h>
+#include <nano/geometry/triangulate.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+template <typename Index>
+double triangles_area(const std::vector<nano::point<double>>& points, const std::vector<Index>& indices) {
+  double area = 0;
+  for (std::size_t i = 0; i < indices.size(); i += 3) {
+    const nano::point<double>& a = points[indices[i]];
+    const nano::point<double>& b = points[indices[i + 1]];
+    const nano::point<double>& c = points[indices[i + 2]];
+    area += (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+  }
+
+  return area * 0.5;
+}
+
+// Star with `count` branches, not convex and with many reflex vertices.
+std::vector<nano::point<double>> star(std::size_t count, double inner, double outer) {
+  std::vector<nano::point<double>> points;
+  for (std::size_t i = 0; i < 2 * count; i++) {
+    const double angle = 3.14159265358979 * static_cast<double>(i) / static_cast<double>(count);
+    const double radius = i % 2 ? inner : outer;
+    points.push_back({ radius * std::cos(angle), radius * std::sin(angle) });
+  }
+
+  return points;
+}
+
+TEST_CASE("nano.geometry", Triangulate, "Polygon triangulation") {
+  const nano::triangulation_method methods[]
+      = { nano::triangulation_method::ear_clipping, nano::triangulation_method::monotone };
+
+  for (nano::triangulation_method method : methods) {
+    // Counter-clockwise square.
+    const std::vector<nano::point<double>> square = { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 } };
+    std::vector<std::uint32_t> indices;
+    EXPECT_TRUE(nano::triangulate(nano::polygon_view<double>(square), indices, method));
+    EXPECT_EQ(indices.size(), 6u);
+    EXPECT_EQ(triangles_area(square, indices), 100.0);
+
+    // Clockwise input keeps a clockwise (negative) winding.
+    const std::vector<nano::point<double>> reversed(square.rbegin(), square.rend());
+    indices.clear();
+    EXPECT_TRUE(nano::triangulate(nano::polygon_view<double>(reversed), indices, method));
+    EXPECT_EQ(triangles_area(reversed, indices), -100.0);
+
+    // U shape.
+    const std::vector<nano::point<double>> u_shape
+        = { { 0, 0 }, { 30, 0 }, { 30, 30 }, { 20, 30 }, { 20, 10 }, { 10, 10 }, { 10, 30 }, { 0, 30 } };
+    indices.clear();
+    EXPECT_TRUE(nano::triangulate(nano::polygon_view<double>(u_shape), indices, method));
+    EXPECT_EQ(indices.size(), 18u);
+    EXPECT_EQ(triangles_area(u_shape, indices), nano::polygon_view<double>(u_shape).area());
+
+    // Square with two holes, both windings.
+    const std::vector<nano::point<double>> with_holes = { { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 }, //
+      { 10, 10 }, { 10, 40 }, { 40, 40 }, { 40, 10 }, //
+      { 60, 60 }, { 90, 60 }, { 90, 90 }, { 60, 90 } };
+    const std::vector<std::size_t> holes = { 4, 8 };
+    const nano::polygon_view<double> poly(with_holes, holes);
+    EXPECT_EQ(poly.area(), 10000.0 - 1800.0);
+    EXPECT_EQ(nano::polygon_triangulator<double>::max_triangle_count(poly), 14u);
+
+    indices.clear();
+    EXPECT_TRUE(nano::triangulate(poly, indices, method));
+    EXPECT_EQ(indices.size(), 14u * 3u);
+    EXPECT_TRUE(std::abs(triangles_area(with_holes, indices) - poly.area()) < 1e-9);
+
+    // Large star, both paths must cover the exact area.
+    const std::vector<nano::point<double>> large = star(2000, 50, 100);
+    const nano::polygon_view<double> large_poly(large);
+    indices.clear();
+    EXPECT_TRUE(nano::triangulate(large_poly, indices, method));
+    EXPECT_EQ(indices.size() / 3, large.size() - 2);
+    EXPECT_TRUE(std::abs(triangles_area(large, indices) - large_poly.area()) < 1e-6 * large_poly.area());
+  }
+
+  // 16 bit indices and a reused triangulator.
+  nano::polygon_triangulator<float> triangulator;
+  const std::vector<nano::point<float>> triangle = { { 0, 0 }, { 4, 0 }, { 0, 4 } };
+  std::vector<std::uint16_t> small;
+  EXPECT_TRUE(triangulator.triangulate(nano::polygon_view<float>(triangle), small));
+  EXPECT_TRUE(triangulator.triangulate(nano::polygon_view<float>(triangle), small));
+  EXPECT_EQ(small.size(), 6u);
+
+  // Too many points for 16 bit indices, or not enough points.
+  const std::vector<nano::point<float>> many(70000, nano::point<float>{ 0, 0 });
+  small.clear();
+  EXPECT_FALSE(triangulator.triangulate(nano::polygon_view<float>(many), small));
+  EXPECT_FALSE(triangulator.triangulate(nano::polygon_view<float>(triangle.data(), 2), small));
+  EXPECT_TRUE(small.empty());
+}
+} // namespace.
@@ -0,0 +1,97 @@
+#include <nano/test.h>
+#include <nano/geometry/vertex_emitter.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+TEST_CASE("nano.geometry", VertexEmitter, "Vertex and index buffer emission") {
+  const std::vector<nano::rect<float>> rects = { { 0, 0, 10, 20 }, { 5, 5, 2, 2 } };
+  const std::vector<nano::rect<float>> placements = { { 0, 0, 64, 32 }, { 64, 32, 64, 32 } };
+
+  std::vector<nano::rect<float>> uvs(placements.size());
+  nano::atlas_uvs(placements.data(), placements.size(), nano::size<float>(128, 64), uvs.data());
+  EXPECT_EQ(uvs[1], nano::rect<float>(0.5f, 0.5f, 0.5f, 0.5f));
+  EXPECT_EQ(nano::atlas_uv(placements[0], nano::size<float>(128, 64)), nano::rect<float>(0, 0, 0.5f, 0.5f));
+
+  // The single and batch conversions give the same bits, also for sizes that are not powers of 2.
+  const std::vector<nano::rect<float>> odd_placements = { { 1, 3, 7, 11 }, { 13, 17, 19, 23 }, { 29, 31, 37, 41 } };
+  const nano::size<float> odd_size = { 97, 101 };
+  std::vector<nano::rect<float>> odd_uvs(odd_placements.size());
+  nano::atlas_uvs(odd_placements.data(), odd_placements.size(), odd_size, odd_uvs.data());
+
+  bool same_bits = true;
+  for (std::size_t i = 0; i < odd_placements.size(); i++) {
+    const nano::rect<float> uv = nano::atlas_uv(odd_placements[i], odd_size);
+    same_bits = same_bits && uv.x == odd_uvs[i].x && uv.y == odd_uvs[i].y && uv.width == odd_uvs[i].width
+        && uv.height == odd_uvs[i].height;
+  }
+
+  EXPECT_TRUE(same_bits);
+
+  // Interleaved, without options.
+  std::vector<nano::textured_vertex<float>> vertices(rects.size() * nano::vertices_per_quad);
+  nano::emit_vertices(rects.data(), rects.size(), vertices.data());
+  EXPECT_EQ(vertices[2].x, 10.0f);
+  EXPECT_EQ(vertices[2].y, 20.0f);
+  EXPECT_EQ(vertices[2].u, 1.0f);
+  EXPECT_EQ(vertices[3].v, 1.0f);
+  EXPECT_EQ(vertices[4].x, 5.0f);
+
+  // Interleaved with a transform, atlas uvs and streaming stores matches the quads. Every
+  // x86-64 compiler has a non-temporal path, the builtin or SSE2.
+#if defined(__x86_64__) || defined(_M_X64)
+  EXPECT_EQ(NANO_GEOMETRY_HAS_STREAMING_STORES, 1);
+#endif
+  const nano::transform<float> t = nano::transform<float>::rotation(0.25f) + nano::point<float>{ 3, 4 };
+  nano::vertex_emit_options<float> opts;
+  opts.transform = &t;
+  opts.uvs = uvs.data();
+  opts.streaming = true;
+  nano::emit_vertices(rects.data(), rects.size(), vertices.data(), opts);
+
+  bool match = true;
+  for (std::size_t i = 0; i < rects.size(); i++) {
+    const nano::quad<float> q = t.apply(rects[i]);
+    const nano::point<float> corners[4] = { q.top_left, q.top_right, q.bottom_right, q.bottom_left };
+    for (std::size_t k = 0; k < 4; k++) {
+      const nano::textured_vertex<float>& v = vertices[i * 4 + k];
+      match = match && std::abs(v.x - corners[k].x) < 1e-4f && std::abs(v.y - corners[k].y) < 1e-4f;
+    }
+  }
+
+  EXPECT_TRUE(match);
+  EXPECT_EQ(vertices[5].u, 1.0f);
+  EXPECT_EQ(vertices[5].v, 0.5f);
+
+  // Planar from quads gives the same positions.
+  std::vector<nano::quad<float>> quads = { t.apply(rects[0]), t.apply(rects[1]) };
+  std::vector<nano::point<float>> positions(vertices.size());
+  std::vector<nano::point<float>> planar_uvs(vertices.size());
+  opts.transform = nullptr;
+  nano::emit_vertices(quads.data(), quads.size(), positions.data(), planar_uvs.data(), opts);
+
+  match = true;
+  for (std::size_t i = 0; i < positions.size(); i++) {
+    match = match && positions[i].x == vertices[i].x && positions[i].y == vertices[i].y
+        && planar_uvs[i].x == vertices[i].u && planar_uvs[i].y == vertices[i].v;
+  }
+
+  EXPECT_TRUE(match);
+  nano::point<float>* no_uvs = nullptr;
+  nano::emit_vertices(rects.data(), rects.size(), positions.data(), no_uvs);
+  EXPECT_EQ(positions[1], nano::point<float>(10, 0));
+
+  // Indices.
+  std::vector<std::uint16_t> indices16(2 * nano::indices_per_quad);
+  EXPECT_TRUE(nano::emit_quad_indices(indices16.data(), 2, 8));
+  const std::vector<std::uint16_t> expected = { 8, 9, 10, 8, 10, 11, 12, 13, 14, 12, 14, 15 };
+  EXPECT_TRUE(indices16 == expected);
+  EXPECT_TRUE(nano::emit_quad_indices(indices16.data(), 1, 65532));
+  EXPECT_FALSE(nano::emit_quad_indices(indices16.data(), 1, 65533));
+
+  std::vector<std::uint32_t> indices32(nano::indices_per_quad);
+  EXPECT_TRUE(nano::emit_quad_indices(indices32.data(), 1, 70000));
+  EXPECT_EQ(indices32[5], 70003u);
+}
+} // namespace.
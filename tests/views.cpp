@@ -0,0 +1,102 @@
+#include <nano/test.h>
+#include <nano/geometry/views.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+bool near(const nano::rect<double>& a, const nano::rect<double>& b) {
+  return std::abs(a.x - b.x) < 1e-9 && std::abs(a.y - b.y) < 1e-9 && std::abs(a.width - b.width) < 1e-9
+      && std::abs(a.height - b.height) < 1e-9;
+}
+
+nano::rect<double> quad_bounds(const nano::quad<double>& q) {
+  const double l = std::min({ q.top_left.x, q.top_right.x, q.bottom_right.x, q.bottom_left.x });
+  const double t = std::min({ q.top_left.y, q.top_right.y, q.bottom_right.y, q.bottom_left.y });
+  const double r = std::max({ q.top_left.x, q.top_right.x, q.bottom_right.x, q.bottom_left.x });
+  const double b = std::max({ q.top_left.y, q.top_right.y, q.bottom_right.y, q.bottom_left.y });
+  return nano::rect<double>::create_from_point({ l, t }, { r, b });
+}
+
+TEST_CASE("nano.geometry", GeometryViews, "Lazy geometry views") {
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<double> pos(-100.0, 600.0);
+  std::uniform_real_distribution<double> len(1.0, 50.0);
+
+  // Spans several chunks with a partial last one.
+  std::vector<nano::rect<double>> rects(1000);
+  for (nano::rect<double>& r : rects) {
+    r = { pos(gen), pos(gen), len(gen), len(gen) };
+  }
+
+  const nano::transform<double> t
+      = nano::transform<double>::rotation(0.3) * nano::transform<double>::translation({ 20.0, -5.0 });
+  const nano::rect<double> viewport = { 0, 0, 400, 300 };
+
+  // Reference: one pass per stage with temporaries.
+  std::vector<nano::rect<double>> expected;
+  for (const nano::rect<double>& r : rects) {
+    const nano::rect<double> world = quad_bounds(t.apply(r)) + nano::point<double>{ 3.0, 4.0 };
+    if (world.intersects(viewport)) {
+      expected.push_back(world.intersection(viewport));
+    }
+  }
+
+  const auto pipeline = nano::make_view(rects).transformed_by(t).offset_by({ 3.0, 4.0 }).clipped_to(viewport);
+  EXPECT_EQ(pipeline.count(), expected.size());
+
+  std::vector<nano::rect<double>> result;
+  pipeline.copy_to(std::back_inserter(result));
+  EXPECT_EQ(result.size(), expected.size());
+
+  bool all_near = true;
+  nano::rect<double> expected_bounds = expected[0];
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    all_near = all_near && near(result[i], expected[i]);
+    expected_bounds = expected_bounds.merged(expected[i]);
+  }
+
+  EXPECT_TRUE(all_near);
+  EXPECT_TRUE(near(pipeline.bounds(), expected_bounds));
+
+  // Filtering keeps the elements unchanged.
+  std::size_t intersecting = 0;
+  for (const nano::rect<double>& r : rects) {
+    intersecting += r.intersects(viewport);
+  }
+
+  EXPECT_EQ(nano::make_view(rects).filtered_intersecting(viewport).count(), intersecting);
+  EXPECT_EQ(
+      nano::make_view(rects).filtered_intersecting({ 5000, 5000, 1, 1 }).bounds(), nano::rect<double>(0, 0, 0, 0));
+
+  // Points and quads.
+  const std::vector<nano::point<float>> points = { { 0, 0 }, { 10, 5 }, { -4, 2 }, { 30, 30 } };
+  EXPECT_EQ(nano::make_view(points).bounds(), nano::rect<float>(-4, 0, 34, 30));
+  EXPECT_EQ(nano::make_view(points).offset_by({ 1, 1 }).clipped_to({ 0, 0, 20, 20 }).count(), 2u);
+  EXPECT_EQ(nano::make_view(points.data(), 0).bounds(), nano::rect<float>(0, 0, 0, 0));
+
+  // A transformed rect covers the same area as its transformed quad.
+  const nano::transform<float> rotation = nano::transform<float>::rotation(0.5f);
+  const std::vector<nano::quad<float>> quads = { nano::quad<float>(nano::rect<float>(0, 0, 10, 10)) };
+  const std::vector<nano::rect<float>> squares = { nano::rect<float>(0, 0, 10, 10) };
+  const nano::rect<float> quad_box = nano::make_view(quads).transformed_by(rotation).bounds();
+  const nano::rect<float> rect_box = nano::make_view(squares).transformed_by(rotation).bounds();
+  EXPECT_TRUE(quad_box.width > 10.0f);
+  EXPECT_TRUE(std::abs(quad_box.x - rect_box.x) < 1e-4f && std::abs(quad_box.width - rect_box.width) < 1e-4f);
+  EXPECT_TRUE(std::abs(quad_box.y - rect_box.y) < 1e-4f && std::abs(quad_box.height - rect_box.height) < 1e-4f);
+
+  // Quads are clipped and filtered by their bounding rect and kept unchanged.
+  const std::vector<nano::quad<float>> rotated = { rotation.apply(nano::rect<float>(0, 0, 10, 10)),
+    rotation.apply(nano::rect<float>(100, 100, 10, 10)), rotation.apply(nano::rect<float>(40, 0, 10, 10)) };
+  const nano::rect<float> area = { -10, -30, 50, 45 };
+  EXPECT_EQ(nano::make_view(rotated).filtered_intersecting(area).count(), 2u);
+  EXPECT_EQ(nano::make_view(rotated).filtered_intersecting({ 36, 0, 10, 10 }).count(), 0u);
+
+  std::vector<nano::quad<float>> clipped;
+  nano::make_view(rotated).clipped_to(area).copy_to(std::back_inserter(clipped));
+  EXPECT_EQ(clipped.size(), 2u);
+  EXPECT_TRUE(clipped[0].top_right.x == rotated[0].top_right.x && clipped[1].bottom_left.y == rotated[2].bottom_left.y);
+}
+} // namespace.
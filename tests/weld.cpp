@@ -0,0 +1,87 @@
+#include <nano/test.h>
+#include <nano/geometry/weld.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+TEST_CASE("nano.geometry", Weld, "Point welding") {
+  const std::vector<nano::point<double>> points
+      = { { 0, 0 }, { 0.05, 0 }, { 1, 1 }, { 0, 0.09 }, { 1.02, 0.99 }, { 5, 5 }, { 0.5, 0 } };
+  std::vector<nano::point<double>> out(points.size());
+  std::vector<std::uint32_t> remap(points.size());
+
+  std::size_t count = nano::weld_points(points.data(), points.size(), 0.1, remap.data(), out.data());
+  EXPECT_EQ(count, 4u);
+  EXPECT_EQ(out[0], nano::point<double>(0, 0));
+  EXPECT_EQ(out[1], nano::point<double>(1, 1));
+  EXPECT_EQ(out[2], nano::point<double>(5, 5));
+  EXPECT_EQ(out[3], nano::point<double>(0.5, 0));
+  const std::uint32_t expected[] = { 0, 0, 1, 0, 1, 2, 3 };
+  for (std::size_t i = 0; i < points.size(); i++) {
+    EXPECT_EQ(remap[i], expected[i]);
+  }
+
+  // A point is merged into the closest kept point.
+  const std::vector<nano::point<double>> pair = { { 0, 0 }, { 1, 0 }, { 0.6, 0 } };
+  std::vector<nano::point<double>> pair_out(pair.size());
+  std::vector<std::size_t> pair_remap(pair.size());
+  EXPECT_EQ(nano::weld_points(pair.data(), pair.size(), 0.7, pair_remap.data(), pair_out.data()), 2u);
+  EXPECT_EQ(pair_remap[2], 1u);
+
+  // Zero tolerance only merges exact duplicates.
+  count = nano::weld_points(points.data(), points.size(), 0.0, remap.data(), out.data());
+  EXPECT_EQ(count, points.size());
+
+  const std::vector<nano::point<float>> exact = { { 1, 2 }, { -0.0f, 0 }, { 1, 2 }, { 0, -0.0f } };
+  std::vector<nano::point<float>> exact_out(exact.size());
+  std::vector<int> exact_remap(exact.size());
+  EXPECT_EQ(nano::weld_points(exact.data(), exact.size(), 0.0f, exact_remap.data(), exact_out.data()), 2u);
+  EXPECT_EQ(exact_remap[2], 0);
+  EXPECT_EQ(exact_remap[3], 1);
+
+  // In place, on a jittered grid: every kept point is more than the tolerance away from
+  // the others and every point is within the tolerance of its replacement.
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> jitter(-0.01, 0.01);
+  std::uniform_int_distribution<int> cell(0, 49);
+  std::vector<nano::point<double>> cloud(5000);
+  for (nano::point<double>& p : cloud) {
+    p = { cell(gen) + jitter(gen), cell(gen) + jitter(gen) };
+  }
+
+  const std::vector<nano::point<double>> original = cloud;
+  std::vector<std::uint32_t> cloud_remap(cloud.size());
+  nano::point_welder<double> welder;
+  count = welder.weld(cloud.data(), cloud.size(), 0.05, cloud_remap.data(), cloud.data());
+  EXPECT_TRUE(count <= 2500u && count > 2000u);
+
+  bool close = true;
+  for (std::size_t i = 0; i < original.size(); i++) {
+    const nano::point<double> d = original[i] - cloud[cloud_remap[i]];
+    close = close && d.x * d.x + d.y * d.y <= 0.05 * 0.05;
+  }
+
+  EXPECT_TRUE(close);
+
+  bool apart = true;
+  for (std::size_t i = 0; i < count; i++) {
+    for (std::size_t j = i + 1; j < count; j++) {
+      const nano::point<double> d = cloud[i] - cloud[j];
+      apart = apart && d.x * d.x + d.y * d.y > 0.05 * 0.05;
+    }
+  }
+
+  EXPECT_TRUE(apart);
+
+  // Non finite and huge coordinates stay apart.
+  const std::vector<nano::point<float>> odd = { { 1e30f, 0 }, { std::numeric_limits<float>::infinity(), 0 },
+    { std::numeric_limits<float>::quiet_NaN(), 0 }, { 1e30f, 0 } };
+  std::vector<nano::point<float>> odd_out(odd.size());
+  std::vector<std::uint32_t> odd_remap(odd.size());
+  EXPECT_EQ(nano::weld_points(odd.data(), odd.size(), 1e-3f, odd_remap.data(), odd_out.data()), 3u);
+  EXPECT_EQ(odd_remap[3], 0u);
+}
+} // namespace.
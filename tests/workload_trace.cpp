@@ -0,0 +1,65 @@
+#include <nano/test.h>
+#include <nano/geometry/workload_trace.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+TEST_CASE("nano.geometry", WorkloadTrace, "Workload trace round trip") {
+  const std::string path = "nano-geometry-workload-test.ngwt";
+  const std::vector<nano::rect<double>> rects = { { 0, 0, 10, 10 }, { 5, 5, 2000, 1.5 }, { -3, 4, 0.25, 0.5 } };
+  const nano::transform<double> t = nano::transform<double>::scale({ 2, 2 }) + nano::point<double>{ 10, 20 };
+
+  nano::workload_recorder<double> recorder;
+  EXPECT_TRUE(recorder.open(path));
+  recorder.record_rects(rects.data(), rects.size());
+  recorder.record_query({ 1, 1, 2, 2 });
+  recorder.record_transform(t);
+  recorder.record_cull({ 0, 0, 800, 600 });
+  recorder.record_rects(rects.data(), 1);
+  EXPECT_TRUE(recorder.close());
+  EXPECT_FALSE(recorder.is_open());
+
+  nano::workload<double> w;
+  EXPECT_TRUE(nano::read_workload(path, w));
+  EXPECT_EQ(w.operations.size(), 5u);
+  EXPECT_EQ(w.rect_sets.size(), 2u);
+  EXPECT_EQ(w.transforms.size(), 1u);
+  EXPECT_EQ(w.regions.size(), 2u);
+
+  EXPECT_TRUE(w.operations[0].op == nano::workload_op::rects);
+  EXPECT_TRUE(w.operations[1].op == nano::workload_op::query);
+  EXPECT_TRUE(w.operations[2].op == nano::workload_op::transform);
+  EXPECT_TRUE(w.operations[3].op == nano::workload_op::cull);
+  EXPECT_TRUE(w.operations[4].op == nano::workload_op::rects);
+  EXPECT_EQ(w.operations[3].index, 1u);
+  EXPECT_EQ(w.operations[4].index, 1u);
+
+  EXPECT_EQ(w.rect_sets[0], rects);
+  EXPECT_EQ(w.rect_sets[1].size(), 1u);
+  EXPECT_EQ(w.regions[0], nano::rect<double>(1, 1, 2, 2));
+  EXPECT_EQ(w.regions[1], nano::rect<double>(0, 0, 800, 600));
+  EXPECT_EQ(w.transforms[0].apply(nano::point<double>{ 1, 1 }), t.apply(nano::point<double>{ 1, 1 }));
+
+  // Another value type.
+  nano::workload<float> wf;
+  EXPECT_FALSE(nano::read_workload(path, wf));
+
+  // Truncated in the middle of the last record.
+  std::vector<char> data(64 * 1024);
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  data.resize(std::fread(data.data(), 1, data.size(), file));
+  std::fclose(file);
+
+  file = std::fopen(path.c_str(), "wb");
+  std::fwrite(data.data(), 1, data.size() - 8, file);
+  std::fclose(file);
+
+  EXPECT_FALSE(nano::read_workload(path, w));
+  EXPECT_TRUE(w.operations.size() < 5u);
+
+  std::remove(path.c_str());
+  EXPECT_FALSE(nano::read_workload(path, w));
+}
+} // namespace.